@@ -11,10 +11,12 @@
  * Author: Estelle Chigot, Lucas Barret
  */
 
+#include <chrono>  // NOLINT
 #include <string>
 #include <memory>
 #include <mutex>   // NOLINT
 #include <map>
+#include <vector>
 
 // Fledge headers
 #include <reading.h>
@@ -25,6 +27,11 @@
 #include "./iec61850_fledge_proxy_interface.h"
 #include "./iec61850_client.h"
 #include "./iec61850_client_config.h"
+#include "./iec61850_discovery_coordinator.h"
+#include "./iec61850_name_tree_cache.h"
+#include "./iec61850_redundancy_group.h"
+#include "./iec61850_request_budget.h"
+#include "./iec61850_tracer.h"
 
 /** \class IEC61850
  *  \brief Main class for managing the IEC61850 clients and sending data to Fledge
@@ -45,13 +52,39 @@ class IEC61850: public ClientGatewayInterface, public FledgeProxyInterface
         IEC61850 &operator = (IEC61850 &&) = delete;
 
         void setConfig(const ConfigCategory &config) const;
+        /** \brief Apply a new configuration without restarting the unchanged IEDs
+         *
+         * The clients of the removed IEDs, or of the IEDs whose connection parameters
+         * changed, are stopped. The added IEDs get new clients. The other clients keep
+         * their connection and swap the configuration between two poll cycles.
+         */
+        void reconfigure(const ConfigCategory &config);
         std::string getLogMinLevel() const;
 
+        /** \brief Connection statistics of each IED, by IED key */
+        std::map<std::string, ReconnectStatistics, std::less<>> getReconnectStatistics() const;
+
+        /** \brief Offset of the reading cycles of each client in the polling period, by IED key */
+        std::map<std::string, std::chrono::milliseconds, std::less<>> getPollingPhases() const;
+
+        /** \brief Latencies of the requests of each client, per priority class */
+        std::map<std::string, RequestLatencies, std::less<>> getRequestLatencies() const;
+
+        /** \brief Effective reading periods of each client, in adaptive polling, by IED key */
+        std::map<std::string, PollingRateDistribution, std::less<>> getPollingRateDistributions() const;
+
+        /** \brief Use of each request budget, by link group ("": IED without link group) */
+        std::map<std::string, IEC61850RequestBudget::Statistics, std::less<>> getRequestBudgetStatistics() const;
+
         void start() override;
         void stop() override;
 
         void ingest(std::vector<Datapoint *> &points,
                     const std::string &readingAssetName) override;
+        /** \brief Same as 'ingest', and give the wait for the ingest lock */
+        void ingest(std::vector<Datapoint *> &points,
+                    const std::string &readingAssetName,
+                    std::chrono::microseconds &lockWait);
         void registerIngest(INGEST_DATA_TYPE data,
                             void (*ingest_cb)(INGEST_DATA_TYPE, Reading)) override  // NOSONAR
         {
@@ -61,14 +94,56 @@ class IEC61850: public ClientGatewayInterface, public FledgeProxyInterface
 
 
     private:
+        void startClient(const std::shared_ptr<IEC61850ClientConfig> &config,
+                         const ServerConnectionParameters &serverConfig);
+
+        /**
+         * \brief Spread the reading cycles of the clients evenly over the polling period
+         *
+         * The clients are placed round-robin, in the order of their IED key:
+         * the IEDs are not all read at the same time.
+         */
+        void assignPollingPhases();
+
+        /**
+         * \brief Link group of the request budget of the IED
+         *
+         * \return "" (the global budget) if the IED has no link group, or no budget for its link group
+         */
+        static std::string getRequestBudgetKey(const IEC61850ClientConfig &config,
+                                               const ServerConnectionParameters &serverConfig);
+
+        /** \brief Budget of the link group (created at the first use) */
+        IEC61850RequestBudget *getRequestBudget(const IEC61850ClientConfig &config,
+                                                const std::string &budgetKey);
+
+        /**
+         * \brief Start or stop the recording of the hot path spans
+         *
+         * The trace is written in the file when the tracing is disabled:
+         * a reconfiguration toggles it on demand.
+         */
+        void applyTracing(const TracingParameters &tracingParams);
+
+        /** \brief Stop the given clients in parallel */
+        static void stopClients(const std::vector<IEC61850Client *> &clients);
+
         void                (*m_ingest_callback)(void *, Reading) {}; // NOLINT
         INGEST_DATA_TYPE    m_data = nullptr;
         std::mutex          m_ingestMutex;  /**< Protect the Fledge 'feed' process */
 
+        /** Shared by the clients: must outlive them */
+        std::unique_ptr<IEC61850DiscoveryCoordinator> m_discoveryCoordinator;
+        std::unique_ptr<IEC61850NameTreeCache> m_nameTreeCache;
+        std::unique_ptr<IEC61850RedundancyGroup> m_redundancyGroup;  /**< null: no redundancy */
+        std::map<std::string, std::unique_ptr<IEC61850RequestBudget>, std::less<>> m_requestBudgets;  /**< by link group */
+
         /** Set of IEC61850 clients, connected or not to IEC61850 server */
         std::map<std::string, std::unique_ptr<IEC61850Client>, std::less<>> m_clients;
 
         std::shared_ptr<IEC61850ClientConfig> m_config;
+        bool m_isStarted = false;
+        TracingParameters m_tracingParams;  /**< last applied */
 
         // Section: see the class as a white box for unit tests
         FRIEND_TEST(IEC61850Test, createObjectWithEmptyConfig);
@@ -78,5 +153,10 @@ class IEC61850: public ClientGatewayInterface, public FledgeProxyInterface
         FRIEND_TEST(IEC61850Test, startClient);
         FRIEND_TEST(IEC61850Test, stopClient);
         FRIEND_TEST(IEC61850Test, registerIngestCallback);
+        FRIEND_TEST(IEC61850Test, reconfigureKeepsClients);
+        FRIEND_TEST(IEC61850Test, startRedundantClients);
+        FRIEND_TEST(IEC61850Test, staggerPollingPhases);
+        FRIEND_TEST(IEC61850Test, shareRequestBudgetsByLinkGroup);
+        FRIEND_TEST(IEC61850Test, dumpTraceWhenTracingDisabled);
 };
 #endif  // INCLUDE_IEC61850_H_
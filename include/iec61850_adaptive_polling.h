@@ -0,0 +1,104 @@
+#ifndef INCLUDE_IEC61850_ADAPTIVE_POLLING_H_
+#define INCLUDE_IEC61850_ADAPTIVE_POLLING_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <chrono>  // NOLINT
+#include <cstddef>
+#include <mutex>   // NOLINT
+#include <string>
+#include <unordered_map>
+
+// local library
+#include "./iec61850_client_config.h"
+
+/** \struct PollingRateDistribution
+ *  \brief Effective reading periods of the units of a client (DO or dataset)
+ */
+struct PollingRateDistribution {
+    std::size_t unitCount = 0;
+    std::size_t unitsAtMinPeriod = 0;  /**< volatile units */
+    std::size_t unitsAtMaxPeriod = 0;  /**< static units */
+    std::chrono::milliseconds shortestPeriod{0};
+    std::chrono::milliseconds medianPeriod{0};
+    std::chrono::milliseconds longestPeriod{0};
+    double readsPerSecond = 0.0;  /**< sum of the effective rates of the units */
+};
+
+/** \class IEC61850AdaptivePolling
+ *  \brief Reading period of each unit (DO or dataset), adapted to the changes of its value
+ *
+ *  A unit starts at its minimum period. The period is halved when the value
+ *  differs from the previous read, and lengthened by half while the value
+ *  stays unchanged, within the bounds of the unit.
+ *  The units are identified by their reference (DO path with FC, or dataset).
+ *  Thread safe.
+ */
+class IEC61850AdaptivePolling
+{
+    public :
+        IEC61850AdaptivePolling() = default;
+        ~IEC61850AdaptivePolling() = default;
+
+        IEC61850AdaptivePolling(const IEC61850AdaptivePolling &) = delete;
+        IEC61850AdaptivePolling &operator = (const IEC61850AdaptivePolling &) = delete;
+
+        /**
+         * \brief Is the next read of the unit due (a new unit is due at once)
+         *
+         * \param bounds resolved bounds of the unit (see 'resolveBounds')
+         * \param tolerance a read due a little after 'now' is done now (the cycles are not exact)
+         */
+        bool isDue(const std::string &unitKey,
+                   const PollingPeriodBounds &bounds,
+                   std::chrono::steady_clock::time_point now,
+                   std::chrono::milliseconds tolerance);
+
+        /**
+         * \brief Adapt the period of the unit to its new value, and plan its next read
+         *
+         * \param fingerprint of the converted value (see 'combineFingerprints' for a dataset)
+         */
+        void recordRead(const std::string &unitKey,
+                        std::size_t fingerprint,
+                        std::chrono::steady_clock::time_point readTime);
+
+        /** \brief Forget all the units (new configuration) */
+        void clear();
+
+        PollingRateDistribution getDistribution() const;
+
+        /** \brief Log a summary of the distribution */
+        static void logDistribution(const std::string &clientId, const PollingRateDistribution &distribution);
+
+        /** \brief Bounds of a unit: its own bounds, or the default ones (0: not set) */
+        static PollingPeriodBounds resolveBounds(const PollingPeriodBounds &unitBounds,
+                                                 const PollingPeriodBounds &defaultBounds);
+
+        /** \brief Bounds of a group read at once: the group follows its most demanding member */
+        static PollingPeriodBounds tightestBounds(const PollingPeriodBounds &firstBounds,
+                                                  const PollingPeriodBounds &secondBounds);
+
+        static std::size_t combineFingerprints(std::size_t seed, std::size_t fingerprint);
+
+    private:
+        struct UnitState {
+            PollingPeriodBounds bounds;
+            std::chrono::milliseconds period{0};
+            std::chrono::steady_clock::time_point nextReadTime;
+            std::size_t fingerprint = 0;
+            bool isRead = false;
+        };
+
+        std::unordered_map<std::string, UnitState> m_units;
+
+        mutable std::mutex m_mutex;  /**< Protect all the members above */
+};
+
+#endif  // INCLUDE_IEC61850_ADAPTIVE_POLLING_H_
@@ -11,9 +11,17 @@
  * Author: Estelle Chigot, Lucas Barret
  */
 
+#include <map>
 #include <memory>
+#include <mutex>   // NOLINT
+#include <string>
 #include <thread>  // NOLINT
+#include <unordered_map>
 #include <atomic>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <random>
 
 // Fledge headers
 #include <logger.h>
@@ -21,8 +29,16 @@
 
 
 // local library
+#include "./iec61850_adaptive_polling.h"
 #include "./iec61850_client_config.h"
 #include "./iec61850_client_connection_interface.h"
+#include "./iec61850_congestion_control.h"
+#include "./iec61850_discovery_coordinator.h"
+#include "./iec61850_name_tree_cache.h"
+#include "./iec61850_redundancy_group.h"
+#include "./iec61850_request_budget.h"
+#include "./iec61850_request_scheduler.h"
+#include "./iec61850_runtime_statistics.h"
 
 // For white box unit tests
 #include <gtest/gtest_prod.h>
@@ -30,6 +46,27 @@
 class IEC61850;
 class WrappedMms;
 
+/** \enum DatasetReadStrategy
+ *  \brief How a configured dataset is read from the IED
+ */
+enum class DatasetReadStrategy {
+    FULL_DATASET = 0,   /**< read all the members, the unselected ones are dropped */
+    TRIMMED_DATASET,    /**< read an association specific dataset of the selected members */
+    SELECTED_MEMBERS    /**< read the selected members, in 1 request per logical device */
+};
+
+/** \struct ReconnectStatistics
+ *  \brief Connection attempts of a client with its IED
+ */
+struct ReconnectStatistics {
+    uint64_t connectAttempts = 0;
+    uint64_t connectFailures = 0;
+    uint64_t connectionLosses = 0;  /**< connection lost after its establishment */
+    unsigned int consecutiveFailures = 0;
+    std::chrono::milliseconds lastConnectDuration{0};
+    std::chrono::milliseconds lastReconnectDelay{0};  /**< backoff delay after the last failure */
+};
+
 /** \class MmsParsingException
  *  \brief Error during the parsing of MMS
  */
@@ -56,7 +93,11 @@ class IEC61850Client
                                 const ServerConnectionParameters &connectionParam,
                                 const ExchangedData &exchangedData,
                                 const ExchangedDatasets &selectedDOInExchangedDatasets,
-                                const ApplicationParameters &applicationParams);
+                                const ApplicationParameters &applicationParams,
+                                IEC61850DiscoveryCoordinator *discoveryCoordinator = nullptr,
+                                IEC61850NameTreeCache *nameTreeCache = nullptr,
+                                IEC61850RedundancyGroup *redundancyGroup = nullptr,
+                                IEC61850RequestBudget *requestBudget = nullptr);
 
         ~IEC61850Client();
 
@@ -78,25 +119,227 @@ class IEC61850Client
          */
         void stop();
 
+        /**
+         * \brief Order the stop without waiting for it: the pending waits are interrupted
+         *
+         * Allows to stop many clients at once, before joining them with 'stop'.
+         */
+        void requestStop();
+
+        /**
+         * \brief Keep alive the configuration referenced by the client
+         *
+         * (the configuration given at construction, or by updateConfiguration)
+         */
+        void holdConfiguration(const std::shared_ptr<const IEC61850ClientConfig> &config);
+
+        /**
+         * \brief Replace the configuration, without closing the connection
+         *
+         * The connection parameters of this client must be unchanged in
+         * 'newConfig'. The new datapoints and datasets are swapped between 2
+         * reading cycles; the name trees of the unchanged DO are kept.
+         * Thread safe.
+         */
+        void updateConfiguration(const std::shared_ptr<const IEC61850ClientConfig> &newConfig);
+
+        /** \brief Copy of the connection statistics, thread safe */
+        ReconnectStatistics getReconnectStatistics() const;
+
+        /**
+         * \brief Place the reading cycles in the polling period, thread safe
+         *
+         * The cycles start at 'phaseRatio' x period, modulo the period, on the
+         * steady clock: the schedule does not depend on the start or on the
+         * reconnections of the client.
+         *
+         * \param phaseRatio in [0, 1)
+         */
+        void setPollingPhase(double phaseRatio);
+
+        /** \brief Offset of the reading cycles in the polling period, thread safe */
+        std::chrono::milliseconds getPollingPhase() const;
+
+        /** \brief Offset of the reading cycles at 'phaseRatio' of 'period' */
+        static std::chrono::milliseconds computePollingPhase(std::chrono::milliseconds period, double phaseRatio);
+
+        /** \brief Polling period of a configuration (1 s if not set) */
+        static std::chrono::milliseconds getPollingPeriod(const ApplicationParameters &applicationParams);
+
+        /** \brief Delay from 'now' to the next start of a cycle (in ]0, period]) */
+        static std::chrono::milliseconds computeDelayToNextCycle(std::chrono::steady_clock::time_point now,
+                                                                 std::chrono::milliseconds period,
+                                                                 std::chrono::milliseconds phase);
+
+        /**
+         * \brief Latencies of the requests per priority class, thread safe
+         *
+         * (all the connections so far, the current one as of the last reading cycle)
+         */
+        RequestLatencies getRequestLatencies() const;
+
+        /** \brief Effective reading periods of the DO and datasets, in adaptive polling, thread safe */
+        PollingRateDistribution getPollingRateDistribution() const;
+
+        /** \brief Adaptation of the polling to the response time of the IED, thread safe */
+        CongestionState getCongestionState() const;
+
+        /**
+         * \brief Delay before the next connection attempt: exponential backoff with jitter
+         *
+         * The delay doubles with each consecutive failure, from 'reconnectMinDelayInMs'
+         * up to 'reconnectMaxDelayInMs', and the jitter draws it in [delay/2, delay]:
+         * the clients of a whole substation do not retry in lockstep.
+         *
+         * \param jitterRatio random value in [0, 1]
+         */
+        static std::chrono::milliseconds computeReconnectDelay(unsigned int consecutiveFailures,
+                                                               const ServerConnectionParameters &connParam,
+                                                               double jitterRatio);
+
     private:
         std::string m_clientId;
 
         // Section: Configuration
-        const ServerConnectionParameters &m_connectionParam;
-        const ApplicationParameters &m_applicationParams;
+        /** The configuration can be replaced between 2 reading cycles (see updateConfiguration) */
+        const ServerConnectionParameters *m_connectionParam;
+        const ApplicationParameters *m_applicationParams;
+
+        const ExchangedDatasets *m_selectedDOInExchangedDatasets;
+
+        /** \brief ExchangedData config, shared by all the clients (immutable while started) */
+        const ExchangedData *m_exchangedData;
+
+        /** \brief owner of the configuration above (null: owned by the caller) */
+        std::shared_ptr<const IEC61850ClientConfig> m_config;
+
+        /** \brief configuration to apply at the next reading cycle */
+        std::shared_ptr<const IEC61850ClientConfig> m_pendingConfig;
+        std::mutex m_pendingConfigMutex;  /**< Protect m_pendingConfig */
+
+        /** \brief Swap the pending configuration, from the reading thread */
+        void applyPendingConfiguration();
 
-        const ExchangedDatasets &m_selectedDOInExchangedDatasets;
+        /** \brief for each ExchangedData: its name tree, for this connection (null: not resolved) */
+        std::vector<std::shared_ptr<MmsNameNode>> m_nameTrees;
 
-        /** \brief local copy of ExchangedData config */
-        ExchangedData m_localExchangedData;
+        /** \brief shared name subtrees (optional) */
+        IEC61850NameTreeCache *m_nameTreeCache;
 
         /** \brief local copy of ExchangedDataset config */
         ExchangedDatasets m_localExchangedDatasets;
 
+        /** \brief association specific datasets, grouping the ExchangedData (indexes) by logical device */
+        std::map<std::string, std::vector<std::size_t>, std::less<>> m_dynamicDatasetMembers;
+
+        /** \brief for each ExchangedData: true if read through a dynamic dataset */
+        std::vector<bool> m_isReadByDynamicDataset;
+
+        /** \brief read strategy of each entry of m_localExchangedDatasets (default: full dataset) */
+        std::map<std::string, DatasetReadStrategy, std::less<>> m_datasetReadStrategies;
+
         IEC61850 *m_iec61850; /**< plugin main object to which to forward the reading data */
 
+        // Section: model discovery (name trees and datasets)
+        /** \brief Discover the whole configuration at once */
         void buildConfigurationNameTrees();
 
+        /** \brief Forget the discovered model (new connection) */
+        void resetDiscovery();
+
+        /** \brief Discover again the datasets, keeping the DO name trees (new configuration) */
+        void restartDiscovery();
+
+        /** \brief Delete the dynamic and trimmed datasets created by the discovery */
+        void deleteAssociationDatasets();
+
+        /** \brief number of association specific dataset names used on this connection (created or not) */
+        uint32_t m_associationDatasetCount = 0;
+
+        /**
+         * \brief Build the name trees of the next DO, until the deadline
+         *
+         * At least 1 DO is discovered per call. Once all the DO are
+         * discovered, the datasets are discovered too.
+         * \return true when the discovery is complete
+         */
+        bool discoverNameTrees(std::chrono::steady_clock::time_point deadline);
+
+        /** \brief Build the name tree of a DO, in 1 request, with shared subtrees (nullptr on failure) */
+        std::shared_ptr<MmsNameNode> resolveNameTree(const DatapointConfig &dpConfig);
+
+        /**
+         * \brief Resolve the name tree of a DO at its first value, if not yet known
+         *
+         * \return false if the structure is still unknown: the value is skipped,
+         *         the query is retried with the next value
+         */
+        bool resolveNameTreeOfValue(std::shared_ptr<MmsNameNode> &nameTree,
+                                    const DatapointConfig &dpConfig,
+                                    const MmsValue *mmsValue);
+
+        /** \brief Discover the members of the configured datasets (without their name tree) */
+        void discoverDatasets();
+
+        /**
+         * \brief Run 1 discovery step, within the slots of the discovery coordinator
+         *
+         * \return true if the discovery is still in progress
+         */
+        bool discoverConfigurationStep(std::chrono::milliseconds budget);
+
+        IEC61850DiscoveryCoordinator *m_discoveryCoordinator;
+        IEC61850DiscoveryCoordinator::Ticket m_discoveryTicket = 0;
+        bool m_isDiscoveryQueued = false;
+
+        /** \brief number of configured points: the discovery priority */
+        std::size_t m_configuredPointCount = 0;
+        std::size_t countConfiguredPoints() const;
+
+        /** \brief the DO of m_exchangedData before this index are discovered */
+        std::size_t m_discoveredDOCount = 0;
+        bool m_isDiscoveryComplete = false;
+
+        /**
+         * \brief Create the dynamic datasets, in DO reading mode
+         *
+         * One association specific dataset per logical device, containing
+         * all the configured DO. If the server refuses the creation, the DO of
+         * this logical device are still read one by one.
+         */
+        void createDynamicDatasets();
+
+        /**
+         * \brief Choose how to read a dataset, and register it for reading
+         *
+         * When the selected members are a fraction of the dataset below
+         * 'partial_read_threshold', only these members are read: through a
+         * trimmed association specific dataset, or, if the server refuses
+         * its creation, through 1 multiple variables read per logical device.
+         */
+        void selectDatasetReadStrategy(const std::string &datasetRef,
+                                       const ExchangedData &exchangedDataset);
+
+        static const char *datasetReadStrategyToString(DatasetReadStrategy strategy);
+
+        /**
+         * \brief Find the selected DO matching a dataset member
+         *
+         * 'nameBuffer' is reused between the calls, to avoid allocations.
+         */
+        static const DatapointConfig *findSelectedDO(
+            const std::string &doPath,
+            const std::unordered_map<std::string, const DatapointConfig *> &selectedDOByName,
+            std::string &nameBuffer);
+
+        /** \brief Split a 'LD/LN.DO[FC]' reference into the DO path and the FC */
+        static void splitDoPathWithFC(const std::string &doPathWithFC,
+                                      std::string &doPath,
+                                      FunctionalConstraint &functionalConstraint);
+
+        /** \brief Build the 'LD/LN.DO[FC]' reference of a DO */
+        static std::string buildDoPathWithFC(const DatapointConfig &dpConfig);
+
         /**
          * \brief Create the Datapoint object that will be ingest by Fledge
          *
@@ -130,6 +373,9 @@ class IEC61850Client
          */
         static Datapoint *convertMmsToDatapoint(const MmsValue *mmsValue,
                                                 const DatapointConfig &datapointConfig);
+        static Datapoint *convertMmsToDatapoint(const MmsValue *mmsValue,
+                                                const DatapointConfig &datapointConfig,
+                                                const MmsNameNode *mmsNameTree);
 
         /**
          * \brief Send a Datapoint to Fledge
@@ -138,12 +384,48 @@ class IEC61850Client
          */
         void sendData(Datapoint *datapoint);
 
-        /** \brief Use the IEC61850 connection for reading DO or Dataset */
-        void readAndExportMms();
+        /**
+         * \brief Use the IEC61850 connection for reading DO or Dataset
+         *
+         * \return true if the model discovery is still in progress
+         */
+        bool readAndExportMms();
         void readAndExportAllDO();
         void readAndExportAllDatasets();
+
+        /**
+         * \brief Run the read tasks in 1 shard per MMS association (in parallel)
+         *
+         * The first exception of a task is rethrown once all the shards are done.
+         */
+        void runReadTasks(const std::vector<std::function<void()>> &readTasks);
+
+        /**
+         * \brief Run the read tasks, and read the high priority DO meanwhile
+         *
+         * The high priority DO are read at the start, then every
+         * 'highPriorityReadPeriodInMs' (if not 0) until the read tasks are done.
+         * Their requests are sent before the waiting requests of the read tasks.
+         */
+        void runReadTasksWithHighPriorityLane(const std::vector<std::function<void()>> &readTasks,
+                                              const std::vector<std::size_t> &highPriorityIndexes);
+        void readAndExportHighPriorityDO(const std::vector<std::size_t> &doIndexes);
         void readAndExportOneDataset(const std::string &datasetRef,
-                                     const ExchangedData &exchangedDataset);
+                                     ExchangedData &exchangedDataset);
+        void readAndExportDynamicDataset(const std::string &datasetRef,
+                                         const std::vector<std::size_t> &doIndexes);
+
+        /** \brief Export the value of a configured DO (resolve its name tree if needed) */
+        /** \param fingerprint of the exported value (see 'fingerprintDatapoint') */
+        /** \return false if the value is skipped (structure of the DO still unknown) */
+        bool exportDO(std::size_t doIndex, const MmsValue *mmsValue, std::size_t &fingerprint);
+
+        /**
+         * \brief Check the result of 1 read request
+         *
+         * A failed read is logged and skipped: the other reads of the cycle go on.
+         */
+        bool isReadSuccessful(IedClientError error, const std::string &reference) const;
 
         // Section: Client initialization with connection creation
         void launch();
@@ -152,8 +434,104 @@ class IEC61850Client
         void destroyConnection();
         std::thread m_backgroundLaunchThread;
         std::atomic<bool> m_stopOrder{false};
+
+        /**
+         * \brief Wait for the timeout, unless the client is stopped meanwhile
+         *
+         * \return true if the wait is interrupted by the stop order
+         */
+        bool waitForStopOrder(std::chrono::milliseconds timeout);
+
+        /** \brief Interrupt the current wait, without stopping the client */
+        void wake();
+        bool m_isWakeRequested = false;
+
+        std::mutex m_stopMutex;  /**< Protect the update of the stop conditions */
+        std::condition_variable m_stopRequested;
         std::unique_ptr<IEC61850ClientConnectionInterface> m_connection;
 
+        /** \brief Wait the end of an asynchronous connection (or the stop order) */
+        void waitForConnectionResult();
+
+        /** \return the delay before the next attempt */
+        std::chrono::milliseconds recordConnectionFailure();
+        void recordConnectionSuccess();
+
+        ReconnectStatistics m_reconnectStatistics;
+        mutable std::mutex m_reconnectStatisticsMutex;  /**< Protect 'm_reconnectStatistics' */
+        std::chrono::steady_clock::time_point m_connectStartTime;
+        std::minstd_rand m_jitterGenerator;
+
+        RequestLatencies m_pastRequestLatencies;  /**< of the destroyed connections */
+        RequestLatencies m_currentRequestLatencies;  /**< of the current connection, at the last cycle */
+        mutable std::mutex m_requestLatenciesMutex;  /**< Protect the request latencies */
+
+        // Section: redundant connections
+        /** \brief Group of the redundant connections with the IED (null: no redundancy) */
+        IEC61850RedundancyGroup *m_redundancyGroup;
+
+        /**
+         * \brief Report the health of the connection to the redundancy group
+         *
+         * \return true if the client reads and exports the data (active, or no redundancy)
+         */
+        bool isActiveInRedundancyGroup(bool isHealthy);
+
+        // Section: request budget of the link with the IED
+        /** \brief Budget shared with the IEDs of the same link (null: no limit) */
+        IEC61850RequestBudget *m_requestBudget;
+
+        /**
+         * \brief Wait until the read fits in the request budget of the link
+         *
+         * \param referenceBytes size of the references in the request
+         * \return false if the client is stopped meanwhile: the read is skipped
+         */
+        bool drawFromRequestBudget(ReadPriority priority, std::size_t doCount, std::size_t referenceBytes);
+
+        // Section: adaptive polling
+        /** \brief Period of each DO or dataset (unit key: label of the DO, or dataset reference) */
+        IEC61850AdaptivePolling m_adaptivePolling;
+
+        /**
+         * \brief Is the unit read at this cycle (always, without adaptive polling)
+         *
+         * The reading period is the granularity of the unit periods.
+         */
+        bool isPollingDue(const std::string &unitKey, const PollingPeriodBounds &unitBounds);
+
+        /** \brief Adapt the period of the unit to its new value (nothing without adaptive polling) */
+        void recordPolledValue(const std::string &unitKey, std::size_t fingerprint);
+
+        /** \brief Bounds of the DO: its own ones, or the ones of the application layer */
+        PollingPeriodBounds resolvePollingBounds(const DatapointConfig &dpConfig) const;
+
+        /** \brief Fingerprint of a converted value, to detect its changes (0 without adaptive polling) */
+        std::size_t fingerprintDatapoint(Datapoint *datapoint) const;
+
+        // Section: congestion control
+        /** \brief Effective period and requests in flight, adapted to the response time of the IED */
+        IEC61850CongestionControl m_congestionControl;
+
+        /** \brief Adapt the polling to the response times of the cycle */
+        void updateCongestionControl(const ResponseTimeSummary &responseTimes);
+
+        // Section: runtime statistics
+        /** \brief Hot path measurements, published as a reading of the statistics asset */
+        IEC61850RuntimeStatistics m_runtimeStatistics;
+
+        /** \brief Convert a read value, and count the conversion errors */
+        Datapoint *convertReadValue(const MmsValue *mmsValue,
+                                    const DatapointConfig &datapointConfig,
+                                    const MmsNameNode *mmsNameTree);
+
+        /** \brief Publish the statistics of the interval, if its period is over */
+        void publishRuntimeStatistics();
+
+        /** \brief 1 datapoint per statistic (durations in us) */
+        static std::vector<Datapoint *> buildStatisticsDatapoints(const std::string &clientId,
+                                                                 const RuntimeStatisticsSnapshot &snapshot);
+
         // Section: MMS reading (DO and Dataset)
         /** \brief Start the MMS reading loop (DO or Dataset) */
         void startMmsReading();
@@ -164,6 +542,17 @@ class IEC61850Client
         /** \brief Loop for MMS reading (DO or Dataset) */
         void readMmsLoop();
 
+        /** \brief Polling period of the configuration in use, thread safe */
+        std::chrono::milliseconds getPollingPeriod() const;
+
+        /** \brief Polling period, slowed down while the IED is congested */
+        std::chrono::milliseconds getEffectivePollingPeriod() const;
+
+        std::atomic<double> m_pollingPhaseRatio{0.0};
+
+        /** \brief Period of the configuration in use: also read by the other threads (see getPollingPhase) */
+        std::atomic<int64_t> m_pollingPeriodInMs{1000};
+
         std::atomic<bool> m_isMmsReadingActivated{false};
 
         /** \brief Thread for for MMS reading loop (DO or Dataset) */
@@ -177,6 +566,7 @@ class IEC61850Client
         FRIEND_TEST(IEC61850ClientTest, injectMockConnection);
         FRIEND_TEST(IEC61850ClientTest, initializeConnectionInOneTry);
         FRIEND_TEST(IEC61850ClientTest, initializeConnectionFailed);
+        FRIEND_TEST(IEC61850ClientTest, noConnectionAfterStopOrder);
         FRIEND_TEST(IEC61850ClientTest, startAndStop);
         FRIEND_TEST(IEC61850ClientTest, buildIntegerDatapoint);
         FRIEND_TEST(IEC61850ClientTest, buildUnsignedIntegerDatapoint);
@@ -189,6 +579,39 @@ class IEC61850Client
         FRIEND_TEST(IEC61850ClientTest, buildComplexDatapoint);
         FRIEND_TEST(IEC61850ClientTest, buildComplexMxDatapoint);
         FRIEND_TEST(IEC61850ClientTest, buildComplexDatapointWithErroneousStructure);
+        FRIEND_TEST(IEC61850ClientTest, createDynamicDatasetsByLogicalDevice);
+        FRIEND_TEST(IEC61850ClientTest, createDynamicDatasetsRefused);
+        FRIEND_TEST(IEC61850ClientTest, createDynamicDatasetsWithinPduSize);
+        FRIEND_TEST(IEC61850ClientTest, readFullDatasetAboveThreshold);
+        FRIEND_TEST(IEC61850ClientTest, readTrimmedDatasetBelowThreshold);
+        FRIEND_TEST(IEC61850ClientTest, readSelectedMembersWhenTrimRefused);
+        FRIEND_TEST(IEC61850ClientTest, splitDoPathWithFC);
+        FRIEND_TEST(IEC61850ClientTest, matchSelectedDOExactly);
+        FRIEND_TEST(IEC61850ClientTest, matchSelectedDOOnDataAttributeMember);
+        FRIEND_TEST(IEC61850ClientTest, readDOBeforeDiscovery);
+        FRIEND_TEST(IEC61850ClientTest, retryNameTreeAfterFailedQuery);
+        FRIEND_TEST(IEC61850ClientTest, skipValueWithUnknownStructure);
+        FRIEND_TEST(IEC61850ClientTest, waitForDiscoverySlot);
+        FRIEND_TEST(IEC61850ClientTest, shareNameSubtrees);
+        FRIEND_TEST(IEC61850ClientTest, updateConfigurationKeepsNameTrees);
+        FRIEND_TEST(IEC61850ClientTest, deleteDatasetsOnReconfiguration);
+        FRIEND_TEST(IEC61850ClientTest, stopDuringPollingPeriod);
+        FRIEND_TEST(IEC61850ClientTest, reconnectWithBackoff);
+        FRIEND_TEST(IEC61850ClientTest, keepAliveInStandby);
+        FRIEND_TEST(IEC61850ClientTest, failoverToStandby);
+        FRIEND_TEST(IEC61850ClientTest, keepReadingAfterFailedRead);
+        FRIEND_TEST(IEC61850ClientTest, shardReadsOverAssociations);
+        FRIEND_TEST(IEC61850ClientTest, readHighPriorityDOInOwnLane);
+        FRIEND_TEST(IEC61850ClientTest, alignCyclesOnPollingPhase);
+        FRIEND_TEST(IEC61850ClientTest, drawReadsFromRequestBudget);
+        FRIEND_TEST(IEC61850ClientTest, adaptPollingToValueChanges);
+        FRIEND_TEST(IEC61850ClientTest, slowDownCongestedIED);
+        FRIEND_TEST(IEC61850ClientTest, publishRuntimeStatistics);
+        FRIEND_TEST(IEC61850ClientTest, overlapShardsInVirtualTime);
+        FRIEND_TEST(IEC61850ClientTest, narrowWindowOnInjectedTimeouts);
+
+        // Section: see the class as a white box for the micro-benchmarks (tests/benchmarks)
+        friend class IEC61850ClientBenchmark;
 };
 
 #endif  // INCLUDE_IEC61850_CLIENT_H_
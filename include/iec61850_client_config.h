@@ -30,6 +30,10 @@
 #include <gtest/gtest_prod.h>
 
 constexpr unsigned int DEFAULT_READ_POLLING_PERIOD_IN_MS = 1000;
+constexpr unsigned int DEFAULT_RECONNECT_MIN_DELAY_IN_MS = 1000;
+constexpr unsigned int DEFAULT_RECONNECT_MAX_DELAY_IN_MS = 30000;
+constexpr unsigned int MIN_MMS_PDU_SIZE = 1024;
+constexpr unsigned int MAX_MMS_PDU_SIZE = 65000;  /**< upper limit of libiec61850 */
 
 /**
  *  \brief Lower layer parameters (below the MMS layer) for connection with server
@@ -55,6 +59,14 @@ struct ServerConnectionParameters {
     int mmsPort{0};
     bool isOsiParametersEnabled{false};
     OsiParameters osiParameters;
+    unsigned int connectTimeoutInMs{0};  /**< 0: default timeout of the library */
+    unsigned int requestTimeoutInMs{0};  /**< 0: default timeout of the library */
+    unsigned int reconnectMinDelayInMs{DEFAULT_RECONNECT_MIN_DELAY_IN_MS};  /**< first delay of the backoff */
+    unsigned int reconnectMaxDelayInMs{DEFAULT_RECONNECT_MAX_DELAY_IN_MS};  /**< upper limit of the backoff */
+    unsigned int associationCount{1};  /**< parallel MMS associations with the IED */
+    unsigned int maxPduSize{0};  /**< proposed MMS PDU size, in bytes (0: default of the library) */
+    unsigned int maxOutstandingCalls{0};  /**< proposed outstanding MMS calls (0: default of the library) */
+    std::string linkGroup;  /**< link sharing its request budget (empty: global budget) */
 };
 
 
@@ -83,12 +95,78 @@ enum class ReadMode {
     DATASET_READING
 };
 
+/**
+ *  \brief Priority of the reading of a DO: the high priority DO are read before the others
+ */
+enum class ReadPriority {
+    HIGH = 0,
+    NORMAL
+};
+
+constexpr std::size_t READ_PRIORITY_COUNT = 2;
+
+/**
+ *  \brief Request rate limits shared by several IEDs (0: no limit)
+ */
+struct RequestBudgetParameters {
+    double requestsPerSecond = 0.0;
+    double bytesPerSecond = 0.0;
+    double highPriorityShare = 0.0;  /**< share of the budget reserved to the high priority reads */
+
+    bool isEnabled() const { return (requestsPerSecond > 0.0) || (bytesPerSecond > 0.0); }
+};
+
+/**
+ *  \brief Bounds of the reading period of a DO or dataset, in adaptive polling (0: not set)
+ */
+struct PollingPeriodBounds {
+    unsigned int minPeriodInMs = 0;
+    unsigned int maxPeriodInMs = 0;
+};
+
+/**
+ *  \brief Adaptation of the polling to the response time of the IED (AIMD)
+ */
+struct CongestionControlParameters {
+    bool isEnabled = false;
+    unsigned int responseTimeThresholdInMs = 0;  /**< above this mean response time, the IED is congested (0: 4 times its baseline) */
+    unsigned int maxSlowdown = 16;  /**< longest effective period, in reading periods */
+};
+
+/**
+ *  \brief Publication of the runtime statistics of each IED as a reading
+ */
+struct RuntimeStatisticsParameters {
+    bool isEnabled = false;
+    std::string assetName = "iec61850_statistics";
+    unsigned int periodInMs = 60000;
+};
+
+/**
+ *  \brief Recording of the hot path spans (the trace is written when it is disabled)
+ */
+struct TracingParameters {
+    bool isEnabled = false;
+    std::string filePath = "/tmp/iec61850_trace.json";  /**< Chrome 'trace_event' format */
+};
+
 /**
  *  \brief Application parameters about the IEC61850 client
  */
 struct ApplicationParameters {
     unsigned int readPollingPeriodInMs = DEFAULT_READ_POLLING_PERIOD_IN_MS;  /** Default polling period: 1 second */
     ReadMode readMode = ReadMode::DO_READING;  /** Default reading mode: DO, not dataset */
+    bool useDynamicDatasets = false;  /** In DO mode, group the DO in association specific datasets */
+    float partialReadThreshold = 0.0f;  /** Below this fraction of selected members, read only these members (0: disabled) */
+    unsigned int maxConcurrentDiscoveries = 0;  /** IED models discovered at the same time (0: no limit) */
+    unsigned int highPriorityReadPeriodInMs = 0;  /** Period of the high priority DO during the other readings (0: once per cycle) */
+    RequestBudgetParameters requestBudget;  /** Budget of the IED without link group (default: no limit) */
+    std::map<std::string, RequestBudgetParameters> linkBudgets;  /** Budget of each link group */
+    bool isAdaptivePollingEnabled = false;  /** Period of each DO or dataset adapted to its changes */
+    PollingPeriodBounds adaptivePollingBounds;  /** Default bounds (the reading period is the granularity) */
+    CongestionControlParameters congestionControl;  /** Slow down the polling of a congested IED */
+    RuntimeStatisticsParameters runtimeStatistics;  /** Statistics asset (default: not published) */
+    TracingParameters tracing;  /** Trace of the hot paths (default: not recorded) */
 };
 
 using OsiSelectorSize = uint8_t;
@@ -109,6 +187,8 @@ struct DatapointConfig {
     DataPath dataPath = "NOT_DEFINED";  /**< Object path in the IEC61850 data mode */
     FunctionalConstraint functionalConstraint = IEC61850_FC_NONE;
     std::shared_ptr<MmsNameNode> mmsNameTree = nullptr;  /**< name of each subelement of the MMS and datapoint */
+    ReadPriority priority = ReadPriority::NORMAL;  /**< in DO mode, the high priority DO are read in their own lane */
+    PollingPeriodBounds pollingPeriodBounds;  /**< in adaptive polling (0: the bounds of the application layer) */
 };
 
 /**
@@ -143,6 +223,8 @@ class IEC61850ClientConfig
         std::string iedName;
 
         ServerConfigDict serverConfigDict;
+        /** \brief The connections reach the same IED: one is active, the others in hot standby */
+        bool isRedundancyEnabled = false;
 
         ApplicationParameters applicationParams;
 
@@ -158,6 +240,10 @@ class IEC61850ClientConfig
                     std::to_string(serverConn.mmsPort));
         }
 
+        /** \brief True if both parameters open the same connection (same IED, same OSI layers) */
+        static bool isSameConnection(const ServerConnectionParameters &firstConn,
+                                     const ServerConnectionParameters &secondConn);
+
         static void logIedConnectionParam(const ServerConnectionParameters &iedConnectionParam);
         static void logOsiSelector(const std::string &selectorName,
                                    const int selectorSize,
@@ -172,9 +258,20 @@ class IEC61850ClientConfig
         void importJsonConnectionConfig(const rapidjson::Value &connConfig);
         void importJsonConnectionOsiConfig(const rapidjson::Value &connOsiConfig,
                                            ServerConnectionParameters &iedConnectionParam) const;
+        /** \brief Import an optional delay of a connection, in milliseconds */
+        static void importJsonConnectionDelay(const rapidjson::Value &connConfig,
+                                              const char *delayName,
+                                              unsigned int &delayInMs);
         void importJsonConnectionOsiSelectors(const rapidjson::Value &connOsiConfig,
                                               OsiParameters *osiParams) const;
         void importJsonApplicationLayerConfig(const rapidjson::Value &applicationLayer);
+        static void importJsonPollingPeriodBounds(const rapidjson::Value &jsonConfig,
+                                                  PollingPeriodBounds &bounds);
+        static TracingParameters importJsonTracing(const rapidjson::Value &jsonTracing);
+        static RuntimeStatisticsParameters importJsonRuntimeStatistics(const rapidjson::Value &jsonStatistics);
+        static CongestionControlParameters importJsonCongestionControl(const rapidjson::Value &jsonCongestionControl);
+        static RequestBudgetParameters importJsonRequestBudget(const rapidjson::Value &jsonBudget,
+                                                               const std::string &budgetName);
         void importJsonExchangedDataConfig(const std::string &exchangedDataConfig);
         void importJsonExchangedDatasetsConfig(const std::string &exchangedDatasetsConfig);
         void importJsonDatapointConfig(const rapidjson::Value &jsonDatapointConfig);
@@ -211,6 +308,32 @@ class IEC61850ClientConfig
         FRIEND_TEST(IEC61850ClientConfigTest, importDatapointWithMissingMandatoryAddress);
         FRIEND_TEST(IEC61850ClientConfigTest, importDatapointWithAddressBadFormat);
         FRIEND_TEST(IEC61850ClientConfigTest, importValidExchangedDataWithIgnoredProtocols);
+        FRIEND_TEST(IEC61850ClientConfigTest, importDynamicDatasetsOption);
+        FRIEND_TEST(IEC61850ClientConfigTest, importDynamicDatasetsOptionBadFormat);
+        FRIEND_TEST(IEC61850ClientConfigTest, importPartialReadThreshold);
+        FRIEND_TEST(IEC61850ClientConfigTest, importPartialReadThresholdOutOfRange);
+        FRIEND_TEST(IEC61850ClientConfigTest, importMaxConcurrentDiscoveries);
+        FRIEND_TEST(IEC61850ClientConfigTest, importMaxConcurrentDiscoveriesBadFormat);
+        FRIEND_TEST(IEC61850ClientConfigTest, importConnectionTimeouts);
+        FRIEND_TEST(IEC61850ClientConfigTest, importConnectionTimeoutBadFormat);
+        FRIEND_TEST(IEC61850ClientConfigTest, importReconnectDelaysInWrongOrder);
+        FRIEND_TEST(IEC61850ClientConfigTest, importRedundantConnections);
+        FRIEND_TEST(IEC61850ClientConfigTest, importRedundantConnectionsBadFormat);
+        FRIEND_TEST(IEC61850ClientConfigTest, importAssociationCount);
+        FRIEND_TEST(IEC61850ClientConfigTest, importAssociationCountOutOfRange);
+        FRIEND_TEST(IEC61850ClientConfigTest, importMmsTuning);
+        FRIEND_TEST(IEC61850ClientConfigTest, importMmsTuningOutOfRange);
+        FRIEND_TEST(IEC61850ClientConfigTest, importDatapointPriorities);
+        FRIEND_TEST(IEC61850ClientConfigTest, importDatapointWithUnknownPriority);
+        FRIEND_TEST(IEC61850ClientConfigTest, importRequestBudgets);
+        FRIEND_TEST(IEC61850ClientConfigTest, importRequestBudgetOutOfRange);
+        FRIEND_TEST(IEC61850ClientConfigTest, importAdaptivePolling);
+        FRIEND_TEST(IEC61850ClientConfigTest, importAdaptivePollingBadBounds);
+        FRIEND_TEST(IEC61850ClientConfigTest, importCongestionControl);
+        FRIEND_TEST(IEC61850ClientConfigTest, importCongestionControlBadSlowdown);
+        FRIEND_TEST(IEC61850ClientConfigTest, importRuntimeStatistics);
+        FRIEND_TEST(IEC61850ClientConfigTest, importRuntimeStatisticsBadPeriod);
+        FRIEND_TEST(IEC61850ClientConfigTest, importTracing);
 };
 
 #endif  // INCLUDE_IEC61850_CLIENT_CONFIG_H_
@@ -11,6 +11,8 @@
  * Author: Mikael Bourhis-Cloarec
  */
 
+#include <atomic>
+#include <functional>
 #include <mutex>   // NOLINT
 
 // Fledge headers
@@ -19,6 +21,7 @@
 // local library
 #include "./iec61850_client_connection_interface.h"
 #include "./iec61850_client_config.h"
+#include "./iec61850_request_scheduler.h"
 
 // For white box unit tests
 #include <gtest/gtest_prod.h>
@@ -37,8 +40,16 @@ class IEC61850ClientConnection: public IEC61850ClientConnectionInterface
 {
     public :
 
+        /**
+         * \param isAsyncConnect if true, the constructor does not wait for the
+         * end of the connection: see 'isConnecting'
+         * \param onConnectionLost called (from the libiec61850 thread) when an
+         * established connection is lost or closed
+         */
         explicit
-        IEC61850ClientConnection(const ServerConnectionParameters &connParam);
+        IEC61850ClientConnection(const ServerConnectionParameters &connParam,
+                                 bool isAsyncConnect = false,
+                                 std::function<void()> onConnectionLost = nullptr);
 
         ~IEC61850ClientConnection() override;
 
@@ -54,9 +65,24 @@ class IEC61850ClientConnection: public IEC61850ClientConnectionInterface
         /** Disable move assignment operator */
         IEC61850ClientConnection &operator = (IEC61850ClientConnection &&) = delete;
 
+        /** \brief Lock free: the state is tracked by the state change handler */
         bool isConnected() override;
-        bool isNoError() const override;
-        void logError() const override;
+        /** \brief true while an asynchronous connection is in progress (lock free) */
+        bool isConnecting() override;
+
+        /**
+         * \brief Check the association with the cheapest MMS request ('identify')
+         *
+         * Thread safe.
+         *
+         * \return true if the server answered
+         */
+        bool keepAlive() override;
+
+        /** \brief Lock free: updated when the connection is established */
+        unsigned int getNegotiatedMaxPduSize() override;
+        RequestLatencies getRequestLatencies() const override;
+        ResponseTimeSummary takeResponseTimes() override;
 
         /**
          * \brief Read an object (DO: Data Object) of the Server data model
@@ -64,42 +90,121 @@ class IEC61850ClientConnection: public IEC61850ClientConnectionInterface
          * Reentrant function, thread safe
          */
         std::shared_ptr<WrappedMms> readDO(const std::string &doPath,
-                                           const FunctionalConstraint &functionalConstraint) override;
+                                           const FunctionalConstraint &functionalConstraint,
+                                           IedClientError &error) override;
 
         /**
          * \brief Read a dataset of the Server data model
          *
          * Reentrant function, thread safe
          */
-        std::shared_ptr<WrappedMms> readDataset(const std::string &datasetRef) override;
+        std::shared_ptr<WrappedMms> readDataset(const std::string &datasetRef,
+                                                IedClientError &error) override;
+
+        /**
+         * \brief Read a list of DO ('LD/LN.DO[FC]'), in 1 request per logical device
+         *
+         * The result is an MMS array, with the same layout as a dataset read.
+         * The requests larger than a PDU are split: the waiting high priority
+         * requests are sent between the batches of a normal priority read.
+         * Reentrant function, thread safe
+         */
+        std::shared_ptr<WrappedMms>
+        readMultipleDO(const std::vector<std::string> &doPathListWithFC,
+                       ReadPriority priority,
+                       IedClientError &error) override;
 
-        void buildNameTree(const std::string &pathInDatamodel,
+        /**
+         * \brief Build the name tree of a DO, from its MMS variable specification
+         *
+         * The whole structure is known in 1 request. An unknown DO gives an
+         * empty tree: only a failed query (timeout, connection...) returns false.
+         * Reentrant function, thread safe
+         */
+        bool buildNameTree(const std::string &pathInDatamodel,
                            const FunctionalConstraint &functionalConstraint,
                            MmsNameNode *nameTree) override;
 
         std::vector<std::string>
         getDoPathListWithFCFromDataset(const std::string &datasetRef) override;
 
+        /**
+         * \brief Create a dataset on the Server side
+         *
+         * A reference starting with '@' creates an association specific
+         * (non persistent) dataset, deleted by the server when the connection is closed.
+         * Return false if the server refuses the creation.
+         */
+        bool createDataset(const std::string &datasetRef,
+                           const std::vector<std::string> &doPathListWithFC) override;
+
+        /**
+         * \brief Delete a dataset on the Server side
+         *
+         * Return false if the server refuses the deletion.
+         */
+        bool deleteDataset(const std::string &datasetRef) override;
+
+        /**
+         * \brief Split a list of MMS names into consecutive batches, each sent in 1 PDU
+         *
+         * The size of a request is estimated from the length of the names.
+         * \param maxPduSize 0: no limit, 1 batch
+         * \return the number of names of each batch
+         */
+        static std::vector<std::size_t> splitIntoBatches(const std::vector<std::string> &names,
+                                                         unsigned int maxPduSize);
+
+        /** \brief Description of a request error, for the logs */
+        static const char *getErrorDescription(IedClientError error);
+
     private:
         /** \brief Open a connection with an IEC61850 server */
-        void open();
+        void open(bool isAsyncConnect);
 
         /** \brief Close the connection with an IEC61850 server */
         void close();
 
         void setOsiConnectionParameters();
 
-        LinkedList getDataDirectory(const std::string &pathInDatamodel,
-                                    const FunctionalConstraint &functionalConstraint);
+        /** \brief Propose the PDU size and the outstanding calls of the configuration */
+        void setMmsConnectionParameters();
+
+        /** \brief Log and keep the MMS parameters accepted by the IED */
+        void updateNegotiatedParameters(IedConnection connection);
+
+        /** \brief Convert 'LD/LN.DO[FC]' into the MMS domain 'LD' and item 'LN$FC$DO' */
+        static bool toMmsVariableName(const std::string &doPathWithFC,
+                                      std::string &domainId,
+                                      std::string &itemId);
+
+        static void buildNameTreeFromSpecification(MmsVariableSpecification *specification,
+                                                   MmsNameNode *nameTree);
 
         LinkedList getDataSetDirectory(const std::string &datasetRef);
 
+        /** \brief Count a timeout in the response times */
+        void recordRequestError(IedClientError error);
+
+        /** \brief Result of a multiple variables read, as a request error */
+        static IedClientError toRequestError(MmsError mmsError);
+
+        /** \brief State change handler of libiec61850 */
+        static void connectionStateChanged(void *parameter,
+                                           IedConnection connection,
+                                           IedConnectionState newState);
+
         ServerConnectionParameters m_connectionParam;
+        std::string m_iedKey;  /**< IED of the connection, in the probes */
+        /** \brief Order the requests: the high priority ones go first */
+        IEC61850RequestScheduler m_requestScheduler;
         std::mutex m_iedConnectionMutex;  /**< Protect the libiec61850 'IedConnection' resource */
 
         // libiec61850 objects
         IedConnection       m_iedConnection = nullptr;
-        IedClientError      m_networkStack_error = IED_ERROR_OK;
+        std::atomic<IedConnectionState> m_connectionState{IED_STATE_CLOSED};
+        std::atomic<unsigned int> m_negotiatedMaxPduSize{0};
+        std::function<void()> m_onConnectionLost;
         AcseAuthenticationParameter m_acseAuthentParams{nullptr};
 
         // Section: see the class as a white box for unit tests
@@ -108,6 +213,11 @@ class IEC61850ClientConnection: public IEC61850ClientConnectionInterface
         FRIEND_TEST(IEC61850ClientConnectionTestWithIEC61850Server, readDOValidMms);
         FRIEND_TEST(IEC61850ClientConnectionTestWithIEC61850Server, readDOButNotConnected);
         FRIEND_TEST(IEC61850ClientConnectionTestWithIEC61850Server, readBadSingleMms);
+        FRIEND_TEST(IEC61850ClientConnectionTestWithIEC61850Server, readMultipleDOValidMms);
+        FRIEND_TEST(IEC61850ClientConnectionTest, convertToMmsVariableName);
+        FRIEND_TEST(IEC61850ClientConnectionTestWithIEC61850Server, buildNameTreeInOneRequest);
+        FRIEND_TEST(IEC61850ClientConnectionTestWithIEC61850Server, notifyConnectionLoss);
+        FRIEND_TEST(IEC61850ClientConnectionTestWithIEC61850Server, negotiateMaxPduSize);
 };
 
 #endif  // INCLUDE_IEC61850_CLIENT_CONNECTION_H_
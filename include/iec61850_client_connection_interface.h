@@ -17,6 +17,7 @@
 #include <libiec61850/iec61850_client.h>
 
 // local library
+#include "./iec61850_request_scheduler.h"
 #include "./wrapped_mms.h"
 
 class MmsNameNode;
@@ -28,19 +29,42 @@ class IEC61850ClientConnectionInterface
         virtual ~IEC61850ClientConnectionInterface() = default;
 
         virtual bool isConnected() = 0;
-        virtual bool isNoError() const = 0;
-        virtual void logError() const = 0;
+        virtual bool isConnecting() = 0;
+        virtual bool keepAlive() = 0;
 
+        /** \brief MMS PDU size negotiated with the IED, in bytes (0: not known yet) */
+        virtual unsigned int getNegotiatedMaxPduSize() = 0;
+
+        /** \brief Latencies of the requests sent so far, per priority class */
+        virtual RequestLatencies getRequestLatencies() const = 0;
+
+        /** \brief Exchange times and timeouts of the requests since the last call */
+        virtual ResponseTimeSummary takeResponseTimes() = 0;
+
+        /** The reads set 'error' to the result of this request only (IED_ERROR_OK on success) */
         virtual std::shared_ptr<WrappedMms> readDO(const std::string &doPath,
-                const FunctionalConstraint &functionalConstraint) = 0;
+                const FunctionalConstraint &functionalConstraint,
+                IedClientError &error) = 0;
 
-        virtual std::shared_ptr<WrappedMms> readDataset(const std::string &datasetRef) = 0;
+        virtual std::shared_ptr<WrappedMms> readDataset(const std::string &datasetRef,
+                                                        IedClientError &error) = 0;
 
-        virtual void buildNameTree(const std::string &pathInDatamodel,
+        virtual std::shared_ptr<WrappedMms>
+        readMultipleDO(const std::vector<std::string> &doPathListWithFC,
+                       ReadPriority priority,
+                       IedClientError &error) = 0;
+
+        /** \brief false if the structure could not be queried (to be retried) */
+        virtual bool buildNameTree(const std::string &pathInDatamodel,
                                    const FunctionalConstraint &functionalConstraint,
                                    MmsNameNode *nameTree) = 0;
 
         virtual std::vector<std::string>
         getDoPathListWithFCFromDataset(const std::string &datasetRef) = 0;
+
+        virtual bool createDataset(const std::string &datasetRef,
+                                   const std::vector<std::string> &doPathListWithFC) = 0;
+
+        virtual bool deleteDataset(const std::string &datasetRef) = 0;
 };
 #endif  // INCLUDE_IEC61850_CLIENT_CONNECTION_INTERFACE_H_
@@ -0,0 +1,122 @@
+#ifndef INCLUDE_IEC61850_CLIENT_CONNECTION_POOL_H_
+#define INCLUDE_IEC61850_CLIENT_CONNECTION_POOL_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <string>
+#include <vector>
+
+// local library
+#include "./iec61850_client_connection_interface.h"
+#include "./iec61850_client_config.h"
+
+// For white box unit tests
+#include <gtest/gtest_prod.h>
+
+/** \class IEC61850ClientConnectionPool
+ *  \brief Several MMS associations with the same IED, seen as one connection
+ *
+ *  Each request is sent on a free association: concurrent requests (from the
+ *  shards of the reading cycle) are served in parallel by the IED.
+ *  The association specific datasets are created on every association, so
+ *  that any association can read them.
+ *  Thread safe.
+ */
+class IEC61850ClientConnectionPool: public IEC61850ClientConnectionInterface
+{
+    public :
+        /** \brief Open 'connParam.associationCount' associations with the IED */
+        IEC61850ClientConnectionPool(const ServerConnectionParameters &connParam,
+                                     bool isAsyncConnect,
+                                     const std::function<void()> &onConnectionLost);
+
+        /** \brief Pool of already opened associations */
+        explicit
+        IEC61850ClientConnectionPool(std::vector<std::unique_ptr<IEC61850ClientConnectionInterface>> associations);
+
+        ~IEC61850ClientConnectionPool() override = default;
+
+        IEC61850ClientConnectionPool(const IEC61850ClientConnectionPool &) = delete;
+        IEC61850ClientConnectionPool &operator = (const IEC61850ClientConnectionPool &) = delete;
+        IEC61850ClientConnectionPool(IEC61850ClientConnectionPool &&) = delete;
+        IEC61850ClientConnectionPool &operator = (IEC61850ClientConnectionPool &&) = delete;
+
+        /** \brief true when all the associations are connected */
+        bool isConnected() override;
+        bool isConnecting() override;
+        bool keepAlive() override;
+        /** \brief The smallest PDU size of the associations (0 if one is unknown) */
+        unsigned int getNegotiatedMaxPduSize() override;
+        /** \brief The latencies of all the associations */
+        RequestLatencies getRequestLatencies() const override;
+        /** \brief The response times of all the associations */
+        ResponseTimeSummary takeResponseTimes() override;
+
+        std::shared_ptr<WrappedMms> readDO(const std::string &doPath,
+                                           const FunctionalConstraint &functionalConstraint,
+                                           IedClientError &error) override;
+
+        std::shared_ptr<WrappedMms> readDataset(const std::string &datasetRef,
+                                                IedClientError &error) override;
+
+        std::shared_ptr<WrappedMms>
+        readMultipleDO(const std::vector<std::string> &doPathListWithFC,
+                       ReadPriority priority,
+                       IedClientError &error) override;
+
+        bool buildNameTree(const std::string &pathInDatamodel,
+                           const FunctionalConstraint &functionalConstraint,
+                           MmsNameNode *nameTree) override;
+
+        std::vector<std::string>
+        getDoPathListWithFCFromDataset(const std::string &datasetRef) override;
+
+        /**
+         * \brief Create the dataset on each association (true if all succeed)
+         *
+         * If an association refuses it, the dataset is deleted from the
+         * associations which created it: none of them keeps it.
+         */
+        bool createDataset(const std::string &datasetRef,
+                           const std::vector<std::string> &doPathListWithFC) override;
+
+        /** \brief Delete the dataset on each association (true if all succeed) */
+        bool deleteDataset(const std::string &datasetRef) override;
+
+        std::size_t size() const
+        {
+            return m_associations.size();
+        }
+
+    private:
+        /** \brief Take a free association, wait for one if all are busy (high priority first) */
+        std::size_t acquireAssociation(ReadPriority priority);
+        void releaseAssociation(std::size_t associationIndex);
+
+        /** \brief Send the request on a free association */
+        template <typename Request>
+        auto sendOnFreeAssociation(Request request, ReadPriority priority = ReadPriority::NORMAL)
+        -> decltype(request(std::declval<IEC61850ClientConnectionInterface &>()));
+
+        std::vector<std::unique_ptr<IEC61850ClientConnectionInterface>> m_associations;
+
+        std::vector<bool> m_isAssociationBusy;
+        unsigned int m_highPriorityWaitingCount = 0;
+        std::mutex m_mutex;  /**< Protect 'm_isAssociationBusy' and 'm_highPriorityWaitingCount' */
+        std::condition_variable m_associationReleased;
+
+        // Section: see the class as a white box for unit tests
+        FRIEND_TEST(IEC61850ClientConnectionPoolTest, sendOnFreeAssociation);
+};
+
+#endif  // INCLUDE_IEC61850_CLIENT_CONNECTION_POOL_H_
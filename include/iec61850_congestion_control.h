@@ -0,0 +1,86 @@
+#ifndef INCLUDE_IEC61850_CONGESTION_CONTROL_H_
+#define INCLUDE_IEC61850_CONGESTION_CONTROL_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <mutex>   // NOLINT
+
+// local library
+#include "./iec61850_client_config.h"
+#include "./iec61850_request_scheduler.h"
+
+/** \struct CongestionState
+ *  \brief Adaptation of the polling of an IED to its response time
+ */
+struct CongestionState {
+    double slowdown = 1.0;  /**< effective period / reading period */
+    unsigned int window = 1;  /**< requests in flight at the same time */
+    std::chrono::microseconds smoothedResponseTime{0};
+    std::chrono::microseconds baselineResponseTime{0};  /**< response time of the IED without load */
+    uint64_t congestionCount = 0;
+    bool isCongested = false;  /**< at the last update */
+};
+
+/** \class IEC61850CongestionControl
+ *  \brief Additive increase, multiplicative decrease of the polling rate of an IED
+ *
+ *  After each reading cycle, the response times of the cycle are compared
+ *  to a threshold (configured, or 4 times the baseline of the IED).
+ *  A congestion (slow responses, or timeouts) doubles the effective period
+ *  and halves the requests in flight. Otherwise, the rate gets back a tenth
+ *  of the nominal rate and the window a request, up to their nominal values.
+ *  Disabled, the period and the window stay the nominal ones.
+ *  Thread safe.
+ */
+class IEC61850CongestionControl
+{
+    public :
+        IEC61850CongestionControl() = default;
+        ~IEC61850CongestionControl() = default;
+
+        IEC61850CongestionControl(const IEC61850CongestionControl &) = delete;
+        IEC61850CongestionControl &operator = (const IEC61850CongestionControl &) = delete;
+
+        /**
+         * \brief New parameters: back to the nominal rate
+         *
+         * \param maxWindow nominal number of requests in flight (associations of the IED)
+         */
+        void setParameters(const CongestionControlParameters &params, unsigned int maxWindow);
+
+        /**
+         * \brief Adapt the rate to the response times of a reading cycle
+         *
+         * \return true if the IED is congested
+         */
+        bool update(const ResponseTimeSummary &responseTimes);
+
+        /** \brief A lost connection is a congestion, the smoothed response time is forgotten */
+        void recordConnectionLoss();
+
+        /** \brief Effective period of a nominal period */
+        std::chrono::milliseconds scalePeriod(std::chrono::milliseconds period) const;
+
+        unsigned int getWindow() const;
+
+        CongestionState getState() const;
+
+    private:
+        void decrease();
+
+        CongestionControlParameters m_params;
+        unsigned int m_maxWindow = 1;
+        CongestionState m_state;
+
+        mutable std::mutex m_mutex;  /**< Protect all the members above */
+};
+
+#endif  // INCLUDE_IEC61850_CONGESTION_CONTROL_H_
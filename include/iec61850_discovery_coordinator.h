@@ -0,0 +1,93 @@
+#ifndef INCLUDE_IEC61850_DISCOVERY_COORDINATOR_H_
+#define INCLUDE_IEC61850_DISCOVERY_COORDINATOR_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <map>
+#include <mutex>   // NOLINT
+#include <set>
+#include <utility>
+
+// For white box unit tests
+#include <gtest/gtest_prod.h>
+
+/** \class IEC61850DiscoveryCoordinator
+ *  \brief Share the model discovery between the IEC61850 clients
+ *
+ *  Bound the number of clients discovering their IED model at the same time.
+ *  The waiting clients get a discovery slot by ascending number of configured
+ *  points, then by arrival order.
+ *  Thread safe.
+ */
+class IEC61850DiscoveryCoordinator
+{
+    public :
+        using Ticket = uint64_t;
+
+        /** \param maxConcurrentDiscoveries 0: no limit */
+        explicit IEC61850DiscoveryCoordinator(unsigned int maxConcurrentDiscoveries);
+
+        ~IEC61850DiscoveryCoordinator() = default;
+
+        IEC61850DiscoveryCoordinator(const IEC61850DiscoveryCoordinator &) = delete;
+        IEC61850DiscoveryCoordinator &operator = (const IEC61850DiscoveryCoordinator &) = delete;
+        IEC61850DiscoveryCoordinator(IEC61850DiscoveryCoordinator &&) = delete;
+        IEC61850DiscoveryCoordinator &operator = (IEC61850DiscoveryCoordinator &&) = delete;
+
+        /**
+         * \brief Queue a discovery request, for a client with 'pointCount' configured points
+         *
+         * \return the ticket to use with 'waitForSlot' and 'cancel'
+         */
+        Ticket enqueue(std::size_t pointCount);
+
+        /**
+         * \brief Wait until the ticket gets a discovery slot
+         *
+         * \return true when the slot is granted (then call 'release'), false
+         * on timeout or stop order: the ticket stays queued, unless cancelled.
+         */
+        bool waitForSlot(Ticket ticket,
+                         std::chrono::milliseconds timeout,
+                         const std::atomic<bool> &stopOrder);
+
+        /** \brief Give back a granted discovery slot */
+        void release();
+
+        /** \brief Remove a ticket that is still queued */
+        void cancel(Ticket ticket);
+
+        /** \brief Change the limit, the running discoveries are not interrupted */
+        void setMaxConcurrentDiscoveries(unsigned int maxConcurrentDiscoveries);
+
+    private:
+        bool isGrantable(const std::pair<std::size_t, Ticket> &request) const;
+
+        unsigned int m_maxConcurrentDiscoveries;
+        unsigned int m_runningDiscoveries = 0;
+        Ticket m_nextTicket = 0;
+
+        /** \brief waiting requests, ordered by (point count, ticket) */
+        std::set<std::pair<std::size_t, Ticket>> m_waitingRequests;
+        std::map<Ticket, std::size_t> m_pointCountByTicket;
+
+        std::mutex m_mutex;  /**< Protect all the members above */
+        std::condition_variable m_slotReleased;
+
+        // Section: see the class as a white box for unit tests
+        FRIEND_TEST(IEC61850DiscoveryCoordinatorTest, grantInPriorityOrder);
+        FRIEND_TEST(IEC61850DiscoveryCoordinatorTest, cancelWaitingTicket);
+        FRIEND_TEST(IEC61850ClientTest, waitForDiscoverySlot);
+};
+
+#endif  // INCLUDE_IEC61850_DISCOVERY_COORDINATOR_H_
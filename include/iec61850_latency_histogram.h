@@ -0,0 +1,71 @@
+#ifndef INCLUDE_IEC61850_LATENCY_HISTOGRAM_H_
+#define INCLUDE_IEC61850_LATENCY_HISTOGRAM_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstddef>
+#include <cstdint>
+
+/** \class LatencyHistogram
+ *  \brief Distribution of durations in log-linear buckets (HDR style)
+ *
+ *  Each power of 2 of microseconds is split in 8 buckets: a percentile is
+ *  known within 12.5 %, from 1 us to about 12 days, in a fixed size.
+ *
+ *  The counters are atomic: 'record' and 'merge' take no lock, and may run
+ *  in parallel with each other and with 'take'. A copy or a read taken
+ *  meanwhile may see a duration in some counters only.
+ */
+class LatencyHistogram
+{
+    public :
+        LatencyHistogram() = default;
+        ~LatencyHistogram() = default;
+
+        LatencyHistogram(const LatencyHistogram &other);
+        LatencyHistogram &operator = (const LatencyHistogram &other);
+
+        void record(std::chrono::microseconds duration);
+        void merge(const LatencyHistogram &other);
+
+        /** \brief Durations recorded until now, the histogram starts again empty */
+        LatencyHistogram take();
+
+        uint64_t getCount() const;
+        std::chrono::microseconds getMean() const;
+        std::chrono::microseconds getMax() const { return std::chrono::microseconds(m_maxInUs.load(std::memory_order_relaxed)); }
+
+        /**
+         * \brief Upper bound of the bucket of the percentile (capped by the max)
+         *
+         * \param percentile in [0, 100]
+         */
+        std::chrono::microseconds getPercentile(double percentile) const;
+
+    private:
+        static constexpr unsigned int SUB_BUCKET_BITS = 3;
+        static constexpr uint64_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+        static constexpr unsigned int MAX_VALUE_BITS = 40;
+        static constexpr std::size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+        static std::size_t getBucketIndex(uint64_t valueInUs);
+        static uint64_t getBucketUpperBound(std::size_t bucketIndex);
+
+        void updateMax(int64_t valueInUs);
+
+        /** (no separate total count: a duration is counted once it is in its bucket) */
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_counts{};
+        std::atomic<int64_t> m_totalInUs{0};
+        std::atomic<int64_t> m_maxInUs{0};
+};
+
+#endif  // INCLUDE_IEC61850_LATENCY_HISTOGRAM_H_
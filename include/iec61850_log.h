@@ -0,0 +1,163 @@
+#ifndef INCLUDE_IEC61850_LOG_H_
+#define INCLUDE_IEC61850_LOG_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <mutex>   // NOLINT
+#include <string>
+
+#include <logger.h>
+
+class IEC61850LogRateLimiter;
+
+/** \enum LogLevel
+ *  \brief Levels of the Fledge logger, in increasing severity
+ */
+enum class LogLevel {
+    DEBUG_LEVEL = 0,
+    INFO_LEVEL,
+    WARNING_LEVEL,
+    ERROR_LEVEL,
+    FATAL_LEVEL
+};
+
+/** \class IEC61850Log
+ *  \brief Cached minimum level of the Fledge logger
+ *
+ *  The Fledge logger filters the messages after their formatting: the
+ *  IEC61850_LOG_* macros check this cached level first, so that the
+ *  arguments of a disabled message are not even evaluated.
+ */
+class IEC61850Log
+{
+    public :
+        /** \brief Set the minimum level of the Fledge logger and of the cache ("debug", "info", ...) */
+        static void setMinLevel(const std::string &level);
+
+        static LogLevel parseLevel(const std::string &level);
+
+        static bool isEnabled(LogLevel level)
+        {
+            return static_cast<int>(level) >= s_minLevel.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * \brief Report the messages suppressed by the rate limiters whose period has ended
+         *
+         * Called periodically: the summary of a call site is written even if it logs no more message.
+         */
+        static void reportSuppressedMessages(std::chrono::steady_clock::time_point now);
+
+        /** \brief File name of a path (e.g. of __FILE__), without its directories */
+        static const char *getBasename(const char *path);
+
+    private :
+        friend class IEC61850LogRateLimiter;
+
+        static void registerRateLimiter(IEC61850LogRateLimiter *rateLimiter);
+        static void unregisterRateLimiter(IEC61850LogRateLimiter *rateLimiter);
+
+        static std::atomic<int> s_minLevel;
+};
+
+/** \class IEC61850LogRateLimiter
+ *  \brief Rate limit of the messages of one call site
+ *
+ *  At most 'burst' messages are logged per period; the others are counted
+ *  and reported, aggregated, once the period has ended: with the next
+ *  message of the call site or by 'IEC61850Log::reportSuppressedMessages'.
+ *  Thread safe.
+ */
+class IEC61850LogRateLimiter
+{
+    public :
+        static constexpr unsigned int DEFAULT_PERIOD_IN_MS = 60000;
+        static constexpr unsigned int DEFAULT_BURST = 5;
+
+        /**
+         * \param level level of the messages of the call site
+         * \param file, line call site, reported with the suppressed messages
+         */
+        IEC61850LogRateLimiter(LogLevel level,
+                               const char *file,
+                               int line,
+                               unsigned int periodInMs = DEFAULT_PERIOD_IN_MS,
+                               unsigned int burst = DEFAULT_BURST);
+        ~IEC61850LogRateLimiter();
+
+        IEC61850LogRateLimiter(const IEC61850LogRateLimiter &) = delete;
+        IEC61850LogRateLimiter &operator = (const IEC61850LogRateLimiter &) = delete;
+
+        /**
+         * \brief Take the right to log a message
+         *
+         * \param suppressedCount messages suppressed during the previous period,
+         *        to report before this one (0 if none)
+         * \return false if the message is suppressed
+         */
+        bool tryAcquire(std::chrono::steady_clock::time_point now, uint64_t &suppressedCount);
+
+        /** \brief Messages suppressed during a period ended at 'now', not reported yet (0 if none) */
+        uint64_t takeExpiredSuppressedCount(std::chrono::steady_clock::time_point now);
+
+        /** \brief Log "N similar messages suppressed", at the level of the call site */
+        void logSuppressed(uint64_t suppressedCount) const;
+
+    private :
+        LogLevel m_level;
+        const char *m_file;  /**< basename */
+        int m_line;
+
+        std::mutex m_mutex;
+        std::chrono::milliseconds m_period;
+        unsigned int m_burst;
+        std::chrono::steady_clock::time_point m_periodStart;
+        unsigned int m_loggedCount = 0;
+        uint64_t m_suppressedCount = 0;
+};
+
+#define IEC61850_LOG_AT(level, method, ...)                                                 \
+    do {                                                                                    \
+        if (IEC61850Log::isEnabled(level)) {                                                \
+            Logger::getLogger()->method(__VA_ARGS__);                                       \
+        }                                                                                   \
+    } while (0)
+
+#define IEC61850_LOG_DEBUG(...) IEC61850_LOG_AT(LogLevel::DEBUG_LEVEL, debug, __VA_ARGS__)
+#define IEC61850_LOG_INFO(...) IEC61850_LOG_AT(LogLevel::INFO_LEVEL, info, __VA_ARGS__)
+#define IEC61850_LOG_WARN(...) IEC61850_LOG_AT(LogLevel::WARNING_LEVEL, warn, __VA_ARGS__)
+#define IEC61850_LOG_ERROR(...) IEC61850_LOG_AT(LogLevel::ERROR_LEVEL, error, __VA_ARGS__)
+
+/** (one rate limiter per expansion of the macro, i.e. per call site) */
+#define IEC61850_LOG_RATE_LIMITED_AT(level, method, ...)                                    \
+    do {                                                                                    \
+        if (IEC61850Log::isEnabled(level)) {                                                \
+            static IEC61850LogRateLimiter iec61850RateLimiter(                              \
+                level, __FILE__, __LINE__);                                                 \
+            uint64_t iec61850SuppressedCount = 0;                                           \
+            bool iec61850IsLogged = iec61850RateLimiter.tryAcquire(                         \
+                std::chrono::steady_clock::now(), iec61850SuppressedCount);                 \
+            if (iec61850SuppressedCount > 0) {                                              \
+                iec61850RateLimiter.logSuppressed(iec61850SuppressedCount);                 \
+            }                                                                               \
+            if (iec61850IsLogged) {                                                         \
+                Logger::getLogger()->method(__VA_ARGS__);                                   \
+            }                                                                               \
+        }                                                                                   \
+    } while (0)
+
+#define IEC61850_LOG_RATE_LIMITED_WARN(...) \
+    IEC61850_LOG_RATE_LIMITED_AT(LogLevel::WARNING_LEVEL, warn, __VA_ARGS__)
+#define IEC61850_LOG_RATE_LIMITED_ERROR(...) \
+    IEC61850_LOG_RATE_LIMITED_AT(LogLevel::ERROR_LEVEL, error, __VA_ARGS__)
+
+#endif  // INCLUDE_IEC61850_LOG_H_
@@ -0,0 +1,69 @@
+#ifndef INCLUDE_IEC61850_NAME_TREE_CACHE_H_
+#define INCLUDE_IEC61850_NAME_TREE_CACHE_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <memory>
+#include <mutex>   // NOLINT
+#include <string>
+#include <unordered_map>
+
+// local library
+#include "./iec61850_client_config.h"
+
+// For white box unit tests
+#include <gtest/gtest_prod.h>
+
+/** \class IEC61850NameTreeCache
+ *  \brief Store once each MMS name subtree, shared by all the DO and all the clients
+ *
+ *  The DO of a same CDC have the same structure: their name subtrees are
+ *  identical and immutable, so they are shared. Only the root of a name
+ *  tree (named after the DO label) is specific to a DO.
+ *  An unused subtree is released with its last DO.
+ *  Thread safe.
+ */
+class IEC61850NameTreeCache
+{
+    public :
+        IEC61850NameTreeCache() = default;
+        ~IEC61850NameTreeCache() = default;
+
+        IEC61850NameTreeCache(const IEC61850NameTreeCache &) = delete;
+        IEC61850NameTreeCache &operator = (const IEC61850NameTreeCache &) = delete;
+        IEC61850NameTreeCache(IEC61850NameTreeCache &&) = delete;
+        IEC61850NameTreeCache &operator = (IEC61850NameTreeCache &&) = delete;
+
+        /** \brief Replace the children of a name tree by their shared instances */
+        void internChildren(MmsNameNode &nameTree);
+
+        /** \brief Get the shared instance of a name subtree */
+        std::shared_ptr<const MmsNameNode> intern(const std::shared_ptr<const MmsNameNode> &nameNode);
+
+        /** \brief Number of distinct subtrees in use */
+        std::size_t size();
+
+    private:
+        /** \brief Drop the entries of the released subtrees */
+        void purgeReleasedSubtrees();
+
+        /**
+         * Key: the name and the addresses of the (already shared) children,
+         * so 2 subtrees have the same key if they have the same content.
+         */
+        std::unordered_map<std::string, std::weak_ptr<const MmsNameNode>> m_subtrees;
+        std::size_t m_sizeAfterPurge = 0;
+
+        std::mutex m_mutex;  /**< Protect the members above */
+
+        // Section: see the class as a white box for unit tests
+        FRIEND_TEST(IEC61850NameTreeCacheTest, releaseUnusedSubtrees);
+};
+
+#endif  // INCLUDE_IEC61850_NAME_TREE_CACHE_H_
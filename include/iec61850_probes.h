@@ -0,0 +1,114 @@
+#ifndef INCLUDE_IEC61850_PROBES_H_
+#define INCLUDE_IEC61850_PROBES_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+/**
+ * USDT static tracepoints of the 'iec61850' provider, for perf and bpftrace.
+ *
+ * Built with the CMake option 'IEC61850_USDT_PROBES', ON by default when 'sys/sdt.h' is found.
+ * Each probe has a SDT semaphore, set by the tracer attached to it: while a
+ * probe is not traced, its arguments and its timer are not evaluated, it costs
+ * the test of its semaphore (and the 'nop' of the probe). Without the option,
+ * the probes and their timers are removed.
+ * See 'scripts/bpftrace/README.rst' for the probes and their arguments.
+ */
+
+#ifdef IEC61850_USDT_PROBES
+
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+#include <chrono>  // NOLINT
+#include <cstdint>
+
+/** \brief All the probes: 1 semaphore each, defined in iec61850_probes.cpp */
+#define IEC61850_PROBE_LIST(X) \
+    X(open_start)              \
+    X(open_done)               \
+    X(read_do_start)           \
+    X(read_do_done)            \
+    X(read_dataset_start)      \
+    X(read_dataset_done)       \
+    X(convert_start)           \
+    X(convert_done)            \
+    X(ingest_done)
+
+#define IEC61850_PROBE_DECLARE_SEMAPHORE(name) extern unsigned short iec61850_##name##_semaphore;
+IEC61850_PROBE_LIST(IEC61850_PROBE_DECLARE_SEMAPHORE)
+#undef IEC61850_PROBE_DECLARE_SEMAPHORE
+
+/** \brief Is a tracer attached to the probe */
+#define IEC61850_PROBE_ENABLED(name) \
+    __builtin_expect(iec61850_##name##_semaphore != 0, 0)
+
+#define IEC61850_PROBE1(name, arg1)                                             \
+    do {                                                                        \
+        if (IEC61850_PROBE_ENABLED(name)) {                                     \
+            DTRACE_PROBE1(iec61850, name, arg1);                                \
+        }                                                                       \
+    } while (0)
+
+#define IEC61850_PROBE2(name, arg1, arg2)                                       \
+    do {                                                                        \
+        if (IEC61850_PROBE_ENABLED(name)) {                                     \
+            DTRACE_PROBE2(iec61850, name, arg1, arg2);                          \
+        }                                                                       \
+    } while (0)
+
+#define IEC61850_PROBE3(name, arg1, arg2, arg3)                                 \
+    do {                                                                        \
+        if (IEC61850_PROBE_ENABLED(name)) {                                     \
+            DTRACE_PROBE3(iec61850, name, arg1, arg2, arg3);                    \
+        }                                                                       \
+    } while (0)
+
+#define IEC61850_PROBE4(name, arg1, arg2, arg3, arg4)                           \
+    do {                                                                        \
+        if (IEC61850_PROBE_ENABLED(name)) {                                     \
+            DTRACE_PROBE4(iec61850, name, arg1, arg2, arg3, arg4);              \
+        }                                                                       \
+    } while (0)
+
+#define IEC61850_PROBE5(name, arg1, arg2, arg3, arg4, arg5)                     \
+    do {                                                                        \
+        if (IEC61850_PROBE_ENABLED(name)) {                                     \
+            DTRACE_PROBE5(iec61850, name, arg1, arg2, arg3, arg4, arg5);        \
+        }                                                                       \
+    } while (0)
+
+/**
+ * \brief Start time of a probed operation, read only if 'doneProbe' is traced
+ *
+ * (a probe attached during the operation reports a duration of 0)
+ */
+#define IEC61850_PROBE_TIMER(timer, doneProbe) \
+    const auto timer = IEC61850_PROBE_ENABLED(doneProbe) ? std::chrono::steady_clock::now() \
+                                                         : std::chrono::steady_clock::time_point()
+
+/** \brief Duration of the probed operation so far, in microseconds (int64), to give to its done probe */
+#define IEC61850_PROBE_ELAPSED_US(timer) \
+    (((timer) == std::chrono::steady_clock::time_point()) ? int64_t(0) \
+        : static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>( \
+              std::chrono::steady_clock::now() - (timer)).count()))
+
+#else
+
+#define IEC61850_PROBE1(name, arg1) do { } while (0)
+#define IEC61850_PROBE2(name, arg1, arg2) do { } while (0)
+#define IEC61850_PROBE3(name, arg1, arg2, arg3) do { } while (0)
+#define IEC61850_PROBE4(name, arg1, arg2, arg3, arg4) do { } while (0)
+#define IEC61850_PROBE5(name, arg1, arg2, arg3, arg4, arg5) do { } while (0)
+
+#define IEC61850_PROBE_TIMER(timer, doneProbe) do { } while (0)
+#define IEC61850_PROBE_ELAPSED_US(timer) 0
+
+#endif  // IEC61850_USDT_PROBES
+
+#endif  // INCLUDE_IEC61850_PROBES_H_
@@ -0,0 +1,71 @@
+#ifndef INCLUDE_IEC61850_REDUNDANCY_GROUP_H_
+#define INCLUDE_IEC61850_REDUNDANCY_GROUP_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <functional>
+#include <map>
+#include <mutex>   // NOLINT
+#include <string>
+
+/** \class IEC61850RedundancyGroup
+ *  \brief Redundant connections with the same IED: one active, the others in hot standby
+ *
+ *  Only the active member reads and exports the data. The standby members stay
+ *  connected and discovered. When the active member reports a failure, the first
+ *  healthy standby member (in member key order) is promoted at once. There is no
+ *  failback: a recovered member stays in standby while the active one is healthy.
+ *  Thread safe.
+ */
+class IEC61850RedundancyGroup
+{
+    public :
+        /** \brief Called (outside of any lock) when a standby member becomes active */
+        using PromotionCallback = std::function<void()>;
+
+        IEC61850RedundancyGroup() = default;
+        ~IEC61850RedundancyGroup() = default;
+
+        IEC61850RedundancyGroup(const IEC61850RedundancyGroup &) = delete;
+        IEC61850RedundancyGroup &operator = (const IEC61850RedundancyGroup &) = delete;
+        IEC61850RedundancyGroup(IEC61850RedundancyGroup &&) = delete;
+        IEC61850RedundancyGroup &operator = (IEC61850RedundancyGroup &&) = delete;
+
+        /** \brief Add a member, unhealthy until its first report */
+        void addMember(const std::string &memberKey, PromotionCallback onPromotion);
+
+        /** \brief Remove a member: if it was active, a standby member is promoted */
+        void removeMember(const std::string &memberKey);
+
+        /**
+         * \brief Report the health of a member (connected, without error)
+         *
+         * \return true if the member is the active one
+         */
+        bool updateHealth(const std::string &memberKey, bool isHealthy);
+
+        /** \return the key of the active member, empty if none */
+        std::string getActiveMember() const;
+
+    private:
+        struct Member {
+            bool isHealthy = false;
+            PromotionCallback onPromotion;
+        };
+
+        /** \brief Promote the first healthy member, if any (lock held) */
+        PromotionCallback electActiveMember();
+
+        std::map<std::string, Member, std::less<>> m_members;
+        std::string m_activeMember;
+
+        mutable std::mutex m_mutex;  /**< Protect all the members above */
+};
+
+#endif  // INCLUDE_IEC61850_REDUNDANCY_GROUP_H_
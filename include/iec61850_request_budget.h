@@ -0,0 +1,103 @@
+#ifndef INCLUDE_IEC61850_REQUEST_BUDGET_H_
+#define INCLUDE_IEC61850_REQUEST_BUDGET_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <mutex>   // NOLINT
+
+// local library
+#include "./iec61850_client_config.h"
+
+/** \class IEC61850RequestBudget
+ *  \brief Request rate shared by several clients (a token bucket per limit)
+ *
+ *  Each read draws 1 request and its estimated size (in bytes) from the
+ *  budget, and waits while the budget is exhausted. The buckets hold 1 second
+ *  of budget: a burst is limited to the rate of 1 second.
+ *  A share of each bucket is reserved to the high priority reads: a normal
+ *  read waits while the bucket is below this share.
+ *  A request larger than a bucket is granted when the bucket is full, and
+ *  the next requests wait for the debt to be paid back.
+ *  Thread safe.
+ */
+class IEC61850RequestBudget
+{
+    public :
+        /** \struct Statistics
+         *  \brief Use of the budget since its creation
+         */
+        struct Statistics {
+            uint64_t grantedRequests = 0;
+            uint64_t grantedBytes = 0;
+            uint64_t delayedRequests = 0;  /**< requests which had to wait */
+            std::chrono::microseconds totalDelay{0};
+        };
+
+        explicit IEC61850RequestBudget(const RequestBudgetParameters &budgetParams);
+        ~IEC61850RequestBudget() = default;
+
+        IEC61850RequestBudget(const IEC61850RequestBudget &) = delete;
+        IEC61850RequestBudget &operator = (const IEC61850RequestBudget &) = delete;
+        IEC61850RequestBudget(IEC61850RequestBudget &&) = delete;
+        IEC61850RequestBudget &operator = (IEC61850RequestBudget &&) = delete;
+
+        /** \brief Change the rates (the waiting reads are reevaluated) */
+        void setParameters(const RequestBudgetParameters &budgetParams);
+
+        /**
+         * \brief Wait until the read fits in the budget, then draw it
+         *
+         * \param isCancelled checked at each wake up: see 'interrupt'
+         * \return false if cancelled before the read is granted
+         */
+        bool acquire(ReadPriority priority,
+                     std::size_t estimatedBytes,
+                     const std::atomic<bool> &isCancelled);
+
+        /** \brief Wake the waiting reads, to check their cancellation */
+        void interrupt();
+
+        Statistics getStatistics() const;
+
+        /**
+         * \brief Estimated size of the exchange of a read (request and response)
+         *
+         * \param referenceBytes size of the references in the request
+         */
+        static std::size_t estimateExchangeSize(std::size_t doCount, std::size_t referenceBytes);
+
+    private:
+        struct Bucket {
+            double rate = 0.0;  /**< 0: no limit */
+            double tokens = 0.0;
+
+            void refill(double elapsedSeconds);
+            bool canDraw(double cost, double reserveShare) const;
+            /** \brief Time to refill the bucket up to 'cost' + the reserved share */
+            double secondsUntilDrawable(double cost, double reserveShare) const;
+        };
+
+        /** \brief Refill the buckets up to now (lock held) */
+        void refill();
+
+        Bucket m_requestBucket;
+        Bucket m_byteBucket;
+        double m_highPriorityShare = 0.0;
+        std::chrono::steady_clock::time_point m_lastRefillTime;
+        Statistics m_statistics;
+
+        mutable std::mutex m_mutex;  /**< Protect all the members above */
+        std::condition_variable m_budgetChanged;
+};
+
+#endif  // INCLUDE_IEC61850_REQUEST_BUDGET_H_
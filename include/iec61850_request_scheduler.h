@@ -0,0 +1,105 @@
+#ifndef INCLUDE_IEC61850_REQUEST_SCHEDULER_H_
+#define INCLUDE_IEC61850_REQUEST_SCHEDULER_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <array>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cstddef>
+#include <cstdint>
+#include <mutex>   // NOLINT
+
+// local library
+#include "./iec61850_client_config.h"
+#include "./iec61850_latency_histogram.h"
+
+/** \struct ResponseTimeSummary
+ *  \brief Exchange times of the requests (without the wait for the connection)
+ */
+struct ResponseTimeSummary {
+    uint64_t responseCount = 0;
+    std::chrono::microseconds totalResponseTime{0};
+    std::chrono::microseconds maxResponseTime{0};
+    uint64_t timeoutCount = 0;  /**< requests without response in the request timeout */
+    LatencyHistogram histogram;
+
+    void record(std::chrono::microseconds responseTime);
+    void merge(const ResponseTimeSummary &other);
+    std::chrono::microseconds getMeanResponseTime() const;
+};
+
+/** \brief Latencies of the requests (waiting + exchange), 1 histogram per priority class, indexed by 'ReadPriority' */
+using RequestLatencies = std::array<LatencyHistogram, READ_PRIORITY_COUNT>;
+
+/** \class IEC61850RequestScheduler
+ *  \brief Order the requests sent on a connection, by priority
+ *
+ *  Only 1 request is exchanged at a time. When the connection is released, a
+ *  waiting high priority request goes first: its latency is bounded by the
+ *  exchange in progress (1 request or 1 batch of a split request), whatever the
+ *  number of waiting normal requests.
+ *  Thread safe.
+ */
+class IEC61850RequestScheduler
+{
+    public :
+        /** \class Turn
+         *  \brief Exclusive use of the connection, for the lifetime of the object
+         */
+        class Turn
+        {
+            public :
+                Turn(IEC61850RequestScheduler &scheduler, ReadPriority priority);
+                ~Turn();
+
+                Turn(const Turn &) = delete;
+                Turn &operator = (const Turn &) = delete;
+
+            private:
+                IEC61850RequestScheduler &m_scheduler;
+                ReadPriority m_priority;
+                std::chrono::steady_clock::time_point m_requestTime;
+                std::chrono::steady_clock::time_point m_exchangeStartTime;
+                bool m_isTraced = false;  /**< the exchange span is recorded */
+        };
+
+        IEC61850RequestScheduler() = default;
+        ~IEC61850RequestScheduler() = default;
+
+        IEC61850RequestScheduler(const IEC61850RequestScheduler &) = delete;
+        IEC61850RequestScheduler &operator = (const IEC61850RequestScheduler &) = delete;
+
+        RequestLatencies getLatencies() const;
+
+        /** \brief Count a request which timed out (its exchange time is counted by its turn) */
+        void recordTimeout();
+
+        /** \brief Exchange times since the last call */
+        ResponseTimeSummary takeResponseTimes();
+
+        /** \brief Log a summary of the latencies of each priority class */
+        static void logLatencies(const RequestLatencies &latencies);
+
+    private:
+        void acquire(ReadPriority priority);
+        void release(ReadPriority priority,
+                     std::chrono::microseconds latency,
+                     std::chrono::microseconds responseTime);
+
+        bool m_isBusy = false;
+        std::array<unsigned int, READ_PRIORITY_COUNT> m_waitingCount{};
+        RequestLatencies m_latencies;
+        ResponseTimeSummary m_responseTimes;
+
+        mutable std::mutex m_mutex;  /**< Protect all the members above */
+        std::condition_variable m_connectionReleased;
+};
+
+#endif  // INCLUDE_IEC61850_REQUEST_SCHEDULER_H_
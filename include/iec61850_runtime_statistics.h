@@ -0,0 +1,78 @@
+#ifndef INCLUDE_IEC61850_RUNTIME_STATISTICS_H_
+#define INCLUDE_IEC61850_RUNTIME_STATISTICS_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <mutex>   // NOLINT
+
+// local library
+#include "./iec61850_latency_histogram.h"
+#include "./iec61850_request_scheduler.h"
+
+/** \struct RuntimeStatisticsSnapshot
+ *  \brief Activity of a client over a publication interval
+ */
+struct RuntimeStatisticsSnapshot {
+    std::chrono::milliseconds interval{0};
+    uint64_t cycleCount = 0;
+    uint64_t readingCount = 0;  /**< readings given to Fledge */
+    double readingsPerSecond = 0.0;
+    uint64_t conversionErrorCount = 0;  /**< MMS values not converted into a reading */
+    uint64_t timeoutCount = 0;
+    uint64_t connectionLossCount = 0;
+    LatencyHistogram cycleDurations;
+    LatencyHistogram responseTimes;  /**< MMS round trips */
+    LatencyHistogram ingestLockWaits;
+};
+
+/** \class IEC61850RuntimeStatistics
+ *  \brief Hot path measurements of a client, taken by publication interval
+ *
+ *  The counters and the histogram buckets are atomic: recording takes no lock.
+ *  Thread safe.
+ */
+class IEC61850RuntimeStatistics
+{
+    public :
+        explicit IEC61850RuntimeStatistics(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+        ~IEC61850RuntimeStatistics() = default;
+
+        IEC61850RuntimeStatistics(const IEC61850RuntimeStatistics &) = delete;
+        IEC61850RuntimeStatistics &operator = (const IEC61850RuntimeStatistics &) = delete;
+
+        void recordCycle(std::chrono::microseconds duration);
+        void recordResponseTimes(const ResponseTimeSummary &responseTimes);
+        void recordReading(std::chrono::microseconds ingestLockWait);
+        void recordConversionError() { m_conversionErrorCount.fetch_add(1, std::memory_order_relaxed); }
+        void recordConnectionLoss() { m_connectionLossCount.fetch_add(1, std::memory_order_relaxed); }
+
+        /** \brief Has the interval lasted the publication period */
+        bool isPublicationDue(std::chrono::steady_clock::time_point now, std::chrono::milliseconds period) const;
+
+        /** \brief Statistics of the interval ending at 'now', a new interval starts */
+        RuntimeStatisticsSnapshot takeSnapshot(std::chrono::steady_clock::time_point now);
+
+    private:
+        std::atomic<uint64_t> m_cycleCount{0};
+        std::atomic<uint64_t> m_readingCount{0};
+        std::atomic<uint64_t> m_conversionErrorCount{0};
+        std::atomic<uint64_t> m_timeoutCount{0};
+        std::atomic<uint64_t> m_connectionLossCount{0};
+
+        LatencyHistogram m_cycleDurations;
+        LatencyHistogram m_responseTimes;
+        LatencyHistogram m_ingestLockWaits;
+        std::chrono::steady_clock::time_point m_intervalStartTime;
+        mutable std::mutex m_intervalMutex;  /**< Protect the interval start */
+};
+
+#endif  // INCLUDE_IEC61850_RUNTIME_STATISTICS_H_
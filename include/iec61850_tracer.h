@@ -0,0 +1,130 @@
+#ifndef INCLUDE_IEC61850_TRACER_H_
+#define INCLUDE_IEC61850_TRACER_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <string>
+#include <vector>
+
+/** \class IEC61850Tracer
+ *  \brief Span events of the hot paths, exported in the Chrome 'trace_event' format
+ *
+ *  Each thread records its events in its own ring buffer, without lock: only
+ *  the last 'BUFFER_CAPACITY' events of a thread are kept. The export reads
+ *  the buffers while they are written (each slot is a seqlock: an event
+ *  overwritten meanwhile is skipped).
+ *  Disabled, a span costs a relaxed atomic load.
+ *  The buffer of a finished thread is reused by the next new thread.
+ *  Thread safe.
+ */
+class IEC61850Tracer
+{
+    public :
+        static constexpr std::size_t BUFFER_CAPACITY = 4096;
+
+        /** \brief The tracer of the process */
+        static IEC61850Tracer &getTracer();
+
+        static bool isEnabled() { return s_isEnabled.load(std::memory_order_relaxed); }
+        void setEnabled(bool isEnabled);
+
+        /**
+         * \brief Record an event in the buffer of the calling thread
+         *
+         * \param name static string (only its address is stored)
+         * \param phase 'B' (begin of span) or 'E' (end of span)
+         */
+        void recordEvent(const char *name, char phase);
+
+        /** \brief JSON object of the Chrome 'trace_event' format (chrome://tracing, Perfetto) */
+        std::string exportChromeTrace() const;
+
+        /** \return false if the file cannot be written */
+        bool dumpChromeTrace(const std::string &filePath) const;
+
+        /** \brief Forget the recorded events (not while tracing) */
+        void clear();
+
+    private:
+        IEC61850Tracer();
+
+        /** \brief Slot of a ring buffer: 'sequence' is odd while the slot is written */
+        struct Event {
+            std::atomic<uint64_t> sequence{0};
+            std::atomic<const char *> name{nullptr};
+            std::atomic<int64_t> timestampInUs{0};
+            std::atomic<char> phase{0};
+        };
+
+        struct ThreadBuffer {
+            std::array<Event, BUFFER_CAPACITY> events;
+            std::atomic<uint64_t> writeCount{0};  /**< only written by the owner thread */
+            std::atomic<bool> isInUse{true};
+            uint32_t threadId = 0;
+        };
+
+        /** \brief Release the buffer of a thread when the thread finishes */
+        struct ThreadBufferHandle {
+            ThreadBuffer *buffer = nullptr;
+            ~ThreadBufferHandle();
+        };
+
+        ThreadBuffer *getThreadBuffer();
+
+        static std::atomic<bool> s_isEnabled;
+
+        std::chrono::steady_clock::time_point m_epoch;
+        std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+        mutable std::mutex m_buffersMutex;  /**< Protect the list of buffers, not their events */
+};
+
+/** \class IEC61850TraceSpan
+ *  \brief Span of the scope of the object, recorded if the tracer is enabled at its creation
+ */
+class IEC61850TraceSpan
+{
+    public :
+        /** \param name static string */
+        explicit IEC61850TraceSpan(const char *name)
+            : m_name(IEC61850Tracer::isEnabled() ? name : nullptr)
+        {
+            if (m_name) {
+                IEC61850Tracer::getTracer().recordEvent(m_name, 'B');
+            }
+        }
+
+        ~IEC61850TraceSpan()
+        {
+            end();
+        }
+
+        IEC61850TraceSpan(const IEC61850TraceSpan &) = delete;
+        IEC61850TraceSpan &operator = (const IEC61850TraceSpan &) = delete;
+
+        /** \brief End the span before the end of the scope */
+        void end()
+        {
+            if (m_name) {
+                IEC61850Tracer::getTracer().recordEvent(m_name, 'E');
+                m_name = nullptr;
+            }
+        }
+
+    private:
+        const char *m_name;
+};
+
+#endif  // INCLUDE_IEC61850_TRACER_H_
@@ -11,6 +11,7 @@
  */
 
 #include "./iec61850.h"
+#include "./iec61850_probes.h"
 
 IEC61850::IEC61850()
     : ClientGatewayInterface(),
@@ -28,6 +29,97 @@ void IEC61850::setConfig(const ConfigCategory &config) const
     }
 }
 
+void IEC61850::reconfigure(const ConfigCategory &config)
+{
+    /** Parse the new configuration first: on error, the current one stays in use, */
+    auto newConfig = std::make_shared<IEC61850ClientConfig>();
+    newConfig->importConfig(config);
+
+    /** (the tracing follows the configuration, started or not) */
+    applyTracing(newConfig->applicationParams.tracing);
+
+    if (! m_isStarted) {
+        m_config = newConfig;
+        return;
+    }
+
+    /** A change of the redundancy mode restarts all the clients */
+    if (newConfig->isRedundancyEnabled != m_config->isRedundancyEnabled) {
+        Logger::getLogger()->info("Reconfigure: redundancy mode changed, restart all the clients");
+        stop();
+        m_config = newConfig;
+        start();
+        return;
+    }
+
+    /** stop only the clients whose IED is removed or whose connection changed, */
+    std::vector<std::string> keysToStop;
+    std::vector<IEC61850Client *> clientsToStop;
+
+    for (const auto &client : m_clients) {
+        auto newServerIt = newConfig->serverConfigDict.find(client.first);
+        auto oldServerIt = m_config->serverConfigDict.find(client.first);
+
+        if ( (newServerIt == newConfig->serverConfigDict.end())
+                || (oldServerIt == m_config->serverConfigDict.end())
+                || (! IEC61850ClientConfig::isSameConnection(oldServerIt->second,
+                                                             newServerIt->second))
+                || (getRequestBudgetKey(*m_config, oldServerIt->second)
+                    != getRequestBudgetKey(*newConfig, newServerIt->second))) {
+            Logger::getLogger()->info("Reconfigure: stop the client %s", client.first.c_str());
+            keysToStop.push_back(client.first);
+            clientsToStop.push_back(client.second.get());
+        }
+    }
+
+    stopClients(clientsToStop);
+
+    for (const auto &key : keysToStop) {
+        m_clients.erase(key);
+    }
+
+    m_discoveryCoordinator->setMaxConcurrentDiscoveries(
+        newConfig->applicationParams.maxConcurrentDiscoveries);
+
+    /** The kept clients use the same budget as before, with the new rates */
+    for (auto budgetIt = m_requestBudgets.begin(); budgetIt != m_requestBudgets.end();) {
+        if (budgetIt->first.empty()) {
+            budgetIt->second->setParameters(newConfig->applicationParams.requestBudget);
+            ++budgetIt;
+            continue;
+        }
+
+        auto linkBudgetIt = newConfig->applicationParams.linkBudgets.find(budgetIt->first);
+
+        if (linkBudgetIt != newConfig->applicationParams.linkBudgets.end()) {
+            budgetIt->second->setParameters(linkBudgetIt->second);
+            ++budgetIt;
+        } else {
+            /** (its clients were stopped above) */
+            budgetIt = m_requestBudgets.erase(budgetIt);
+        }
+    }
+
+    /** give the new datapoints to the kept clients (with their connection), */
+    /** and start the clients of the added IEDs. */
+    for (const auto &serverConfig : newConfig->serverConfigDict) {
+        auto clientIt = m_clients.find(serverConfig.first);
+
+        if (clientIt != m_clients.end()) {
+            clientIt->second->updateConfiguration(newConfig);
+        } else {
+            Logger::getLogger()->info("Reconfigure: start the client %s", serverConfig.first.c_str());
+            startClient(newConfig, serverConfig.second);
+        }
+    }
+
+    /** (the previous configuration lives until all the clients have swapped) */
+    m_config = newConfig;
+
+    /** The phases are spread again over the new set of IEDs */
+    assignPollingPhases();
+}
+
 std::string IEC61850::getLogMinLevel() const
 {
     if (m_config) {
@@ -37,38 +129,253 @@ std::string IEC61850::getLogMinLevel() const
     }
 }
 
+std::map<std::string, ReconnectStatistics, std::less<>> IEC61850::getReconnectStatistics() const
+{
+    std::map<std::string, ReconnectStatistics, std::less<>> statistics;
+
+    for (const auto &client : m_clients) {
+        statistics[client.first] = client.second->getReconnectStatistics();
+    }
+
+    return statistics;
+}
+
+std::map<std::string, RequestLatencies, std::less<>> IEC61850::getRequestLatencies() const
+{
+    std::map<std::string, RequestLatencies, std::less<>> latencies;
+
+    for (const auto &client : m_clients) {
+        latencies[client.first] = client.second->getRequestLatencies();
+    }
+
+    return latencies;
+}
+
+std::map<std::string, PollingRateDistribution, std::less<>> IEC61850::getPollingRateDistributions() const
+{
+    std::map<std::string, PollingRateDistribution, std::less<>> distributions;
+
+    for (const auto &client : m_clients) {
+        distributions[client.first] = client.second->getPollingRateDistribution();
+    }
+
+    return distributions;
+}
+
+std::map<std::string, IEC61850RequestBudget::Statistics, std::less<>> IEC61850::getRequestBudgetStatistics() const
+{
+    std::map<std::string, IEC61850RequestBudget::Statistics, std::less<>> statistics;
+
+    for (const auto &budget : m_requestBudgets) {
+        statistics[budget.first] = budget.second->getStatistics();
+    }
+
+    return statistics;
+}
+
+std::string IEC61850::getRequestBudgetKey(const IEC61850ClientConfig &config,
+                                          const ServerConnectionParameters &serverConfig)
+{
+    if (config.applicationParams.linkBudgets.count(serverConfig.linkGroup) == 0) {
+        return "";
+    }
+
+    return serverConfig.linkGroup;
+}
+
+IEC61850RequestBudget *IEC61850::getRequestBudget(const IEC61850ClientConfig &config,
+                                                  const std::string &budgetKey)
+{
+    auto budgetIt = m_requestBudgets.find(budgetKey);
+
+    if (budgetIt == m_requestBudgets.end()) {
+        const RequestBudgetParameters &budgetParams = budgetKey.empty()
+                ? config.applicationParams.requestBudget
+                : config.applicationParams.linkBudgets.at(budgetKey);
+        budgetIt = m_requestBudgets.emplace(budgetKey,
+                                            std::make_unique<IEC61850RequestBudget>(budgetParams)).first;
+    }
+
+    return budgetIt->second.get();
+}
+
 void IEC61850::start()
 {
     Logger::getLogger()->info("Plugin started");
 
+    applyTracing(m_config->applicationParams.tracing);
+
+    /** The model discoveries of all the clients share a concurrency limit. */
+    m_discoveryCoordinator = std::make_unique<IEC61850DiscoveryCoordinator>(
+                                 m_config->applicationParams.maxConcurrentDiscoveries);
+
+    /** The DO structures are stored once, whatever the number of DO and clients. */
+    m_nameTreeCache = std::make_unique<IEC61850NameTreeCache>();
+
+    /** Redundant connections: one client is active, the others in hot standby */
+    if (m_config->isRedundancyEnabled) {
+        m_redundancyGroup = std::make_unique<IEC61850RedundancyGroup>();
+    }
+
     /** Create and start the IEC61850 clients. */
-    for (auto &serverConfig : m_config->serverConfigDict) {
-        std::string key = serverConfig.first;
-        m_clients[key] = std::make_unique<IEC61850Client>(this,
-                         serverConfig.second,
-                         m_config->exchangedData,
-                         m_config->selectedDOInExchangedDatasets,
-                         m_config->applicationParams);
-        m_clients[key]->start();
+    for (const auto &serverConfig : m_config->serverConfigDict) {
+        startClient(m_config, serverConfig.second);
     }
+
+    /** (the first cycle follows the connection, the next ones follow the phase) */
+    assignPollingPhases();
+    m_isStarted = true;
+}
+
+void IEC61850::assignPollingPhases()
+{
+    /** (the period of the new configuration: a kept client swaps it at its next cycle) */
+    std::chrono::milliseconds period = IEC61850Client::getPollingPeriod(m_config->applicationParams);
+    std::size_t rank = 0;
+
+    for (const auto &client : m_clients) {
+        double phaseRatio = static_cast<double>(rank) / static_cast<double>(m_clients.size());
+        client.second->setPollingPhase(phaseRatio);
+        std::chrono::milliseconds phase = IEC61850Client::computePollingPhase(period, phaseRatio);
+        Logger::getLogger()->info("IED %s: polling phase %lld ms",
+                                  client.first.c_str(),
+                                  static_cast<long long>(phase.count()));
+        rank++;
+    }
+}
+
+std::map<std::string, std::chrono::milliseconds, std::less<>> IEC61850::getPollingPhases() const
+{
+    std::map<std::string, std::chrono::milliseconds, std::less<>> phases;
+
+    for (const auto &client : m_clients) {
+        phases[client.first] = client.second->getPollingPhase();
+    }
+
+    return phases;
+}
+
+void IEC61850::applyTracing(const TracingParameters &tracingParams)
+{
+    IEC61850Tracer &tracer = IEC61850Tracer::getTracer();
+
+    if (tracingParams.isEnabled && (! IEC61850Tracer::isEnabled())) {
+        /** (a new trace: the events of the previous one are forgotten) */
+        tracer.clear();
+        tracer.setEnabled(true);
+        Logger::getLogger()->info("Tracing enabled, the trace will be written in %s",
+                                  tracingParams.filePath.c_str());
+    } else if ( (! tracingParams.isEnabled) && IEC61850Tracer::isEnabled()) {
+        tracer.setEnabled(false);
+        tracer.dumpChromeTrace(m_tracingParams.filePath);
+    }
+
+    m_tracingParams = tracingParams;
+}
+
+void IEC61850::startClient(const std::shared_ptr<IEC61850ClientConfig> &config,
+                           const ServerConnectionParameters &serverConfig)
+{
+    std::string key = IEC61850ClientConfig::buildKey(serverConfig);
+    std::string budgetKey = getRequestBudgetKey(*config, serverConfig);
+
+    if (budgetKey != serverConfig.linkGroup) {
+        Logger::getLogger()->warn("IED %s: no budget for the link group '%s', the global budget is used",
+                                  key.c_str(), serverConfig.linkGroup.c_str());
+    }
+
+    m_clients[key] = std::make_unique<IEC61850Client>(this,
+                     serverConfig,
+                     config->exchangedData,
+                     config->selectedDOInExchangedDatasets,
+                     config->applicationParams,
+                     m_discoveryCoordinator.get(),
+                     m_nameTreeCache.get(),
+                     m_redundancyGroup.get(),
+                     getRequestBudget(*config, budgetKey));
+    m_clients[key]->holdConfiguration(config);
+    m_clients[key]->start();
 }
 
 void IEC61850::stop()
 {
+    std::vector<IEC61850Client *> clients;
+
     for (const auto &client : m_clients) {
-        client.second->stop();
+        clients.push_back(client.second.get());
     }
 
+    stopClients(clients);
     m_clients.clear();
+    m_isStarted = false;
+
+    /** (the trace in progress is written, the tracing goes on with the next start) */
+    if (IEC61850Tracer::isEnabled()) {
+        IEC61850Tracer::getTracer().dumpChromeTrace(m_tracingParams.filePath);
+    }
+    m_discoveryCoordinator.reset();
+    m_nameTreeCache.reset();
+    m_redundancyGroup.reset();
+
+    for (const auto &budget : m_requestBudgets) {
+        IEC61850RequestBudget::Statistics statistics = budget.second->getStatistics();
+        Logger::getLogger()->info("Request budget '%s': %llu requests granted (%llu bytes), "
+                                  "%llu delayed for %lld ms in total",
+                                  budget.first.c_str(),
+                                  static_cast<unsigned long long>(statistics.grantedRequests),
+                                  static_cast<unsigned long long>(statistics.grantedBytes),
+                                  static_cast<unsigned long long>(statistics.delayedRequests),
+                                  static_cast<long long>(statistics.totalDelay.count() / 1000));
+    }
+
+    m_requestBudgets.clear();
+}
+
+void IEC61850::stopClients(const std::vector<IEC61850Client *> &clients)
+{
+    /** Interrupt the waits of all the clients first, */
+    for (auto *client : clients) {
+        client->requestStop();
+    }
+
+    /** then close the connections in parallel: the latency is the one of the slowest IED. */
+    std::vector<std::thread> stopThreads;
+    stopThreads.reserve(clients.size());
+
+    for (auto *client : clients) {
+        stopThreads.emplace_back(&IEC61850Client::stop, client);
+    }
+
+    for (auto &stopThread : stopThreads) {
+        stopThread.join();
+    }
 }
 
 void IEC61850::ingest(std::vector<Datapoint *> &points,
                       const std::string &readingAssetName)
 {
+    std::chrono::microseconds lockWait(0);
+    ingest(points, readingAssetName, lockWait);
+}
+
+void IEC61850::ingest(std::vector<Datapoint *> &points,
+                      const std::string &readingAssetName,
+                      std::chrono::microseconds &lockWait)
+{
+    auto lockRequestTime = std::chrono::steady_clock::now();
+    IEC61850TraceSpan lockSpan("ingest_lock_wait");
     std::unique_lock<std::mutex> ingestGuard(m_ingestMutex);
+    lockSpan.end();
+    lockWait = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()
+                                                                     - lockRequestTime);
+    IEC61850TraceSpan callbackSpan("ingest_callback");
+    IEC61850_PROBE_TIMER(callbackTimer, ingest_done);
 
     if (m_ingest_callback) {
         /** Send the received/read data to Fledge, via the Callback function. */
         (*m_ingest_callback)(m_data, Reading(readingAssetName, points));
     }
+
+    IEC61850_PROBE4(ingest_done, readingAssetName.c_str(), points.size(),
+                    static_cast<int64_t>(lockWait.count()), IEC61850_PROBE_ELAPSED_US(callbackTimer));
 }
@@ -0,0 +1,166 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./iec61850_adaptive_polling.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <logger.h>
+
+bool IEC61850AdaptivePolling::isDue(const std::string &unitKey,
+                                    const PollingPeriodBounds &bounds,
+                                    std::chrono::steady_clock::time_point now,
+                                    std::chrono::milliseconds tolerance)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto unitIt = m_units.find(unitKey);
+
+    /** A new unit is read at once, at its shortest period */
+    if (unitIt == m_units.end()) {
+        UnitState &newUnit = m_units[unitKey];
+        newUnit.bounds = bounds;
+        newUnit.period = std::chrono::milliseconds(bounds.minPeriodInMs);
+        newUnit.nextReadTime = now;
+        return true;
+    }
+
+    UnitState &unit = unitIt->second;
+
+    /** (the bounds of a unit follow the configuration) */
+    if ( (unit.bounds.minPeriodInMs != bounds.minPeriodInMs)
+            || (unit.bounds.maxPeriodInMs != bounds.maxPeriodInMs)) {
+        unit.bounds = bounds;
+        unit.period = std::min(std::max(unit.period, std::chrono::milliseconds(bounds.minPeriodInMs)),
+                               std::chrono::milliseconds(bounds.maxPeriodInMs));
+    }
+
+    return (unit.nextReadTime <= now + tolerance);
+}
+
+void IEC61850AdaptivePolling::recordRead(const std::string &unitKey,
+                                         std::size_t fingerprint,
+                                         std::chrono::steady_clock::time_point readTime)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto unitIt = m_units.find(unitKey);
+
+    if (unitIt == m_units.end()) {
+        return;
+    }
+
+    UnitState &unit = unitIt->second;
+    std::chrono::milliseconds minPeriod(unit.bounds.minPeriodInMs);
+    std::chrono::milliseconds maxPeriod(unit.bounds.maxPeriodInMs);
+
+    if (unit.isRead) {
+        if (fingerprint != unit.fingerprint) {
+            unit.period = std::max(minPeriod, unit.period / 2);
+        } else {
+            /** (+1 ms: a very short period grows too) */
+            unit.period = std::min(maxPeriod,
+                                   std::max(unit.period + std::chrono::milliseconds(1), unit.period * 3 / 2));
+        }
+    }
+
+    unit.fingerprint = fingerprint;
+    unit.isRead = true;
+    unit.nextReadTime = readTime + unit.period;
+}
+
+void IEC61850AdaptivePolling::clear()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_units.clear();
+}
+
+PollingRateDistribution IEC61850AdaptivePolling::getDistribution() const
+{
+    PollingRateDistribution distribution;
+    std::vector<std::chrono::milliseconds> periods;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        periods.reserve(m_units.size());
+
+        for (const auto &unit : m_units) {
+            const UnitState &state = unit.second;
+            periods.push_back(state.period);
+
+            if (state.period <= std::chrono::milliseconds(state.bounds.minPeriodInMs)) {
+                distribution.unitsAtMinPeriod++;
+            }
+
+            if (state.period >= std::chrono::milliseconds(state.bounds.maxPeriodInMs)) {
+                distribution.unitsAtMaxPeriod++;
+            }
+        }
+    }
+
+    if (periods.empty()) {
+        return distribution;
+    }
+
+    std::sort(periods.begin(), periods.end());
+    distribution.unitCount = periods.size();
+    distribution.shortestPeriod = periods.front();
+    distribution.medianPeriod = periods[periods.size() / 2];
+    distribution.longestPeriod = periods.back();
+
+    for (const auto &period : periods) {
+        distribution.readsPerSecond += 1000.0 / static_cast<double>(std::max<int64_t>(1, period.count()));
+    }
+
+    return distribution;
+}
+
+void IEC61850AdaptivePolling::logDistribution(const std::string &clientId,
+                                              const PollingRateDistribution &distribution)
+{
+    if (distribution.unitCount == 0) {
+        return;
+    }
+
+    Logger::getLogger()->info("IED %s: adaptive polling of %u units: periods from %lld to %lld ms "
+                              "(median %lld ms), %u at the min period, %u at the max period, %.1f reads/s",
+                              clientId.c_str(),
+                              static_cast<unsigned int>(distribution.unitCount),
+                              static_cast<long long>(distribution.shortestPeriod.count()),
+                              static_cast<long long>(distribution.longestPeriod.count()),
+                              static_cast<long long>(distribution.medianPeriod.count()),
+                              static_cast<unsigned int>(distribution.unitsAtMinPeriod),
+                              static_cast<unsigned int>(distribution.unitsAtMaxPeriod),
+                              distribution.readsPerSecond);
+}
+
+PollingPeriodBounds IEC61850AdaptivePolling::resolveBounds(const PollingPeriodBounds &unitBounds,
+                                                           const PollingPeriodBounds &defaultBounds)
+{
+    PollingPeriodBounds bounds;
+    bounds.minPeriodInMs = (unitBounds.minPeriodInMs > 0) ? unitBounds.minPeriodInMs : defaultBounds.minPeriodInMs;
+    bounds.maxPeriodInMs = (unitBounds.maxPeriodInMs > 0) ? unitBounds.maxPeriodInMs : defaultBounds.maxPeriodInMs;
+    bounds.maxPeriodInMs = std::max(bounds.minPeriodInMs, bounds.maxPeriodInMs);
+
+    return bounds;
+}
+
+PollingPeriodBounds IEC61850AdaptivePolling::tightestBounds(const PollingPeriodBounds &firstBounds,
+                                                            const PollingPeriodBounds &secondBounds)
+{
+    PollingPeriodBounds bounds;
+    bounds.minPeriodInMs = std::min(firstBounds.minPeriodInMs, secondBounds.minPeriodInMs);
+    bounds.maxPeriodInMs = std::max(bounds.minPeriodInMs,
+                                    std::min(firstBounds.maxPeriodInMs, secondBounds.maxPeriodInMs));
+
+    return bounds;
+}
+
+std::size_t IEC61850AdaptivePolling::combineFingerprints(std::size_t seed, std::size_t fingerprint)
+{
+    return seed ^ (fingerprint + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
@@ -14,7 +14,15 @@
 #include "./iec61850_client_config.h"
 
 // C++ headers
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 // libiec61850 headers
@@ -23,10 +31,22 @@
 // local library
 #include "./iec61850.h"
 #include "./iec61850_client_connection.h"
+#include "./iec61850_client_connection_pool.h"
+#include "./iec61850_log.h"
+#include "./iec61850_probes.h"
+#include "./iec61850_tracer.h"
 #include "./wrapped_mms.h"
 
-constexpr const uint32_t RECONNECTION_FREQUENCY_IN_HERTZ = 1;
-constexpr const uint32_t SECOND_IN_MILLISEC = 1000;
+/** Default connect timeout of libiec61850, when not configured */
+constexpr const uint32_t DEFAULT_CONNECT_TIMEOUT_IN_MS = 10000;
+/** Period of the checks of an asynchronous connection */
+constexpr const std::chrono::milliseconds CONNECTION_STATE_CHECK_PERIOD(50);
+
+/** Prefix of the association specific datasets created in DO reading mode */
+const char *const DYNAMIC_DATASET_PREFIX = "@FledgeDO";
+
+/** Prefix of the association specific datasets trimmed to the selected members */
+const char *const TRIMMED_DATASET_PREFIX = "@FledgeDS";
 
 /** Name mapping between the DO attributes and the Reading attributes */
 const std::map<std::string, std::string, std::less<>> DO_READING_MAPPING = {
@@ -42,21 +62,35 @@ IEC61850Client::IEC61850Client(IEC61850 *iec61850,
                                const ServerConnectionParameters &connectionParam,
                                const ExchangedData &exchangedData,
                                const ExchangedDatasets &selectedDOInExchangedDatasets,
-                               const ApplicationParameters &applicationParams)
-    : m_connectionParam(connectionParam),
-      m_applicationParams(applicationParams),
-      m_selectedDOInExchangedDatasets(selectedDOInExchangedDatasets),
-      m_iec61850(iec61850)
+                               const ApplicationParameters &applicationParams,
+                               IEC61850DiscoveryCoordinator *discoveryCoordinator,
+                               IEC61850NameTreeCache *nameTreeCache,
+                               IEC61850RedundancyGroup *redundancyGroup,
+                               IEC61850RequestBudget *requestBudget)
+    : m_connectionParam(&connectionParam),
+      m_applicationParams(&applicationParams),
+      m_selectedDOInExchangedDatasets(&selectedDOInExchangedDatasets),
+      m_exchangedData(&exchangedData),
+      m_nameTreeCache(nameTreeCache),
+      m_iec61850(iec61850),
+      m_discoveryCoordinator(discoveryCoordinator),
+      m_redundancyGroup(redundancyGroup),
+      m_requestBudget(requestBudget)
 {
-    m_clientId = IEC61850ClientConfig::buildKey(m_connectionParam);
+    m_clientId = IEC61850ClientConfig::buildKey(*m_connectionParam);
     Logger::getLogger()->debug("IEC61850Client: constructor %s",
                                m_clientId.c_str());
 
-    // Make the local copy of 'exchangedData'
-    for (const auto &dpConfig : exchangedData) {
-        DatapointConfig newDpConfig = dpConfig;
-        m_localExchangedData.push_back(newDpConfig);
-    }
+    /** Each client has its own jitter sequence */
+    m_jitterGenerator.seed(std::random_device{}());
+
+    // No copy of 'exchangedData': only the name trees are specific to the connection
+    m_nameTrees.resize(m_exchangedData->size());
+
+    m_configuredPointCount = countConfiguredPoints();
+    m_pollingPeriodInMs = getPollingPeriod(*m_applicationParams).count();
+    m_congestionControl.setParameters(m_applicationParams->congestionControl,
+                                      m_connectionParam->associationCount);
 }
 
 IEC61850Client::~IEC61850Client()
@@ -66,14 +100,149 @@ IEC61850Client::~IEC61850Client()
     stop();  // ensure a correct shutdown, if 'stop' order was missing
 }
 
+std::size_t IEC61850Client::countConfiguredPoints() const
+{
+    /** (a dataset without selection counts as 1 point) */
+    std::size_t pointCount = m_exchangedData->size();
+
+    for (const auto &selectionEntry : *m_selectedDOInExchangedDatasets) {
+        pointCount += std::max<std::size_t>(1, selectionEntry.second.size());
+    }
+
+    return pointCount;
+}
+
+void IEC61850Client::holdConfiguration(const std::shared_ptr<const IEC61850ClientConfig> &config)
+{
+    m_config = config;
+}
+
+void IEC61850Client::updateConfiguration(const std::shared_ptr<const IEC61850ClientConfig> &newConfig)
+{
+    // Preconditions
+    if ( (! newConfig) || (newConfig->serverConfigDict.count(m_clientId) == 0)) {
+        Logger::getLogger()->error("IEC61850Client: no configuration for %s, update ignored",
+                                   m_clientId.c_str());
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(m_pendingConfigMutex);
+    m_pendingConfig = newConfig;
+}
+
+void IEC61850Client::applyPendingConfiguration()
+{
+    std::shared_ptr<const IEC61850ClientConfig> newConfig;
+
+    {
+        std::lock_guard<std::mutex> guard(m_pendingConfigMutex);
+        newConfig.swap(m_pendingConfig);
+    }
+
+    if (! newConfig) {
+        return;
+    }
+
+    /** Keep the name trees of the unchanged DO (same path and FC), */
+    std::unordered_map<std::string, std::shared_ptr<MmsNameNode>> nameTreeByDoPathWithFC;
+
+    for (std::size_t index = 0; index < m_nameTrees.size(); ++index) {
+        if (m_nameTrees[index]) {
+            nameTreeByDoPathWithFC.emplace(buildDoPathWithFC((*m_exchangedData)[index]),
+                                           m_nameTrees[index]);
+        }
+    }
+
+    std::vector<std::shared_ptr<MmsNameNode>> newNameTrees(newConfig->exchangedData.size());
+    std::size_t keptNameTreeCount = 0;
+
+    for (std::size_t index = 0; index < newNameTrees.size(); ++index) {
+        const DatapointConfig &dpConfig = newConfig->exchangedData[index];
+        auto treeIt = nameTreeByDoPathWithFC.find(buildDoPathWithFC(dpConfig));
+
+        if (treeIt != nameTreeByDoPathWithFC.end()) {
+            /** (only the root is renamed, the subtrees are shared) */
+            newNameTrees[index] = std::make_shared<MmsNameNode>(*(treeIt->second));
+            newNameTrees[index]->mmsName = dpConfig.label;
+            keptNameTreeCount++;
+        }
+    }
+
+    /** then swap the whole configuration, */
+    m_connectionParam = &(newConfig->serverConfigDict.at(m_clientId));
+    m_applicationParams = &(newConfig->applicationParams);
+    m_exchangedData = &(newConfig->exchangedData);
+    m_selectedDOInExchangedDatasets = &(newConfig->selectedDOInExchangedDatasets);
+    m_nameTrees.swap(newNameTrees);
+    m_config = newConfig;
+
+    m_configuredPointCount = countConfiguredPoints();
+    m_pollingPeriodInMs = getPollingPeriod(*m_applicationParams).count();
+
+    /** (the adaptive periods start again from the new bounds) */
+    IEC61850AdaptivePolling::logDistribution(m_clientId, m_adaptivePolling.getDistribution());
+    m_adaptivePolling.clear();
+    m_congestionControl.setParameters(m_applicationParams->congestionControl,
+                                      m_connectionParam->associationCount);
+
+    /** and discover again the datasets. */
+    restartDiscovery();
+
+    Logger::getLogger()->info("IEC61850Client: new configuration applied, %u/%u name trees kept (%s)",
+                              static_cast<unsigned int>(keptNameTreeCount),
+                              static_cast<unsigned int>(m_nameTrees.size()),
+                              m_clientId.c_str());
+}
+
 void IEC61850Client::start()
 {
+    /** A promoted standby client reads at once, without waiting for its polling period */
+    if (m_redundancyGroup) {
+        m_redundancyGroup->addMember(m_clientId, [this] { wake(); });
+    }
+
     m_backgroundLaunchThread = std::thread(&IEC61850Client::launch, this);
 }
 
+void IEC61850Client::requestStop()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_stopMutex);
+        m_stopOrder = true;
+    }
+
+    m_stopRequested.notify_all();
+
+    /** (a read waiting for the budget is skipped) */
+    if (m_requestBudget) {
+        m_requestBudget->interrupt();
+    }
+}
+
+bool IEC61850Client::waitForStopOrder(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> guard(m_stopMutex);
+
+    m_stopRequested.wait_for(guard, timeout, [this] { return m_stopOrder || m_isWakeRequested; });
+    m_isWakeRequested = false;
+
+    return m_stopOrder;
+}
+
+void IEC61850Client::wake()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_stopMutex);
+        m_isWakeRequested = true;
+    }
+
+    m_stopRequested.notify_all();
+}
+
 void IEC61850Client::stop()
 {
-    m_stopOrder = true;
+    /** Wake the pending waits, then join the threads */
+    requestStop();
 
     if (m_backgroundLaunchThread.joinable()) {
         m_backgroundLaunchThread.join();
@@ -81,12 +250,29 @@ void IEC61850Client::stop()
 
     // Stop the MMS reading thread
     stopMmsReading();
+
+    /** (a standby client takes over, if this one was active) */
+    if (m_redundancyGroup) {
+        m_redundancyGroup->removeMember(m_clientId);
+    }
+
+    if (m_discoveryCoordinator && m_isDiscoveryQueued) {
+        m_discoveryCoordinator->cancel(m_discoveryTicket);
+        m_isDiscoveryQueued = false;
+    }
+
     destroyConnection();
 }
 
 void IEC61850Client::launch()
 {
     initializeConnection();
+
+    /** (stopped before being connected: there may be no connection to read) */
+    if (m_stopOrder) {
+        return;
+    }
+
     /** Make subscriptions */
     // TODO
     /** Start application loop */
@@ -95,24 +281,128 @@ void IEC61850Client::launch()
 
 void IEC61850Client::initializeConnection()
 {
-    do {
+    /** (no new connection once the stop is ordered: the client is torn down) */
+    while (! m_stopOrder) {
         Logger::getLogger()->debug("IEC61850Client: init connection (%s)",
                                    m_clientId.c_str());
         destroyConnection();
+        m_connectStartTime = std::chrono::steady_clock::now();
         createConnection();
+        waitForConnectionResult();
 
-        if (! m_connection->isConnected()) {
-            Logger::getLogger()->warn("IEC61850Client: failed to connect with %s",
-                                      m_clientId.c_str());
-        } else {
-            buildConfigurationNameTrees();
+        if (m_connection->isConnected()) {
+            recordConnectionSuccess();
+            /** The model is discovered by the reading loop, step by step */
+            resetDiscovery();
+            return;
+        }
+
+        /** Wait before the next attempt (interrupted by the stop order) */
+        std::chrono::milliseconds reconnectDelay = recordConnectionFailure();
+        Logger::getLogger()->warn("IEC61850Client: failed to connect with %s, next attempt in %u ms",
+                                  m_clientId.c_str(),
+                                  static_cast<unsigned int>(reconnectDelay.count()));
+        waitForStopOrder(reconnectDelay);
+    }
+}
+
+void IEC61850Client::waitForConnectionResult()
+{
+    /** The connection gives up after its own timeout, this one is a safety net */
+    unsigned int connectTimeoutInMs = m_connectionParam->connectTimeoutInMs;
+    if (connectTimeoutInMs == 0) {
+        connectTimeoutInMs = DEFAULT_CONNECT_TIMEOUT_IN_MS;
+    }
+
+    auto deadline = m_connectStartTime + 2 * std::chrono::milliseconds(connectTimeoutInMs);
+
+    while ( (! m_stopOrder) && m_connection->isConnecting()
+            && (std::chrono::steady_clock::now() < deadline)) {
+        waitForStopOrder(CONNECTION_STATE_CHECK_PERIOD);
+    }
+}
+
+std::chrono::milliseconds IEC61850Client::recordConnectionFailure()
+{
+    std::lock_guard<std::mutex> guard(m_reconnectStatisticsMutex);
+    m_reconnectStatistics.connectAttempts++;
+    m_reconnectStatistics.connectFailures++;
+    m_reconnectStatistics.consecutiveFailures++;
+    m_reconnectStatistics.lastConnectDuration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_connectStartTime);
+
+    std::uniform_real_distribution<double> jitterDistribution(0.0, 1.0);
+    m_reconnectStatistics.lastReconnectDelay =
+        computeReconnectDelay(m_reconnectStatistics.consecutiveFailures,
+                              *m_connectionParam,
+                              jitterDistribution(m_jitterGenerator));
+
+    return m_reconnectStatistics.lastReconnectDelay;
+}
+
+void IEC61850Client::recordConnectionSuccess()
+{
+    std::lock_guard<std::mutex> guard(m_reconnectStatisticsMutex);
+    m_reconnectStatistics.connectAttempts++;
+    m_reconnectStatistics.lastConnectDuration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_connectStartTime);
+
+    Logger::getLogger()->info("IEC61850Client: connected with %s in %u ms, after %u failed attempts (%u in total)",
+                              m_clientId.c_str(),
+                              static_cast<unsigned int>(m_reconnectStatistics.lastConnectDuration.count()),
+                              m_reconnectStatistics.consecutiveFailures,
+                              static_cast<unsigned int>(m_reconnectStatistics.connectFailures));
+    m_reconnectStatistics.consecutiveFailures = 0;
+}
+
+bool IEC61850Client::isActiveInRedundancyGroup(bool isHealthy)
+{
+    if (! m_redundancyGroup) {
+        return true;
+    }
+
+    return m_redundancyGroup->updateHealth(m_clientId, isHealthy);
+}
+
+ReconnectStatistics IEC61850Client::getReconnectStatistics() const
+{
+    std::lock_guard<std::mutex> guard(m_reconnectStatisticsMutex);
+    return m_reconnectStatistics;
+}
+
+RequestLatencies IEC61850Client::getRequestLatencies() const
+{
+    std::lock_guard<std::mutex> guard(m_requestLatenciesMutex);
+    RequestLatencies latencies = m_pastRequestLatencies;
+
+    for (std::size_t priority = 0; priority < READ_PRIORITY_COUNT; ++priority) {
+        latencies[priority].merge(m_currentRequestLatencies[priority]);
+    }
+
+    return latencies;
+}
+
+std::chrono::milliseconds IEC61850Client::computeReconnectDelay(unsigned int consecutiveFailures,
+                                                               const ServerConnectionParameters &connParam,
+                                                               double jitterRatio)
+{
+    /** Double the minimum delay for each failure, up to the maximum, */
+    uint64_t delayInMs = std::max(1u, connParam.reconnectMinDelayInMs);
+
+    for (unsigned int failure = 1; failure < consecutiveFailures; ++failure) {
+        if (delayInMs >= connParam.reconnectMaxDelayInMs) {
+            break;
         }
 
-        // Wait connection establishment
-        std::chrono::milliseconds timespan(SECOND_IN_MILLISEC / RECONNECTION_FREQUENCY_IN_HERTZ);
-        std::this_thread::sleep_for(timespan);
-    } while ( (! m_stopOrder) &&
-              (! m_connection->isConnected()));
+        delayInMs *= 2;
+    }
+
+    delayInMs = std::min<uint64_t>(delayInMs, std::max(1u, connParam.reconnectMaxDelayInMs));
+
+    /** then draw it in [delay/2, delay]. */
+    jitterRatio = std::min(1.0, std::max(0.0, jitterRatio));
+
+    return std::chrono::milliseconds(static_cast<uint64_t>(delayInMs * (0.5 + jitterRatio / 2)));
 }
 
 void IEC61850Client::createConnection()
@@ -126,7 +416,17 @@ void IEC61850Client::createConnection()
 
     Logger::getLogger()->info("IEC61850Client: create connection with %s",
                               m_clientId.c_str());
-    m_connection = std::make_unique<IEC61850ClientConnection>(m_connectionParam);
+    /** (asynchronous: the connection is established by 'waitForConnectionResult') */
+    /** A lost connection wakes the reading loop, to reconnect at once */
+    if (m_connectionParam->associationCount > 1) {
+        m_connection = std::make_unique<IEC61850ClientConnectionPool>(*m_connectionParam,
+                                                                      true,
+                                                                      [this] { wake(); });
+    } else {
+        m_connection = std::make_unique<IEC61850ClientConnection>(*m_connectionParam,
+                                                                  true,
+                                                                  [this] { wake(); });
+    }
 }
 
 void IEC61850Client::destroyConnection()
@@ -139,6 +439,22 @@ void IEC61850Client::destroyConnection()
 
     Logger::getLogger()->debug("IEC61850Client: destroy connection (%s)",
                                m_clientId.c_str());
+
+    /** The request latencies are kept for the whole life of the client */
+    {
+        RequestLatencies connectionLatencies = m_connection->getRequestLatencies();
+        IEC61850RequestScheduler::logLatencies(connectionLatencies);
+
+        std::lock_guard<std::mutex> guard(m_requestLatenciesMutex);
+        for (std::size_t priority = 0; priority < READ_PRIORITY_COUNT; ++priority) {
+            m_pastRequestLatencies[priority].merge(connectionLatencies[priority]);
+        }
+
+        m_currentRequestLatencies = RequestLatencies();
+    }
+
+    IEC61850AdaptivePolling::logDistribution(m_clientId, m_adaptivePolling.getDistribution());
+
     m_connection.reset(nullptr);
 }
 
@@ -184,22 +500,36 @@ void IEC61850Client::sendData(Datapoint *datapoint)
 
     std::vector<Datapoint *> points(0);
     points.push_back(datapoint);
-    m_iec61850->ingest(points, datapoint->getName());
+    std::chrono::microseconds ingestLockWait(0);
+    m_iec61850->ingest(points, datapoint->getName(), ingestLockWait);
+    m_runtimeStatistics.recordReading(ingestLockWait);
 }
 
 Datapoint *IEC61850Client::convertMmsToDatapoint(const MmsValue *mmsValue,
                                                  const DatapointConfig &datapointConfig)
+{
+    return convertMmsToDatapoint(mmsValue, datapointConfig, datapointConfig.mmsNameTree.get());
+}
+
+Datapoint *IEC61850Client::convertMmsToDatapoint(const MmsValue *mmsValue,
+                                                 const DatapointConfig &datapointConfig,
+                                                 const MmsNameNode *mmsNameTree)
 {
     // Precondition
     if (nullptr == mmsValue) {
         return nullptr;
     }
 
+    IEC61850_PROBE_TIMER(convertTimer, convert_done);
+    IEC61850_PROBE2(convert_start, datapointConfig.label.c_str(), datapointConfig.dataPath.c_str());
+
     Datapoint *datapoint = buildDatapointFromMms(mmsValue,
-                                                 datapointConfig.mmsNameTree.get(),
+                                                 mmsNameTree,
                                                  datapointConfig.dataPath);
 
     insertTypeInDatapoint(datapoint, datapointConfig.datapointType);
+    IEC61850_PROBE3(convert_done, datapointConfig.label.c_str(), datapointConfig.dataPath.c_str(),
+                    IEC61850_PROBE_ELAPSED_US(convertTimer));
 
     return datapoint;
 }
@@ -312,9 +642,9 @@ Datapoint *IEC61850Client::buildDatapointFromMms(const MmsValue *mmsValue,
         }
 
         case MMS_DATA_ACCESS_ERROR:
-            Logger::getLogger()->error("MMS access error (num %d), failed to access to: %s",
-                                       MmsValue_getDataAccessError(mmsValue),
-                                       dataPath.c_str());
+            IEC61850_LOG_RATE_LIMITED_ERROR("MMS access error (num %d), failed to access to: %s",
+                                            MmsValue_getDataAccessError(mmsValue),
+                                            dataPath.c_str());
             break;
 
         default :
@@ -324,11 +654,11 @@ Datapoint *IEC61850Client::buildDatapointFromMms(const MmsValue *mmsValue,
 
     if (datapoint) {
         // Rename the datapoint i.e. the Reading attributes
-        if (DO_READING_MAPPING.find(datapoint->getName()) != DO_READING_MAPPING.end()) {
-            Logger::getLogger()->debug("Datapoint creation: name mapping %s -> %s",
-                        datapoint->getName().c_str(),
-                        DO_READING_MAPPING.at(datapoint->getName()).c_str());
-            datapoint->setName(DO_READING_MAPPING.at(datapoint->getName()));
+        auto mappingIt = DO_READING_MAPPING.find(datapoint->getName());
+        if (mappingIt != DO_READING_MAPPING.end()) {
+            IEC61850_LOG_DEBUG("Datapoint creation: name mapping %s -> %s",
+                        mappingIt->first.c_str(), mappingIt->second.c_str());
+            datapoint->setName(mappingIt->second);
         }
     }
 
@@ -361,41 +691,131 @@ void IEC61850Client::readMmsLoop()
         Logger::getLogger()->warn("IEC61850Client: Connection object is null");
     }
 
-    unsigned int pollingPeriodInMs = m_applicationParams.readPollingPeriodInMs;
-    if (pollingPeriodInMs == 0) {
-        // Force to 1 second
-        pollingPeriodInMs = 1000;
-    }
-
     while (m_isMmsReadingActivated) {
+        bool isDiscoveryInProgress = false;
+        auto cycleStartTime = std::chrono::steady_clock::now();
+        IEC61850TraceSpan cycleSpan("poll_cycle");
+
         try {
-            readAndExportMms();
+            isDiscoveryInProgress = readAndExportMms();
         } catch (std::exception &e) {
-            Logger::getLogger()->error("%s", e.what());
+            IEC61850_LOG_RATE_LIMITED_ERROR("%s", e.what());
         } catch (...) {
-            Logger::getLogger()->error("Error: unknown exception caught");
+            IEC61850_LOG_RATE_LIMITED_ERROR("Error: unknown exception caught");
+        }
+
+        cycleSpan.end();
+
+        /** (a discovery step waits for the polling period: not a reading cycle) */
+        if (! isDiscoveryInProgress) {
+            m_runtimeStatistics.recordCycle(std::chrono::duration_cast<std::chrono::microseconds>(
+                                                std::chrono::steady_clock::now() - cycleStartTime));
+        }
+
+        publishRuntimeStatistics();
+
+        /** (the summary of a rate limited message is written also when the errors stop) */
+        IEC61850Log::reportSuppressedMessages(std::chrono::steady_clock::now());
+
+        /** During the discovery, the discovery step already took the polling period */
+        if (! isDiscoveryInProgress) {
+            /** (the phase of the client is kept in the slowed down period) */
+            std::chrono::milliseconds period = getEffectivePollingPeriod();
+            std::chrono::milliseconds phase(static_cast<int64_t>(period.count() * m_pollingPhaseRatio));
+            waitForStopOrder(computeDelayToNextCycle(std::chrono::steady_clock::now(), period, phase));
         }
-        std::chrono::milliseconds timespan(pollingPeriodInMs);
-        std::this_thread::sleep_for(timespan);
     }
 }
 
-void IEC61850Client::readAndExportMms()
+std::chrono::milliseconds IEC61850Client::getPollingPeriod() const
+{
+    return std::chrono::milliseconds(m_pollingPeriodInMs.load());
+}
+
+std::chrono::milliseconds IEC61850Client::getPollingPeriod(const ApplicationParameters &applicationParams)
+{
+    unsigned int pollingPeriodInMs = applicationParams.readPollingPeriodInMs;
+    if (pollingPeriodInMs == 0) {
+        // Force to 1 second
+        pollingPeriodInMs = 1000;
+    }
+
+    return std::chrono::milliseconds(pollingPeriodInMs);
+}
+
+std::chrono::milliseconds IEC61850Client::getEffectivePollingPeriod() const
+{
+    return m_congestionControl.scalePeriod(getPollingPeriod());
+}
+
+void IEC61850Client::setPollingPhase(double phaseRatio)
+{
+    m_pollingPhaseRatio = std::min(std::max(phaseRatio, 0.0), 1.0);
+}
+
+std::chrono::milliseconds IEC61850Client::getPollingPhase() const
+{
+    return computePollingPhase(getPollingPeriod(), m_pollingPhaseRatio);
+}
+
+std::chrono::milliseconds IEC61850Client::computePollingPhase(std::chrono::milliseconds period, double phaseRatio)
+{
+    return std::chrono::milliseconds(static_cast<int64_t>(period.count() * phaseRatio)) % period;
+}
+
+std::chrono::milliseconds IEC61850Client::computeDelayToNextCycle(std::chrono::steady_clock::time_point now,
+                                                                  std::chrono::milliseconds period,
+                                                                  std::chrono::milliseconds phase)
+{
+    auto timeInMs = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch());
+
+    /** Position in the current period, counted from the phase (in [0, period[) */
+    std::chrono::milliseconds position = (timeInMs - phase % period) % period;
+    if (position.count() < 0) {
+        position += period;
+    }
+
+    return period - position;
+}
+
+bool IEC61850Client::readAndExportMms()
 {
+    /** Between 2 reading cycles: apply the new configuration, if any */
+    applyPendingConfiguration();
+
     // Preconditions
     if (! m_connection->isConnected()) {
+        {
+            std::lock_guard<std::mutex> guard(m_reconnectStatisticsMutex);
+            m_reconnectStatistics.connectionLosses++;
+        }
+
+        Logger::getLogger()->warn("IEC61850Client: connection lost with %s",
+                                  m_clientId.c_str());
+        m_congestionControl.recordConnectionLoss();
+        m_runtimeStatistics.recordConnectionLoss();
+        isActiveInRedundancyGroup(false);
         initializeConnection();
-        return;
+        return false;
     }
 
-    if (! m_connection->isNoError()) {
-        m_connection->logError();
-        return;
+    /** Discover the model step by step, the DO already discovered are read meanwhile */
+    bool isDiscoveryInProgress = discoverConfigurationStep(getPollingPeriod());
+
+    /** In standby, the connection is only kept alive: the active client exports the data */
+    if (m_redundancyGroup && (! isActiveInRedundancyGroup(true))) {
+        if (! m_connection->keepAlive()) {
+            Logger::getLogger()->warn("IEC61850Client: standby connection %s does not answer",
+                                      m_clientId.c_str());
+            isActiveInRedundancyGroup(false);
+        }
+
+        return isDiscoveryInProgress;
     }
 
     /* read the desired MMS from server */
 
-    switch (m_applicationParams.readMode) {
+    switch (m_applicationParams->readMode) {
         case ReadMode::DATASET_READING:
             /** In case of DATASET_READING: */
             readAndExportAllDatasets();
@@ -409,161 +829,998 @@ void IEC61850Client::readAndExportMms()
         }
         default:
             Logger::getLogger()->error("Read MMS: unknown reading mode: %u",
-                        m_applicationParams.readMode);
+                        m_applicationParams->readMode);
             break;
     }
-}
 
-void IEC61850Client::readAndExportAllDO()
-{
-    for (const auto &dpConfig : m_localExchangedData) {
-        std::shared_ptr<WrappedMms> wrapped_mms;
+    /** Publish the latencies of the current connection, after each cycle */
+    RequestLatencies latencies = m_connection->getRequestLatencies();
+    {
+        std::lock_guard<std::mutex> guard(m_requestLatenciesMutex);
+        m_currentRequestLatencies = latencies;
+    }
 
-        /** Read the DataObject, */
-        wrapped_mms = m_connection->readDO(dpConfig.dataPath,
-                dpConfig.functionalConstraint);
+    /** (drained at each cycle, also without congestion control) */
+    ResponseTimeSummary responseTimes = m_connection->takeResponseTimes();
+    m_runtimeStatistics.recordResponseTimes(responseTimes);
+    updateCongestionControl(responseTimes);
 
-        if (wrapped_mms) {
-            sendData(convertMmsToDatapoint(wrapped_mms->getMmsValue(), dpConfig));
-        }
-    }
+    return isDiscoveryInProgress;
 }
 
-void IEC61850Client::readAndExportAllDatasets()
+void IEC61850Client::updateCongestionControl(const ResponseTimeSummary &responseTimes)
 {
-    for (const auto &it : m_localExchangedDatasets) {
-        const std::string datasetRef = it.first;
-        const ExchangedData &exchangedDataset = it.second;
+    if (! m_applicationParams->congestionControl.isEnabled) {
+        return;
+    }
 
-        readAndExportOneDataset(datasetRef, exchangedDataset);
+    CongestionState previousState = m_congestionControl.getState();
+    bool isCongested = m_congestionControl.update(responseTimes);
+    CongestionState state = m_congestionControl.getState();
+
+    if (isCongested && (! previousState.isCongested)) {
+        Logger::getLogger()->warn("IEC61850Client: %s is congested (mean response time %lld us, baseline %lld us, "
+                                  "%u timeouts): period x%.2f, %u requests in flight",
+                                  m_clientId.c_str(),
+                                  static_cast<long long>(responseTimes.getMeanResponseTime().count()),
+                                  static_cast<long long>(state.baselineResponseTime.count()),
+                                  static_cast<unsigned int>(responseTimes.timeoutCount),
+                                  state.slowdown,
+                                  state.window);
+    } else if ( (previousState.slowdown > 1.0) && (state.slowdown <= 1.0)) {
+        Logger::getLogger()->info("IEC61850Client: %s is back to its nominal polling rate (%u congestions so far)",
+                                  m_clientId.c_str(),
+                                  static_cast<unsigned int>(state.congestionCount));
     }
 }
 
-void IEC61850Client::readAndExportOneDataset(const std::string &datasetRef,
-                                             const ExchangedData &exchangedDataset)
+CongestionState IEC61850Client::getCongestionState() const
 {
-    /** Read the complete Dataset, */
-    std::shared_ptr<WrappedMms> wrapped_mms;
-    wrapped_mms = m_connection->readDataset(datasetRef);
+    return m_congestionControl.getState();
+}
 
-    /** Split the dataset, to create 1 reading per DataObject. */
-    const MmsValue * const datasetMmsValue = wrapped_mms->getMmsValue();
-    if (   (datasetMmsValue == nullptr)
-            || (MmsValue_getType(datasetMmsValue) != MMS_ARRAY)
-            || (MmsValue_getArraySize(datasetMmsValue) != exchangedDataset.size())) {
-        throw MmsParsingException("Dataset structure does not match");
+void IEC61850Client::publishRuntimeStatistics()
+{
+    const RuntimeStatisticsParameters &statisticsParams = m_applicationParams->runtimeStatistics;
+    auto now = std::chrono::steady_clock::now();
+
+    if ( (! statisticsParams.isEnabled)
+            || (! m_runtimeStatistics.isPublicationDue(now, std::chrono::milliseconds(statisticsParams.periodInMs)))) {
+        return;
     }
 
-    uint32_t datasetIndex = 0;
-    for (const auto &dpConfig : exchangedDataset) {
-        if ( ! dpConfig.label.empty()) {
-            const MmsValue *doMmsValue = MmsValue_getElement(datasetMmsValue,
-                                                             datasetIndex);
-            sendData(convertMmsToDatapoint(doMmsValue, dpConfig));
-        } else {
-            Logger::getLogger()->debug("Read Dataset: DO ignored: %s",
-                    dpConfig.dataPath.c_str());
-        }
-        datasetIndex++;
+    RuntimeStatisticsSnapshot snapshot = m_runtimeStatistics.takeSnapshot(now);
+
+    if (nullptr == m_iec61850) {
+        return;
     }
+
+    std::vector<Datapoint *> points = buildStatisticsDatapoints(m_clientId, snapshot);
+    m_iec61850->ingest(points, statisticsParams.assetName);
 }
 
-void IEC61850Client::buildConfigurationNameTrees()
+std::vector<Datapoint *> IEC61850Client::buildStatisticsDatapoints(const std::string &clientId,
+                                                                   const RuntimeStatisticsSnapshot &snapshot)
 {
-    /** Build the 'NameTree' for each ExchangedData. */
-    for (auto &dpConfig : m_localExchangedData) {
-        const std::string &doPath = dpConfig.dataPath;
-
-        dpConfig.mmsNameTree.reset();
-        dpConfig.mmsNameTree = std::make_shared<MmsNameNode>();
+    std::vector<Datapoint *> points;
+
+    auto addCount = [&points](const std::string &name, uint64_t count) {
+        points.push_back(createDatapoint(name, static_cast<long>(count)));
+    };
+
+    auto addHistogram = [&points](const std::string &prefix, const LatencyHistogram &histogram) {
+        points.push_back(createDatapoint(prefix + "_mean_us", static_cast<long>(histogram.getMean().count())));
+        points.push_back(createDatapoint(prefix + "_p50_us", static_cast<long>(histogram.getPercentile(50.0).count())));
+        points.push_back(createDatapoint(prefix + "_p99_us", static_cast<long>(histogram.getPercentile(99.0).count())));
+        points.push_back(createDatapoint(prefix + "_max_us", static_cast<long>(histogram.getMax().count())));
+    };
+
+    points.push_back(createDatapoint("ied", clientId));
+    addCount("interval_ms", static_cast<uint64_t>(snapshot.interval.count()));
+    addCount("cycles", snapshot.cycleCount);
+    addHistogram("cycle_duration", snapshot.cycleDurations);
+    addCount("mms_requests", snapshot.responseTimes.getCount());
+    addHistogram("mms_round_trip", snapshot.responseTimes);
+    addCount("mms_timeouts", snapshot.timeoutCount);
+    addCount("readings", snapshot.readingCount);
+    points.push_back(createDatapoint("readings_per_second", snapshot.readingsPerSecond));
+    addCount("conversion_errors", snapshot.conversionErrorCount);
+    addCount("connection_losses", snapshot.connectionLossCount);
+    addHistogram("ingest_lock_wait", snapshot.ingestLockWaits);
+
+    return points;
+}
 
-        m_connection->buildNameTree(doPath,
-                                    dpConfig.functionalConstraint,
-                                    dpConfig.mmsNameTree.get());
+void IEC61850Client::readAndExportAllDO()
+{
+    std::vector<std::function<void()>> readTasks;
 
-        dpConfig.mmsNameTree->mmsName = dpConfig.label;
-    }
+    /** Read the DO grouped in dynamic datasets, with 1 request per dataset, */
+    for (const auto &it : m_dynamicDatasetMembers) {
+        if (m_applicationParams->isAdaptivePollingEnabled && (! it.second.empty())) {
+            /** (a dataset follows its most demanding DO) */
+            PollingPeriodBounds datasetBounds = resolvePollingBounds((*m_exchangedData)[it.second.front()]);
 
-    IEC61850ClientConfig::logExchangedData(m_localExchangedData);
+            for (std::size_t index : it.second) {
+                datasetBounds = IEC61850AdaptivePolling::tightestBounds(datasetBounds,
+                                                                        resolvePollingBounds((*m_exchangedData)[index]));
+            }
 
-    /** For each ExchangedDataset, */
-    for (const auto &selectionEntry : m_selectedDOInExchangedDatasets) {
-        std::string datasetRef(selectionEntry.first);
+            if (! isPollingDue(it.first, datasetBounds)) {
+                continue;
+            }
+        }
 
-        /** ask the DO list to the IED, */
-        std::vector<std::string> doPathListWithFC;
-        doPathListWithFC = m_connection->getDoPathListWithFCFromDataset(datasetRef);
+        readTasks.emplace_back([this, &it] { readAndExportDynamicDataset(it.first, it.second); });
+    }
 
-        ExchangedData exchangedDataset;
+    /** then read the other DO one by one, discovered or not, */
+    std::vector<std::size_t> highPriorityIndexes;
 
-        for(const auto &doPathWithFC : doPathListWithFC) {
-            DatapointConfig newDpConfig;
-            std::string doPath;
-            std::string functionalConstraintStr;
+    for (std::size_t index = 0; index < m_exchangedData->size(); ++index) {
+        if ( (index < m_isReadByDynamicDataset.size()) && m_isReadByDynamicDataset[index]) {
+            continue;
+        }
 
-            /** extract the DO path and the FC, */
-            doPath = doPathWithFC.substr(0, doPathWithFC.find("["));
-
-            size_t functionalConstraintStrLen = doPathWithFC.find("]") -
-                                                doPathWithFC.find("[") - 1;
-            functionalConstraintStr = doPathWithFC.substr(doPathWithFC.find("[") + 1,
-                                                          functionalConstraintStrLen);
-            newDpConfig.functionalConstraint =
-                FunctionalConstraint_fromString(functionalConstraintStr.c_str());
-            newDpConfig.dataPath = doPath;
-
-            /** and build the 'NameTree', */
-            newDpConfig.mmsNameTree.reset();
-            newDpConfig.mmsNameTree = std::make_shared<MmsNameNode>();
-
-            m_connection->buildNameTree(doPath,
-                                        newDpConfig.functionalConstraint,
-                                        newDpConfig.mmsNameTree.get());
-
-            /** and indicate if this DO is selected, as a datapoint to read. */
-            for (const auto &selectedDO : selectionEntry.second) {
-                std::size_t pos = doPath.find(std::string("." + selectedDO.dataPath));
-                if ( std::string::npos != pos) {
-                    // Import the 'selected DO' properties to the Datapoint
-                    newDpConfig.label = selectedDO.label;
-                    newDpConfig.mmsNameTree->mmsName = selectedDO.label;
-                    newDpConfig.datapointType = selectedDO.datapointType;
-                    newDpConfig.datapointTypeId = selectedDO.datapointTypeId;
-                    break;
-                }
-            }
+        if ((*m_exchangedData)[index].priority == ReadPriority::HIGH) {
+            highPriorityIndexes.push_back(index);
+            continue;
+        }
 
-            exchangedDataset.push_back(newDpConfig);
+        if ( m_applicationParams->isAdaptivePollingEnabled
+                && (! isPollingDue(buildDoPathWithFC((*m_exchangedData)[index]),
+                                   resolvePollingBounds((*m_exchangedData)[index])))) {
+            continue;
         }
 
-        /** if no DO is selected, then select all DOs of the dataset */
-        /** (the selection is based on whether the 'label' is empty or not). */
-        bool noDOSelected = true;
-        for (const auto &dpConfig : exchangedDataset) {
-            if (!dpConfig.label.empty()) {
-                noDOSelected = false;
-                break;
+        readTasks.emplace_back([this, index] {
+            const DatapointConfig &dpConfig = (*m_exchangedData)[index];
+            std::shared_ptr<WrappedMms> wrapped_mms;
+
+            if (! drawFromRequestBudget(ReadPriority::NORMAL, 1, dpConfig.dataPath.size())) {
+                return;
             }
-        }
 
-        if (noDOSelected) {
-            for (auto &dpConfig : exchangedDataset) {
-                size_t startPos = dpConfig.dataPath.find_last_of(".");
-                std::string doName = "noName";
+            /** Read the DataObject, */
+            IedClientError error = IED_ERROR_OK;
+            wrapped_mms = m_connection->readDO(dpConfig.dataPath,
+                                               dpConfig.functionalConstraint,
+                                               error);
 
-                if (startPos != std::string::npos) {
-                    doName = dpConfig.dataPath.substr(startPos + 1);
-                }
+            std::size_t fingerprint = 0;
 
-                dpConfig.label = doName;
-                if (dpConfig.mmsNameTree) {
-                    dpConfig.mmsNameTree->mmsName = doName;
-                }
+            if ( wrapped_mms && isReadSuccessful(error, dpConfig.dataPath)
+                    && exportDO(index, wrapped_mms->getMmsValue(), fingerprint)) {
+                recordPolledValue(buildDoPathWithFC(dpConfig), fingerprint);
             }
-        }
+        });
+    }
 
-        m_localExchangedDatasets[datasetRef] = exchangedDataset;
+    /** except the high priority DO: they are read in their own lane, meanwhile. */
+    if (highPriorityIndexes.empty()) {
+        runReadTasks(readTasks);
+    } else {
+        runReadTasksWithHighPriorityLane(readTasks, highPriorityIndexes);
     }
+}
 
-    IEC61850ClientConfig::logExchangedDatasets(m_localExchangedDatasets);
+void IEC61850Client::runReadTasksWithHighPriorityLane(const std::vector<std::function<void()>> &readTasks,
+                                                      const std::vector<std::size_t> &highPriorityIndexes)
+{
+    std::mutex laneMutex;
+    std::condition_variable readTasksDone;
+    bool areReadTasksDone = false;
+    std::chrono::milliseconds lanePeriod(m_applicationParams->highPriorityReadPeriodInMs);
+
+    /** Read the high priority DO at once, then periodically until the other reads are done */
+    auto highPriorityLane = std::async(std::launch::async, [&] {
+        std::unique_lock<std::mutex> guard(laneMutex);
+
+        do {
+            guard.unlock();
+            readAndExportHighPriorityDO(highPriorityIndexes);
+            guard.lock();
+        } while ( (lanePeriod.count() > 0)
+                  && (! readTasksDone.wait_for(guard, lanePeriod, [&areReadTasksDone] {
+                          return areReadTasksDone;
+                      })));
+    });
+
+    std::exception_ptr firstError;
+
+    try {
+        runReadTasks(readTasks);
+    } catch (...) {
+        firstError = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(laneMutex);
+        areReadTasksDone = true;
+    }
+
+    readTasksDone.notify_all();
+
+    try {
+        highPriorityLane.get();
+    } catch (...) {
+        if (! firstError) {
+            firstError = std::current_exception();
+        }
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+void IEC61850Client::readAndExportHighPriorityDO(const std::vector<std::size_t> &doIndexes)
+{
+    std::vector<std::string> doPathListWithFC;
+    doPathListWithFC.reserve(doIndexes.size());
+    std::size_t referenceBytes = 0;
+
+    for (std::size_t index : doIndexes) {
+        doPathListWithFC.push_back(buildDoPathWithFC((*m_exchangedData)[index]));
+        referenceBytes += doPathListWithFC.back().size();
+    }
+
+    /** (the reserved share of the budget is available to these reads) */
+    if (! drawFromRequestBudget(ReadPriority::HIGH, doIndexes.size(), referenceBytes)) {
+        return;
+    }
+
+    /** 1 request per logical device, sent before the waiting normal requests */
+    std::shared_ptr<WrappedMms> wrapped_mms;
+    IedClientError error = IED_ERROR_OK;
+    wrapped_mms = m_connection->readMultipleDO(doPathListWithFC, ReadPriority::HIGH, error);
+
+    if ( (! wrapped_mms) || (! isReadSuccessful(error, "high priority DO"))) {
+        return;
+    }
+
+    const MmsValue * const allMmsValues = wrapped_mms->getMmsValue();
+    if (   (allMmsValues == nullptr)
+            || (MmsValue_getType(allMmsValues) != MMS_ARRAY)
+            || (MmsValue_getArraySize(allMmsValues) != doIndexes.size())) {
+        throw MmsParsingException("High priority DO structure does not match");
+    }
+
+    for (std::size_t rank = 0; rank < doIndexes.size(); ++rank) {
+        std::size_t fingerprint = 0;
+        exportDO(doIndexes[rank],
+                 MmsValue_getElement(allMmsValues, static_cast<int>(rank)),
+                 fingerprint);
+    }
+}
+
+bool IEC61850Client::isReadSuccessful(IedClientError error, const std::string &reference) const
+{
+    if (error == IED_ERROR_OK) {
+        return true;
+    }
+
+    IEC61850_LOG_RATE_LIMITED_ERROR("IEC61850Client: failed to read %s: %s (%s)",
+                                    reference.c_str(),
+                                    IEC61850ClientConnection::getErrorDescription(error),
+                                    m_clientId.c_str());
+    return false;
+}
+
+bool IEC61850Client::drawFromRequestBudget(ReadPriority priority,
+                                           std::size_t doCount,
+                                           std::size_t referenceBytes)
+{
+    if (! m_requestBudget) {
+        return true;
+    }
+
+    return m_requestBudget->acquire(priority,
+                                    IEC61850RequestBudget::estimateExchangeSize(doCount, referenceBytes),
+                                    m_stopOrder);
+}
+
+void IEC61850Client::runReadTasks(const std::vector<std::function<void()>> &readTasks)
+{
+    /** (less shards than associations while the IED is congested) */
+    std::size_t shardCount = std::min<std::size_t>(std::min(std::max(1u, m_connectionParam->associationCount),
+                                                            m_congestionControl.getWindow()),
+                                                   readTasks.size());
+
+    /** 1 shard per association: the requests of the shards are sent in parallel */
+    auto runShard = [&readTasks, shardCount](std::size_t shard) {
+        for (std::size_t index = shard; index < readTasks.size(); index += shardCount) {
+            readTasks[index]();
+        }
+    };
+
+    if (shardCount <= 1) {
+        runShard(0);
+        return;
+    }
+
+    std::vector<std::future<void>> otherShards;
+    otherShards.reserve(shardCount - 1);
+
+    for (std::size_t shard = 1; shard < shardCount; ++shard) {
+        otherShards.push_back(std::async(std::launch::async, runShard, shard));
+    }
+
+    /** Wait for all the shards, before reporting the first error (if any) */
+    std::exception_ptr firstError;
+
+    try {
+        runShard(0);
+    } catch (...) {
+        firstError = std::current_exception();
+    }
+
+    for (auto &shard : otherShards) {
+        try {
+            shard.get();
+        } catch (...) {
+            if (! firstError) {
+                firstError = std::current_exception();
+            }
+        }
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+Datapoint *IEC61850Client::convertReadValue(const MmsValue *mmsValue,
+                                            const DatapointConfig &datapointConfig,
+                                            const MmsNameNode *mmsNameTree)
+{
+    IEC61850TraceSpan conversionSpan("convert_mms");
+
+    try {
+        return convertMmsToDatapoint(mmsValue, datapointConfig, mmsNameTree);
+    } catch (MmsParsingException &) {
+        m_runtimeStatistics.recordConversionError();
+        throw;
+    }
+}
+
+bool IEC61850Client::exportDO(std::size_t doIndex, const MmsValue *mmsValue, std::size_t &fingerprint)
+{
+    /** With the first value, resolve the DO structure if not yet discovered */
+    if (! resolveNameTreeOfValue(m_nameTrees[doIndex], (*m_exchangedData)[doIndex], mmsValue)) {
+        return false;
+    }
+
+    Datapoint *datapoint = convertReadValue(mmsValue,
+                                            (*m_exchangedData)[doIndex],
+                                            m_nameTrees[doIndex].get());
+    fingerprint = fingerprintDatapoint(datapoint);
+    sendData(datapoint);
+
+    return true;
+}
+
+bool IEC61850Client::isPollingDue(const std::string &unitKey, const PollingPeriodBounds &unitBounds)
+{
+    if (! m_applicationParams->isAdaptivePollingEnabled) {
+        return true;
+    }
+
+    return m_adaptivePolling.isDue(unitKey,
+                                   IEC61850AdaptivePolling::resolveBounds(unitBounds,
+                                                                          m_applicationParams->adaptivePollingBounds),
+                                   std::chrono::steady_clock::now(),
+                                   getPollingPeriod() / 2);
+}
+
+void IEC61850Client::recordPolledValue(const std::string &unitKey, std::size_t fingerprint)
+{
+    if (! m_applicationParams->isAdaptivePollingEnabled) {
+        return;
+    }
+
+    m_adaptivePolling.recordRead(unitKey, fingerprint, std::chrono::steady_clock::now());
+}
+
+PollingPeriodBounds IEC61850Client::resolvePollingBounds(const DatapointConfig &dpConfig) const
+{
+    return IEC61850AdaptivePolling::resolveBounds(dpConfig.pollingPeriodBounds,
+                                                  m_applicationParams->adaptivePollingBounds);
+}
+
+std::size_t IEC61850Client::fingerprintDatapoint(Datapoint *datapoint) const
+{
+    if ( (! m_applicationParams->isAdaptivePollingEnabled) || (! datapoint)) {
+        return 0;
+    }
+
+    /** (the converted value, as exported: a change of quality or timestamp is a change) */
+    return std::hash<std::string>()(datapoint->toJSONProperty());
+}
+
+PollingRateDistribution IEC61850Client::getPollingRateDistribution() const
+{
+    return m_adaptivePolling.getDistribution();
+}
+
+void IEC61850Client::readAndExportDynamicDataset(const std::string &datasetRef,
+                                                 const std::vector<std::size_t> &doIndexes)
+{
+    if (! drawFromRequestBudget(ReadPriority::NORMAL, doIndexes.size(), datasetRef.size())) {
+        return;
+    }
+
+    std::shared_ptr<WrappedMms> wrapped_mms;
+    IedClientError error = IED_ERROR_OK;
+    wrapped_mms = m_connection->readDataset(datasetRef, error);
+
+    if ( (! wrapped_mms) || (! isReadSuccessful(error, datasetRef))) {
+        return;
+    }
+
+    const MmsValue * const datasetMmsValue = wrapped_mms->getMmsValue();
+    if (   (datasetMmsValue == nullptr)
+            || (MmsValue_getType(datasetMmsValue) != MMS_ARRAY)
+            || (MmsValue_getArraySize(datasetMmsValue) != doIndexes.size())) {
+        throw MmsParsingException("Dataset structure does not match");
+    }
+
+    std::size_t datasetFingerprint = 0;
+
+    for (std::size_t rank = 0; rank < doIndexes.size(); ++rank) {
+        std::size_t fingerprint = 0;
+
+        /** (a skipped member changes the fingerprint: the dataset is not seen as stable) */
+        if (exportDO(doIndexes[rank],
+                     MmsValue_getElement(datasetMmsValue, static_cast<int>(rank)),
+                     fingerprint)) {
+            datasetFingerprint = IEC61850AdaptivePolling::combineFingerprints(datasetFingerprint, fingerprint);
+        }
+    }
+
+    recordPolledValue(datasetRef, datasetFingerprint);
+}
+
+void IEC61850Client::readAndExportAllDatasets()
+{
+    std::vector<std::function<void()>> readTasks;
+
+    for (auto &it : m_localExchangedDatasets) {
+        const std::string &datasetRef = it.first;
+        ExchangedData &exchangedDataset = it.second;
+
+        if (m_applicationParams->isAdaptivePollingEnabled) {
+            /** (a dataset follows its most demanding DO, the application bounds without selection) */
+            PollingPeriodBounds datasetBounds = m_applicationParams->adaptivePollingBounds;
+
+            if (! exchangedDataset.empty()) {
+                datasetBounds = resolvePollingBounds(exchangedDataset.front());
+            }
+
+            for (const auto &dpConfig : exchangedDataset) {
+                datasetBounds = IEC61850AdaptivePolling::tightestBounds(datasetBounds,
+                                                                        resolvePollingBounds(dpConfig));
+            }
+
+            if (! isPollingDue(datasetRef, datasetBounds)) {
+                continue;
+            }
+        }
+
+        readTasks.emplace_back([this, &datasetRef, &exchangedDataset] {
+            readAndExportOneDataset(datasetRef, exchangedDataset);
+        });
+    }
+
+    runReadTasks(readTasks);
+}
+
+void IEC61850Client::readAndExportOneDataset(const std::string &datasetRef,
+                                             ExchangedData &exchangedDataset)
+{
+    if (! drawFromRequestBudget(ReadPriority::NORMAL, exchangedDataset.size(), datasetRef.size())) {
+        return;
+    }
+
+    /** Read the Dataset, or only its selected members, */
+    std::shared_ptr<WrappedMms> wrapped_mms;
+    IedClientError error = IED_ERROR_OK;
+    auto strategyIt = m_datasetReadStrategies.find(datasetRef);
+
+    if ( (strategyIt != m_datasetReadStrategies.end())
+            && (strategyIt->second == DatasetReadStrategy::SELECTED_MEMBERS)) {
+        std::vector<std::string> doPathListWithFC;
+        doPathListWithFC.reserve(exchangedDataset.size());
+
+        for (const auto &dpConfig : exchangedDataset) {
+            doPathListWithFC.push_back(buildDoPathWithFC(dpConfig));
+        }
+
+        wrapped_mms = m_connection->readMultipleDO(doPathListWithFC, ReadPriority::NORMAL, error);
+    } else {
+        wrapped_mms = m_connection->readDataset(datasetRef, error);
+    }
+
+    if ( (! wrapped_mms) || (! isReadSuccessful(error, datasetRef))) {
+        return;
+    }
+
+    /** Split the dataset, to create 1 reading per DataObject. */
+    const MmsValue * const datasetMmsValue = wrapped_mms->getMmsValue();
+    if (   (datasetMmsValue == nullptr)
+            || (MmsValue_getType(datasetMmsValue) != MMS_ARRAY)
+            || (MmsValue_getArraySize(datasetMmsValue) != exchangedDataset.size())) {
+        throw MmsParsingException("Dataset structure does not match");
+    }
+
+    uint32_t datasetIndex = 0;
+    std::size_t datasetFingerprint = 0;
+
+    for (auto &dpConfig : exchangedDataset) {
+        if ( ! dpConfig.label.empty()) {
+            const MmsValue *doMmsValue = MmsValue_getElement(datasetMmsValue,
+                                                             datasetIndex);
+
+            /** The structure of a member is resolved at its first reading */
+            if (resolveNameTreeOfValue(dpConfig.mmsNameTree, dpConfig, doMmsValue)) {
+                Datapoint *datapoint = convertReadValue(doMmsValue, dpConfig, dpConfig.mmsNameTree.get());
+                datasetFingerprint = IEC61850AdaptivePolling::combineFingerprints(datasetFingerprint,
+                                                                                  fingerprintDatapoint(datapoint));
+                sendData(datapoint);
+            }
+        } else {
+            IEC61850_LOG_DEBUG("Read Dataset: DO ignored: %s",
+                    dpConfig.dataPath.c_str());
+        }
+        datasetIndex++;
+    }
+
+    recordPolledValue(datasetRef, datasetFingerprint);
+}
+
+void IEC61850Client::buildConfigurationNameTrees()
+{
+    resetDiscovery();
+    discoverNameTrees(std::chrono::steady_clock::time_point::max());
+}
+
+void IEC61850Client::resetDiscovery()
+{
+    /** The name trees are rebuilt, the dynamic datasets are lost with the previous connection */
+    m_nameTrees.assign(m_exchangedData->size(), nullptr);
+    m_associationDatasetCount = 0;
+    m_dynamicDatasetMembers.clear();
+    m_datasetReadStrategies.clear();
+
+    restartDiscovery();
+}
+
+void IEC61850Client::restartDiscovery()
+{
+    deleteAssociationDatasets();
+
+    m_discoveredDOCount = 0;
+    m_isDiscoveryComplete = false;
+    m_dynamicDatasetMembers.clear();
+    m_isReadByDynamicDataset.clear();
+    m_localExchangedDatasets.clear();
+    m_datasetReadStrategies.clear();
+}
+
+void IEC61850Client::deleteAssociationDatasets()
+{
+    // Preconditions
+    if (! m_connection) {
+        return;
+    }
+
+    /** The server accepts a limited number of association specific datasets: */
+    /** free the ones which will no longer be read */
+    for (const auto &it : m_dynamicDatasetMembers) {
+        m_connection->deleteDataset(it.first);
+    }
+
+    for (const auto &it : m_datasetReadStrategies) {
+        if (it.second == DatasetReadStrategy::TRIMMED_DATASET) {
+            m_connection->deleteDataset(it.first);
+        }
+    }
+}
+
+bool IEC61850Client::discoverConfigurationStep(std::chrono::milliseconds budget)
+{
+    // Preconditions
+    if (m_isDiscoveryComplete) {
+        return false;
+    }
+
+    /** Wait for a discovery slot, shared with the other clients, */
+    if (m_discoveryCoordinator) {
+        if (! m_isDiscoveryQueued) {
+            m_discoveryTicket = m_discoveryCoordinator->enqueue(m_configuredPointCount);
+            m_isDiscoveryQueued = true;
+        }
+
+        if (! m_discoveryCoordinator->waitForSlot(m_discoveryTicket, budget, m_stopOrder)) {
+            return (! m_stopOrder);
+        }
+
+        m_isDiscoveryQueued = false;
+    }
+
+    /** and discover the next DO during the budget. */
+    try {
+        discoverNameTrees(std::chrono::steady_clock::now() + budget);
+    } catch (...) {
+        if (m_discoveryCoordinator) {
+            m_discoveryCoordinator->release();
+        }
+        throw;
+    }
+
+    if (m_discoveryCoordinator) {
+        m_discoveryCoordinator->release();
+    }
+
+    return (! m_isDiscoveryComplete);
+}
+
+bool IEC61850Client::discoverNameTrees(std::chrono::steady_clock::time_point deadline)
+{
+    /** Build the 'NameTree' of the next ExchangedData, until the deadline, */
+    while (m_discoveredDOCount < m_exchangedData->size()) {
+        /** (unless its first reading already did it) */
+        if (! m_nameTrees[m_discoveredDOCount]) {
+            m_nameTrees[m_discoveredDOCount] = resolveNameTree((*m_exchangedData)[m_discoveredDOCount]);
+        }
+
+        m_discoveredDOCount++;
+
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+
+    if (m_discoveredDOCount < m_exchangedData->size()) {
+        return false;
+    }
+
+    /** then, once all the DO are discovered, create the datasets. */
+    if (! m_isDiscoveryComplete) {
+        IEC61850ClientConfig::logExchangedData(*m_exchangedData);
+
+        if ( (m_applicationParams->readMode == ReadMode::DO_READING)
+                && m_applicationParams->useDynamicDatasets) {
+            createDynamicDatasets();
+        }
+
+        discoverDatasets();
+
+        m_isDiscoveryComplete = true;
+        Logger::getLogger()->info("IEC61850Client: model discovery complete (%s)",
+                                  m_clientId.c_str());
+    }
+
+    return true;
+}
+
+std::shared_ptr<MmsNameNode> IEC61850Client::resolveNameTree(const DatapointConfig &dpConfig)
+{
+    auto nameTree = std::make_shared<MmsNameNode>();
+
+    /** A failed query is retried with the next value or discovery step */
+    if (! m_connection->buildNameTree(dpConfig.dataPath,
+                                      dpConfig.functionalConstraint,
+                                      nameTree.get())) {
+        return nullptr;
+    }
+
+    /** Only the root, named after the label, is specific to this DO */
+    nameTree->mmsName = dpConfig.label;
+
+    if (m_nameTreeCache) {
+        m_nameTreeCache->internChildren(*nameTree);
+    }
+
+    return nameTree;
+}
+
+bool IEC61850Client::resolveNameTreeOfValue(std::shared_ptr<MmsNameNode> &nameTree,
+                                            const DatapointConfig &dpConfig,
+                                            const MmsValue *mmsValue)
+{
+    if (nameTree || (! mmsValue)) {
+        return true;
+    }
+
+    nameTree = resolveNameTree(dpConfig);
+
+    if (! nameTree) {
+        IEC61850_LOG_RATE_LIMITED_WARN("IEC61850Client: structure of %s unknown, value skipped",
+                                       dpConfig.dataPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void IEC61850Client::discoverDatasets()
+{
+    /** The trimmed datasets are lost with the previous connection */
+    m_localExchangedDatasets.clear();
+    m_datasetReadStrategies.clear();
+
+    /** For each ExchangedDataset, */
+    for (const auto &selectionEntry : *m_selectedDOInExchangedDatasets) {
+        std::string datasetRef(selectionEntry.first);
+
+        /** index the selected DO by name (the 1st one wins in case of duplicate), */
+        std::unordered_map<std::string, const DatapointConfig *> selectedDOByName;
+        selectedDOByName.reserve(selectionEntry.second.size());
+
+        for (const auto &selectedDO : selectionEntry.second) {
+            selectedDOByName.emplace(selectedDO.dataPath, &selectedDO);
+        }
+
+        /** ask the DO list to the IED, */
+        std::vector<std::string> doPathListWithFC;
+        doPathListWithFC = m_connection->getDoPathListWithFCFromDataset(datasetRef);
+
+        ExchangedData exchangedDataset;
+        exchangedDataset.reserve(doPathListWithFC.size());
+        std::string doPathSuffix;
+
+        for(const auto &doPathWithFC : doPathListWithFC) {
+            DatapointConfig newDpConfig;
+
+            /** extract the DO path and the FC, */
+            splitDoPathWithFC(doPathWithFC,
+                              newDpConfig.dataPath,
+                              newDpConfig.functionalConstraint);
+            const std::string &doPath = newDpConfig.dataPath;
+
+            /** and indicate if this DO is selected, as a datapoint to read */
+            /** (its 'NameTree' is resolved at its first reading). */
+            const DatapointConfig *selectedDO = findSelectedDO(doPath, selectedDOByName, doPathSuffix);
+            if (selectedDO) {
+                // Import the 'selected DO' properties to the Datapoint
+                newDpConfig.label = selectedDO->label;
+                newDpConfig.datapointType = selectedDO->datapointType;
+                newDpConfig.datapointTypeId = selectedDO->datapointTypeId;
+            }
+
+            exchangedDataset.push_back(std::move(newDpConfig));
+        }
+
+        /** if no DO is selected, then select all DOs of the dataset */
+        /** (the selection is based on whether the 'label' is empty or not). */
+        bool noDOSelected = true;
+        for (const auto &dpConfig : exchangedDataset) {
+            if (!dpConfig.label.empty()) {
+                noDOSelected = false;
+                break;
+            }
+        }
+
+        if (noDOSelected) {
+            for (auto &dpConfig : exchangedDataset) {
+                size_t startPos = dpConfig.dataPath.find_last_of(".");
+                std::string doName = "noName";
+
+                if (startPos != std::string::npos) {
+                    doName = dpConfig.dataPath.substr(startPos + 1);
+                }
+
+                dpConfig.label = doName;
+            }
+        }
+
+        selectDatasetReadStrategy(datasetRef, exchangedDataset);
+    }
+
+    IEC61850ClientConfig::logExchangedDatasets(m_localExchangedDatasets);
+}
+
+void IEC61850Client::createDynamicDatasets()
+{
+    /** The association specific datasets are lost with the previous connection */
+    m_dynamicDatasetMembers.clear();
+    m_isReadByDynamicDataset.assign(m_exchangedData->size(), false);
+
+    /** Group the DO by logical device (the part of the path before '/'), */
+    std::map<std::string, std::vector<std::size_t>, std::less<>> doIndexesByLogicalDevice;
+
+    for (std::size_t index = 0; index < m_exchangedData->size(); ++index) {
+        const DatapointConfig &dpConfig = (*m_exchangedData)[index];
+        std::size_t separatorPos = dpConfig.dataPath.find('/');
+
+        /** (the high priority DO are read in their own lane) */
+        if ( (separatorPos == std::string::npos)
+                || (dpConfig.functionalConstraint == IEC61850_FC_NONE)
+                || (dpConfig.priority == ReadPriority::HIGH)) {
+            continue;
+        }
+
+        doIndexesByLogicalDevice[dpConfig.dataPath.substr(0, separatorPos)].push_back(index);
+    }
+
+    /** then ask the IED to create 1 dataset per logical device */
+    /** (split if its creation request exceeds the negotiated PDU size), */
+    /** with names never used before on this association: a name is */
+    /** used up even if the creation fails, it may exist on some associations. */
+    unsigned int maxPduSize = m_connection->getNegotiatedMaxPduSize();
+
+    for (const auto &it : doIndexesByLogicalDevice) {
+        std::vector<std::string> allDoPathListWithFC;
+        allDoPathListWithFC.reserve(it.second.size());
+
+        for (std::size_t index : it.second) {
+            allDoPathListWithFC.push_back(buildDoPathWithFC((*m_exchangedData)[index]));
+        }
+
+        auto firstIndexIt = it.second.begin();
+        auto firstDoPathIt = allDoPathListWithFC.begin();
+
+        for (std::size_t batchSize : IEC61850ClientConnection::splitIntoBatches(allDoPathListWithFC, maxPduSize)) {
+            std::string datasetRef = DYNAMIC_DATASET_PREFIX + std::to_string(m_associationDatasetCount++);
+            std::vector<std::size_t> memberIndexes(firstIndexIt, firstIndexIt + batchSize);
+            std::vector<std::string> doPathListWithFC(firstDoPathIt, firstDoPathIt + batchSize);
+            firstIndexIt += batchSize;
+            firstDoPathIt += batchSize;
+
+            if (! m_connection->createDataset(datasetRef, doPathListWithFC)) {
+                Logger::getLogger()->warn("IEC61850Client: no dynamic dataset for %s, read DO by DO (%s)",
+                                          it.first.c_str(), m_clientId.c_str());
+                continue;
+            }
+
+            Logger::getLogger()->info("IEC61850Client: dynamic dataset %s created for %s (%u DO)",
+                                      datasetRef.c_str(), it.first.c_str(),
+                                      static_cast<unsigned int>(memberIndexes.size()));
+
+            for (std::size_t index : memberIndexes) {
+                m_isReadByDynamicDataset[index] = true;
+            }
+
+            m_dynamicDatasetMembers[datasetRef] = std::move(memberIndexes);
+        }
+    }
+}
+
+void IEC61850Client::selectDatasetReadStrategy(const std::string &datasetRef,
+                                               const ExchangedData &exchangedDataset)
+{
+    /** Keep only the selected members, */
+    ExchangedData selectedMembers;
+    std::vector<std::string> selectedDoPathListWithFC;
+
+    for (const auto &dpConfig : exchangedDataset) {
+        if (! dpConfig.label.empty()) {
+            selectedMembers.push_back(dpConfig);
+            selectedDoPathListWithFC.push_back(buildDoPathWithFC(dpConfig));
+        }
+    }
+
+    float selectedFraction = 1.0f;
+    if (! exchangedDataset.empty()) {
+        selectedFraction = static_cast<float>(selectedMembers.size())
+                           / static_cast<float>(exchangedDataset.size());
+    }
+
+    std::string readRef = datasetRef;
+    DatasetReadStrategy strategy = DatasetReadStrategy::FULL_DATASET;
+
+    /** and, when they are a small part of the dataset, read only them: */
+    if ( (! selectedMembers.empty())
+            && (selectedFraction < m_applicationParams->partialReadThreshold)) {
+        std::string trimmedRef = TRIMMED_DATASET_PREFIX
+                                 + std::to_string(m_associationDatasetCount++);
+
+        /** through a trimmed dataset if the server accepts it, else member by member. */
+        if (m_connection->createDataset(trimmedRef, selectedDoPathListWithFC)) {
+            readRef = trimmedRef;
+            strategy = DatasetReadStrategy::TRIMMED_DATASET;
+        } else {
+            strategy = DatasetReadStrategy::SELECTED_MEMBERS;
+        }
+    }
+
+    Logger::getLogger()->info("IEC61850Client: dataset %s: %u/%u members selected, read strategy: %s (%s)",
+                              datasetRef.c_str(),
+                              static_cast<unsigned int>(selectedMembers.size()),
+                              static_cast<unsigned int>(exchangedDataset.size()),
+                              datasetReadStrategyToString(strategy),
+                              readRef.c_str());
+
+    m_datasetReadStrategies[readRef] = strategy;
+
+    if (strategy == DatasetReadStrategy::FULL_DATASET) {
+        m_localExchangedDatasets[readRef] = exchangedDataset;
+    } else {
+        m_localExchangedDatasets[readRef] = selectedMembers;
+    }
+}
+
+const char *IEC61850Client::datasetReadStrategyToString(DatasetReadStrategy strategy)
+{
+    switch (strategy) {
+        case DatasetReadStrategy::FULL_DATASET:
+            return "full dataset";
+        case DatasetReadStrategy::TRIMMED_DATASET:
+            return "trimmed dataset";
+        case DatasetReadStrategy::SELECTED_MEMBERS:
+            return "selected members";
+        default:
+            return "unknown";
+    }
+}
+
+const DatapointConfig *IEC61850Client::findSelectedDO(
+    const std::string &doPath,
+    const std::unordered_map<std::string, const DatapointConfig *> &selectedDOByName,
+    std::string &nameBuffer)
+{
+    if (selectedDOByName.empty()) {
+        return nullptr;
+    }
+
+    /**
+     * The selected name must match whole '.' separated names of the path:
+     * 'SPSSO1' selects 'LN.SPSSO1' and 'LN.SPSSO1.stVal', but not 'LN.SPSSO10'.
+     * The longest match is searched first, from each '.' of the path.
+     */
+    for (std::size_t begin = doPath.find('.');
+            begin != std::string::npos;
+            begin = doPath.find('.', begin + 1)) {
+        std::size_t end = doPath.size();
+
+        while (end > begin + 1) {
+            nameBuffer.assign(doPath, begin + 1, end - begin - 1);
+            auto selectedIt = selectedDOByName.find(nameBuffer);
+
+            if (selectedIt != selectedDOByName.end()) {
+                return selectedIt->second;
+            }
+
+            end = doPath.rfind('.', end - 1);
+            if ( (end == std::string::npos) || (end <= begin)) {
+                break;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+void IEC61850Client::splitDoPathWithFC(const std::string &doPathWithFC,
+                                       std::string &doPath,
+                                       FunctionalConstraint &functionalConstraint)
+{
+    std::size_t fcBegin = doPathWithFC.find('[');
+    doPath.assign(doPathWithFC, 0, fcBegin);
+
+    functionalConstraint = IEC61850_FC_NONE;
+    if (fcBegin == std::string::npos) {
+        return;
+    }
+
+    std::size_t fcEnd = doPathWithFC.find(']', fcBegin);
+    if (fcEnd == std::string::npos) {
+        return;
+    }
+
+    /** The FC has 2 letters: avoid a temporary string */
+    char functionalConstraintStr[3] = {'\0', '\0', '\0'};
+    if (fcEnd - fcBegin == 3) {
+        functionalConstraintStr[0] = doPathWithFC[fcBegin + 1];
+        functionalConstraintStr[1] = doPathWithFC[fcBegin + 2];
+        functionalConstraint = FunctionalConstraint_fromString(functionalConstraintStr);
+    }
+}
+
+std::string IEC61850Client::buildDoPathWithFC(const DatapointConfig &dpConfig)
+{
+    return dpConfig.dataPath + "["
+           + FunctionalConstraint_toString(dpConfig.functionalConstraint)
+           + "]";
 }
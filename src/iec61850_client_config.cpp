@@ -134,6 +134,17 @@ void IEC61850ClientConfig::importJsonTransportLayerConfig(const rapidjson::Value
 
     iedName = std::string(transportLayer["ied_name"].GetString());
 
+    if (transportLayer.HasMember("redundant_connections")) {
+        if (! transportLayer["redundant_connections"].IsBool()) {
+            throw ConfigurationException("bad format for 'redundant_connections'");
+        }
+
+        isRedundancyEnabled = transportLayer["redundant_connections"].GetBool();
+    }
+
+    Logger::getLogger()->info("IEC61850ClientConfig: redundant connections = %s",
+                              isRedundancyEnabled ? "true" : "false");
+
     /** Parse each 'connection' JSON structure */
     for (const auto &conn : transportLayer[JSON_CONNECTIONS].GetArray()) {
         importJsonConnectionConfig(conn);
@@ -176,11 +187,82 @@ void IEC61850ClientConfig::importJsonConnectionConfig(const rapidjson::Value &co
         importJsonConnectionOsiConfig(connConfig["osi"], iedConnectionParam);
     }
 
+    importJsonConnectionDelay(connConfig, "connect_timeout", iedConnectionParam.connectTimeoutInMs);
+    importJsonConnectionDelay(connConfig, "request_timeout", iedConnectionParam.requestTimeoutInMs);
+    importJsonConnectionDelay(connConfig, "reconnect_min_delay", iedConnectionParam.reconnectMinDelayInMs);
+    importJsonConnectionDelay(connConfig, "reconnect_max_delay", iedConnectionParam.reconnectMaxDelayInMs);
+
+    if (iedConnectionParam.reconnectMinDelayInMs > iedConnectionParam.reconnectMaxDelayInMs) {
+        throw ConfigurationException("'reconnect_min_delay' is greater than 'reconnect_max_delay'");
+    }
+
+    if (connConfig.HasMember("associations")) {
+        if (! connConfig["associations"].IsUint()) {
+            throw ConfigurationException("bad format for 'associations'");
+        }
+
+        iedConnectionParam.associationCount = connConfig["associations"].GetUint();
+
+        if (iedConnectionParam.associationCount == 0) {
+            throw ConfigurationException("'associations' must be at least 1");
+        }
+    }
+
+    if (connConfig.HasMember("max_pdu_size")) {
+        if (! connConfig["max_pdu_size"].IsUint()) {
+            throw ConfigurationException("bad format for 'max_pdu_size'");
+        }
+
+        iedConnectionParam.maxPduSize = connConfig["max_pdu_size"].GetUint();
+
+        if ( (iedConnectionParam.maxPduSize < MIN_MMS_PDU_SIZE)
+                || (iedConnectionParam.maxPduSize > MAX_MMS_PDU_SIZE)) {
+            throw ConfigurationException("'max_pdu_size' must be between "
+                                         + std::to_string(MIN_MMS_PDU_SIZE) + " and "
+                                         + std::to_string(MAX_MMS_PDU_SIZE));
+        }
+    }
+
+    if (connConfig.HasMember("max_outstanding_calls")) {
+        if (! connConfig["max_outstanding_calls"].IsUint()) {
+            throw ConfigurationException("bad format for 'max_outstanding_calls'");
+        }
+
+        iedConnectionParam.maxOutstandingCalls = connConfig["max_outstanding_calls"].GetUint();
+
+        if (iedConnectionParam.maxOutstandingCalls == 0) {
+            throw ConfigurationException("'max_outstanding_calls' must be at least 1");
+        }
+    }
+
+    if (connConfig.HasMember("link_group")) {
+        if (! connConfig["link_group"].IsString()) {
+            throw ConfigurationException("bad format for 'link_group'");
+        }
+
+        iedConnectionParam.linkGroup = connConfig["link_group"].GetString();
+    }
+
     logIedConnectionParam(iedConnectionParam);
     ServerDictKey key = buildKey(iedConnectionParam);
     serverConfigDict[key] = iedConnectionParam;
 }
 
+void IEC61850ClientConfig::importJsonConnectionDelay(const rapidjson::Value &connConfig,
+                                                     const char *delayName,
+                                                     unsigned int &delayInMs)
+{
+    if (! connConfig.HasMember(delayName)) {
+        return;
+    }
+
+    if (! connConfig[delayName].IsUint()) {
+        throw ConfigurationException(std::string("bad format for '") + delayName + "'");
+    }
+
+    delayInMs = connConfig[delayName].GetUint();
+}
+
 void IEC61850ClientConfig::importJsonConnectionOsiConfig(const rapidjson::Value &connOsiConfig,
         ServerConnectionParameters &iedConnectionParam) const
 {
@@ -394,6 +476,287 @@ void IEC61850ClientConfig::importJsonApplicationLayerConfig(const rapidjson::Val
             applicationParams.readMode = ReadMode::DO_READING;
         }
     }
+
+    if (applicationLayer.HasMember("dynamic_datasets")) {
+        if (! applicationLayer["dynamic_datasets"].IsBool()) {
+            throw ConfigurationException("bad format for 'dynamic_datasets'");
+        }
+
+        applicationParams.useDynamicDatasets = applicationLayer["dynamic_datasets"].GetBool();
+    }
+
+    if (applicationLayer.HasMember("partial_read_threshold")) {
+        if (! applicationLayer["partial_read_threshold"].IsNumber()) {
+            throw ConfigurationException("bad format for 'partial_read_threshold'");
+        }
+
+        double threshold = applicationLayer["partial_read_threshold"].GetDouble();
+        if ( (threshold < 0.0) || (threshold > 1.0)) {
+            throw ConfigurationException("'partial_read_threshold' must be between 0 and 1");
+        }
+
+        applicationParams.partialReadThreshold = static_cast<float>(threshold);
+    }
+
+    if (applicationLayer.HasMember("max_concurrent_discoveries")) {
+        if (! applicationLayer["max_concurrent_discoveries"].IsUint()) {
+            throw ConfigurationException("bad format for 'max_concurrent_discoveries'");
+        }
+
+        applicationParams.maxConcurrentDiscoveries = applicationLayer["max_concurrent_discoveries"].GetUint();
+    }
+
+    if (applicationLayer.HasMember("high_priority_reading_period")) {
+        if (! applicationLayer["high_priority_reading_period"].IsUint()) {
+            throw ConfigurationException("bad format for 'high_priority_reading_period'");
+        }
+
+        applicationParams.highPriorityReadPeriodInMs = applicationLayer["high_priority_reading_period"].GetUint();
+    }
+
+    if (applicationLayer.HasMember("adaptive_polling")) {
+        const rapidjson::Value &adaptivePolling = applicationLayer["adaptive_polling"];
+
+        if (! adaptivePolling.IsObject()) {
+            throw ConfigurationException("bad format for 'adaptive_polling'");
+        }
+
+        if ( (! adaptivePolling.HasMember("min_period")) || (! adaptivePolling.HasMember("max_period"))) {
+            throw ConfigurationException("'adaptive_polling' needs 'min_period' and 'max_period'");
+        }
+
+        importJsonPollingPeriodBounds(adaptivePolling, applicationParams.adaptivePollingBounds);
+        applicationParams.isAdaptivePollingEnabled = true;
+    }
+
+    if (applicationLayer.HasMember("congestion_control")) {
+        applicationParams.congestionControl = importJsonCongestionControl(applicationLayer["congestion_control"]);
+    }
+
+    if (applicationLayer.HasMember("statistics")) {
+        applicationParams.runtimeStatistics = importJsonRuntimeStatistics(applicationLayer["statistics"]);
+    }
+
+    if (applicationLayer.HasMember("tracing")) {
+        applicationParams.tracing = importJsonTracing(applicationLayer["tracing"]);
+    }
+
+    if (applicationLayer.HasMember("request_budget")) {
+        applicationParams.requestBudget = importJsonRequestBudget(applicationLayer["request_budget"], "request_budget");
+    }
+
+    if (applicationLayer.HasMember("link_budgets")) {
+        if (! applicationLayer["link_budgets"].IsObject()) {
+            throw ConfigurationException("bad format for 'link_budgets'");
+        }
+
+        for (const auto &linkBudget : applicationLayer["link_budgets"].GetObject()) {
+            std::string linkGroup = linkBudget.name.GetString();
+            applicationParams.linkBudgets[linkGroup] = importJsonRequestBudget(linkBudget.value, linkGroup);
+        }
+    }
+}
+
+void IEC61850ClientConfig::importJsonPollingPeriodBounds(const rapidjson::Value &jsonConfig,
+                                                         PollingPeriodBounds &bounds)
+{
+    for (const auto &boundValue : {std::make_pair("min_period", &bounds.minPeriodInMs),
+                                   std::make_pair("max_period", &bounds.maxPeriodInMs)}) {
+        if (! jsonConfig.HasMember(boundValue.first)) {
+            continue;
+        }
+
+        if ( (! jsonConfig[boundValue.first].IsUint()) || (jsonConfig[boundValue.first].GetUint() == 0)) {
+            throw ConfigurationException("bad format for '" + std::string(boundValue.first) + "'");
+        }
+
+        *boundValue.second = jsonConfig[boundValue.first].GetUint();
+    }
+
+    if ( (bounds.minPeriodInMs > 0) && (bounds.maxPeriodInMs > 0)
+            && (bounds.minPeriodInMs > bounds.maxPeriodInMs)) {
+        throw ConfigurationException("'min_period' is greater than 'max_period'");
+    }
+}
+
+TracingParameters IEC61850ClientConfig::importJsonTracing(const rapidjson::Value &jsonTracing)
+{
+    if (! jsonTracing.IsObject()) {
+        throw ConfigurationException("bad format for 'tracing'");
+    }
+
+    TracingParameters tracingParams;
+
+    if (jsonTracing.HasMember("enabled")) {
+        if (! jsonTracing["enabled"].IsBool()) {
+            throw ConfigurationException("bad format for 'enabled' of 'tracing'");
+        }
+
+        tracingParams.isEnabled = jsonTracing["enabled"].GetBool();
+    }
+
+    if (jsonTracing.HasMember("file")) {
+        if ( (! jsonTracing["file"].IsString()) || (jsonTracing["file"].GetStringLength() == 0)) {
+            throw ConfigurationException("bad format for 'file' of 'tracing'");
+        }
+
+        tracingParams.filePath = jsonTracing["file"].GetString();
+    }
+
+    return tracingParams;
+}
+
+RuntimeStatisticsParameters IEC61850ClientConfig::importJsonRuntimeStatistics(const rapidjson::Value &jsonStatistics)
+{
+    if (! jsonStatistics.IsObject()) {
+        throw ConfigurationException("bad format for 'statistics'");
+    }
+
+    RuntimeStatisticsParameters statisticsParams;
+    statisticsParams.isEnabled = true;
+
+    if (jsonStatistics.HasMember("asset_name")) {
+        if ( (! jsonStatistics["asset_name"].IsString()) || (jsonStatistics["asset_name"].GetStringLength() == 0)) {
+            throw ConfigurationException("bad format for 'asset_name' of 'statistics'");
+        }
+
+        statisticsParams.assetName = jsonStatistics["asset_name"].GetString();
+    }
+
+    if (jsonStatistics.HasMember("period")) {
+        if ( (! jsonStatistics["period"].IsUint()) || (jsonStatistics["period"].GetUint() == 0)) {
+            throw ConfigurationException("bad format for 'period' of 'statistics'");
+        }
+
+        statisticsParams.periodInMs = jsonStatistics["period"].GetUint();
+    }
+
+    Logger::getLogger()->info("Config: runtime statistics published every %u ms in the asset '%s'",
+                              statisticsParams.periodInMs,
+                              statisticsParams.assetName.c_str());
+
+    return statisticsParams;
+}
+
+CongestionControlParameters IEC61850ClientConfig::importJsonCongestionControl(
+    const rapidjson::Value &jsonCongestionControl)
+{
+    if (! jsonCongestionControl.IsObject()) {
+        throw ConfigurationException("bad format for 'congestion_control'");
+    }
+
+    CongestionControlParameters congestionParams;
+    congestionParams.isEnabled = true;
+
+    if (jsonCongestionControl.HasMember("response_time_threshold")) {
+        if (! jsonCongestionControl["response_time_threshold"].IsUint()) {
+            throw ConfigurationException("bad format for 'response_time_threshold'");
+        }
+
+        congestionParams.responseTimeThresholdInMs = jsonCongestionControl["response_time_threshold"].GetUint();
+    }
+
+    if (jsonCongestionControl.HasMember("max_slowdown")) {
+        if ( (! jsonCongestionControl["max_slowdown"].IsUint()) || (jsonCongestionControl["max_slowdown"].GetUint() == 0)) {
+            throw ConfigurationException("bad format for 'max_slowdown'");
+        }
+
+        congestionParams.maxSlowdown = jsonCongestionControl["max_slowdown"].GetUint();
+    }
+
+    Logger::getLogger()->info("Config: congestion control: response time threshold %u ms (0: 4 times the baseline), "
+                              "polling slowed down up to %u times",
+                              congestionParams.responseTimeThresholdInMs,
+                              congestionParams.maxSlowdown);
+
+    return congestionParams;
+}
+
+RequestBudgetParameters IEC61850ClientConfig::importJsonRequestBudget(const rapidjson::Value &jsonBudget,
+                                                                      const std::string &budgetName)
+{
+    if (! jsonBudget.IsObject()) {
+        throw ConfigurationException("bad format for the budget '" + budgetName + "'");
+    }
+
+    RequestBudgetParameters budgetParams;
+
+    for (const auto &budgetValue : {std::make_pair("requests_per_second", &budgetParams.requestsPerSecond),
+                                    std::make_pair("bytes_per_second", &budgetParams.bytesPerSecond),
+                                    std::make_pair("high_priority_share", &budgetParams.highPriorityShare)}) {
+        if (! jsonBudget.HasMember(budgetValue.first)) {
+            continue;
+        }
+
+        if (! jsonBudget[budgetValue.first].IsNumber()) {
+            throw ConfigurationException("bad format for '" + std::string(budgetValue.first)
+                                         + "' of the budget '" + budgetName + "'");
+        }
+
+        *budgetValue.second = jsonBudget[budgetValue.first].GetDouble();
+
+        if (*budgetValue.second < 0.0) {
+            throw ConfigurationException("'" + std::string(budgetValue.first)
+                                         + "' of the budget '" + budgetName + "' is negative");
+        }
+    }
+
+    if (budgetParams.highPriorityShare >= 1.0) {
+        throw ConfigurationException("'high_priority_share' of the budget '" + budgetName
+                                     + "' must be lower than 1");
+    }
+
+    Logger::getLogger()->info("Config: request budget '%s': %g requests/s, %g bytes/s (0: no limit), "
+                              "%g reserved to the high priority",
+                              budgetName.c_str(),
+                              budgetParams.requestsPerSecond,
+                              budgetParams.bytesPerSecond,
+                              budgetParams.highPriorityShare);
+
+    return budgetParams;
+}
+
+/** \brief Compare the used part of 2 OSI selectors */
+template <typename Selector>
+static bool isSameSelector(const Selector &firstSelector, const Selector &secondSelector)
+{
+    return (firstSelector.size == secondSelector.size)
+           && (memcmp(firstSelector.value, secondSelector.value,
+                           std::min<std::size_t>(firstSelector.size, sizeof(firstSelector.value))) == 0);
+}
+
+bool IEC61850ClientConfig::isSameConnection(const ServerConnectionParameters &firstConn,
+                                            const ServerConnectionParameters &secondConn)
+{
+    if ( (firstConn.ipAddress != secondConn.ipAddress)
+            || (firstConn.mmsPort != secondConn.mmsPort)
+            || (firstConn.connectTimeoutInMs != secondConn.connectTimeoutInMs)
+            || (firstConn.requestTimeoutInMs != secondConn.requestTimeoutInMs)
+            || (firstConn.associationCount != secondConn.associationCount)
+            || (firstConn.maxPduSize != secondConn.maxPduSize)
+            || (firstConn.maxOutstandingCalls != secondConn.maxOutstandingCalls)
+            || (firstConn.linkGroup != secondConn.linkGroup)
+            || (firstConn.isOsiParametersEnabled != secondConn.isOsiParametersEnabled)) {
+        return false;
+    }
+
+    if (! firstConn.isOsiParametersEnabled) {
+        return true;
+    }
+
+    const OsiParameters &firstOsi = firstConn.osiParameters;
+    const OsiParameters &secondOsi = secondConn.osiParameters;
+
+    return (firstOsi.localApTitle == secondOsi.localApTitle)
+           && (firstOsi.localAeQualifier == secondOsi.localAeQualifier)
+           && (firstOsi.remoteApTitle == secondOsi.remoteApTitle)
+           && (firstOsi.remoteAeQualifier == secondOsi.remoteAeQualifier)
+           && isSameSelector(firstOsi.localTSelector, secondOsi.localTSelector)
+           && isSameSelector(firstOsi.remoteTSelector, secondOsi.remoteTSelector)
+           && isSameSelector(firstOsi.localSSelector, secondOsi.localSSelector)
+           && isSameSelector(firstOsi.remoteSSelector, secondOsi.remoteSSelector)
+           && isSameSelector(firstOsi.localPSelector, secondOsi.localPSelector)
+           && isSameSelector(firstOsi.remotePSelector, secondOsi.remotePSelector);
 }
 
 void IEC61850ClientConfig::logIedConnectionParam(const ServerConnectionParameters &iedConnectionParam)
@@ -401,6 +764,20 @@ void IEC61850ClientConfig::logIedConnectionParam(const ServerConnectionParameter
     Logger::getLogger()->info("Config: Transport Layer:");
     Logger::getLogger()->info("\tIED: IP address:  %s", iedConnectionParam.ipAddress.c_str());
     Logger::getLogger()->info("\tIED: MMS port:    %d", iedConnectionParam.mmsPort);
+    Logger::getLogger()->info("\tIED: timeouts (ms): connect %u, request %u (0: default)",
+                              iedConnectionParam.connectTimeoutInMs,
+                              iedConnectionParam.requestTimeoutInMs);
+    Logger::getLogger()->info("\tIED: reconnect delay (ms): %u to %u",
+                              iedConnectionParam.reconnectMinDelayInMs,
+                              iedConnectionParam.reconnectMaxDelayInMs);
+    Logger::getLogger()->info("\tIED: MMS associations: %u", iedConnectionParam.associationCount);
+    Logger::getLogger()->info("\tIED: proposed MMS PDU size %u, outstanding calls %u (0: default)",
+                              iedConnectionParam.maxPduSize,
+                              iedConnectionParam.maxOutstandingCalls);
+
+    if (! iedConnectionParam.linkGroup.empty()) {
+        Logger::getLogger()->info("\tIED: link group: %s", iedConnectionParam.linkGroup.c_str());
+    }
 
     if (iedConnectionParam.isOsiParametersEnabled) {
         Logger::getLogger()->info("\tIED: local AP Title: %s", iedConnectionParam.osiParameters.localApTitle.c_str());
@@ -567,6 +944,10 @@ void IEC61850ClientConfig::importJsonDatasetConfig(const rapidjson::Value &jsonD
         throw ConfigurationException("the mandatory 'dataset_ref' is empty");
     }
 
+    /** (the bounds of the dataset are given to its selected DO) */
+    PollingPeriodBounds datasetPollingBounds;
+    importJsonPollingPeriodBounds(jsonDatasetConfig, datasetPollingBounds);
+
     std::vector<DatapointConfig> selectedDataObjectList;
 
     if ( (jsonDatasetConfig.HasMember(JSON_DATA_OBJECTS)) &&
@@ -575,6 +956,7 @@ void IEC61850ClientConfig::importJsonDatasetConfig(const rapidjson::Value &jsonD
         for (const auto &jsonDataObject : jsonDatasetConfig[JSON_DATA_OBJECTS].GetArray()) {
 
             DatapointConfig dpConfig;
+            dpConfig.pollingPeriodBounds = datasetPollingBounds;
 
             if (jsonDataObject.HasMember("label")) {
                 dpConfig.label = std::string(jsonDataObject["label"].GetString());
@@ -638,6 +1020,23 @@ void IEC61850ClientConfig::importJsonDatapointProtocolConfig(const rapidjson::Va
     datapointConfig.dataPath = datapointProtocolConfig["address"].GetString();
 
     setDatapointType(datapointProtocolConfig, datapointConfig);
+
+    if (datapointProtocolConfig.HasMember("priority")) {
+        if (! datapointProtocolConfig["priority"].IsString()) {
+            throw ConfigurationException("bad format for 'priority'");
+        }
+
+        std::string priority = datapointProtocolConfig["priority"].GetString();
+        if (priority == "high") {
+            datapointConfig.priority = ReadPriority::HIGH;
+        } else if (priority == "normal") {
+            datapointConfig.priority = ReadPriority::NORMAL;
+        } else {
+            throw ConfigurationException("unknown 'priority': " + priority);
+        }
+    }
+
+    importJsonPollingPeriodBounds(datapointProtocolConfig, datapointConfig.pollingPeriodBounds);
 }
 
 void IEC61850ClientConfig::setDatapointType(const rapidjson::Value &jsonConfig,
@@ -10,17 +10,45 @@
 
 #include "./iec61850_client_connection.h"
 #include "./iec61850_client_config.h"
+#include "./iec61850_log.h"
+#include "./iec61850_probes.h"
+
+#include <algorithm>
+#include <map>
 
 // libiec61850 headers
 #include <libiec61850/iec61850_common.h>
 
+/** Estimated size of an MMS confirmed request, without its variables */
+constexpr std::size_t MMS_REQUEST_HEADER_SIZE = 32;
+/** Estimated size of the ASN.1 tags around the name of a variable */
+constexpr std::size_t MMS_NAME_ENCODING_OVERHEAD = 10;
+
 IEC61850ClientConnection::IEC61850ClientConnection(
-    const ServerConnectionParameters &connParam)
-    : m_connectionParam(connParam)
+    const ServerConnectionParameters &connParam,
+    bool isAsyncConnect,
+    std::function<void()> onConnectionLost)
+    : m_connectionParam(connParam),
+      m_iedKey(IEC61850ClientConfig::buildKey(connParam)),
+      m_onConnectionLost(std::move(onConnectionLost))
 {
     Logger::getLogger()->debug("IEC61850ClientConn: constructor");
     m_iedConnection = IedConnection_create();
-    open();
+
+    /** Track the state without polling the connection */
+    m_connectionState = IedConnection_getState(m_iedConnection);
+    IedConnection_installStateChangedHandler(m_iedConnection, connectionStateChanged, this);
+
+    /** (0: keep the default timeouts of libiec61850) */
+    if (m_connectionParam.connectTimeoutInMs > 0) {
+        IedConnection_setConnectTimeout(m_iedConnection, m_connectionParam.connectTimeoutInMs);
+    }
+
+    if (m_connectionParam.requestTimeoutInMs > 0) {
+        IedConnection_setRequestTimeout(m_iedConnection, m_connectionParam.requestTimeoutInMs);
+    }
+
+    open(isAsyncConnect);
 }
 
 IEC61850ClientConnection::~IEC61850ClientConnection()
@@ -30,18 +58,117 @@ IEC61850ClientConnection::~IEC61850ClientConnection()
     IedConnection_destroy(m_iedConnection);
 }
 
-bool IEC61850ClientConnection::isNoError() const
+bool IEC61850ClientConnection::isConnected()
 {
-    return (m_networkStack_error == IED_ERROR_OK);
+    return (m_connectionState == IED_STATE_CONNECTED);
 }
 
-bool IEC61850ClientConnection::isConnected()
+bool IEC61850ClientConnection::isConnecting()
+{
+    return (m_connectionState == IED_STATE_CONNECTING);
+}
+
+unsigned int IEC61850ClientConnection::getNegotiatedMaxPduSize()
+{
+    return m_negotiatedMaxPduSize;
+}
+
+RequestLatencies IEC61850ClientConnection::getRequestLatencies() const
+{
+    return m_requestScheduler.getLatencies();
+}
+
+ResponseTimeSummary IEC61850ClientConnection::takeResponseTimes()
+{
+    return m_requestScheduler.takeResponseTimes();
+}
+
+void IEC61850ClientConnection::recordRequestError(IedClientError error)
+{
+    if (error == IED_ERROR_TIMEOUT) {
+        m_requestScheduler.recordTimeout();
+    }
+}
+
+IedClientError IEC61850ClientConnection::toRequestError(MmsError mmsError)
+{
+    switch (mmsError) {
+        case MMS_ERROR_NONE:
+            /** (answered, but not with the expected values) */
+            return IED_ERROR_UNEXPECTED_VALUE_RECEIVED;
+
+        case MMS_ERROR_SERVICE_TIMEOUT:
+            return IED_ERROR_TIMEOUT;
+
+        case MMS_ERROR_CONNECTION_LOST:
+            return IED_ERROR_CONNECTION_LOST;
+
+        default:
+            return IED_ERROR_UNKNOWN;
+    }
+}
+
+void IEC61850ClientConnection::connectionStateChanged(void *parameter,
+                                                      IedConnection iedConnection,
+                                                      IedConnectionState newState)
+{
+    auto *connection = static_cast<IEC61850ClientConnection *>(parameter);
+    IedConnectionState previousState = connection->m_connectionState.exchange(newState);
+
+    if ( (newState == IED_STATE_CONNECTED) && (previousState != IED_STATE_CONNECTED)) {
+        connection->updateNegotiatedParameters(iedConnection);
+    }
+
+    /** A lost connection is reestablished at once, not at the next reading cycle */
+    if ( (previousState == IED_STATE_CONNECTED) && (newState != IED_STATE_CONNECTED)) {
+        Logger::getLogger()->warn("IEC61850ClientConn: connection with %s:%d closed",
+                                  connection->m_connectionParam.ipAddress.c_str(),
+                                  connection->m_connectionParam.mmsPort);
+
+        if (connection->m_onConnectionLost) {
+            connection->m_onConnectionLost();
+        }
+    }
+}
+
+void IEC61850ClientConnection::updateNegotiatedParameters(IedConnection connection)
+{
+    MmsConnection mmsConnection = IedConnection_getMmsConnection(connection);
+    MmsConnectionParameters negotiatedParams = MmsConnection_getMmsConnectionParameters(mmsConnection);
+
+    m_negotiatedMaxPduSize = static_cast<unsigned int>(std::max(0, negotiatedParams.maxPduSize));
+
+    Logger::getLogger()->info("IEC61850ClientConn: negotiated with %s:%d: PDU size %d, "
+                              "outstanding calls %d (calling) %d (called), nesting level %d",
+                              m_connectionParam.ipAddress.c_str(),
+                              m_connectionParam.mmsPort,
+                              negotiatedParams.maxPduSize,
+                              negotiatedParams.maxServOutstandingCalling,
+                              negotiatedParams.maxServOutstandingCalled,
+                              negotiatedParams.dataStructureNestingLevel);
+}
+
+bool IEC61850ClientConnection::keepAlive()
 {
+    // Preconditions
+    if (! isConnected()) {
+        return false;
+    }
+
+    MmsError mmsError = MMS_ERROR_NONE;
+    IEC61850RequestScheduler::Turn turn(m_requestScheduler, ReadPriority::NORMAL);
     std::unique_lock<std::mutex> connectionGuard(m_iedConnectionMutex);
-    return (IedConnection_getState(m_iedConnection) == IED_STATE_CONNECTED);
+    MmsConnection mmsConnection = IedConnection_getMmsConnection(m_iedConnection);
+    MmsServerIdentity *identity = MmsConnection_identify(mmsConnection, &mmsError);
+
+    if (identity != nullptr) {
+        MmsServerIdentity_destroy(identity);
+    }
+
+    return (mmsError == MMS_ERROR_NONE);
 }
 
-void IEC61850ClientConnection::open()
+void IEC61850ClientConnection::open(bool isAsyncConnect)
 {
     Logger::getLogger()->debug("IEC61850ClientConn: open");
     std::unique_lock<std::mutex> connectionGuard(m_iedConnectionMutex);
@@ -53,10 +180,44 @@ void IEC61850ClientConnection::open()
         setOsiConnectionParameters();
     }
 
-    IedConnection_connect(m_iedConnection,
-                          &m_networkStack_error,
-                          m_connectionParam.ipAddress.c_str(),
-                          m_connectionParam.mmsPort);
+    setMmsConnectionParameters();
+
+    IedClientError error = IED_ERROR_OK;
+    IEC61850_PROBE_TIMER(openTimer, open_done);
+    IEC61850_PROBE2(open_start, m_iedKey.c_str(), m_connectionParam.mmsPort);
+
+    if (isAsyncConnect) {
+        /** The result comes later, through the state of the connection */
+        IedConnection_connectAsync(m_iedConnection,
+                                   &error,
+                                   m_connectionParam.ipAddress.c_str(),
+                                   m_connectionParam.mmsPort);
+    } else {
+        IedConnection_connect(m_iedConnection,
+                              &error,
+                              m_connectionParam.ipAddress.c_str(),
+                              m_connectionParam.mmsPort);
+    }
+
+    /** (asynchronous: the duration of the connection request only) */
+    IEC61850_PROBE3(open_done, m_iedKey.c_str(), static_cast<int>(error), IEC61850_PROBE_ELAPSED_US(openTimer));
+    recordRequestError(error);
+}
+
+void IEC61850ClientConnection::setMmsConnectionParameters()
+{
+    MmsConnection mmsConnection = IedConnection_getMmsConnection(m_iedConnection);
+
+    /** (0: keep the default values of libiec61850) */
+    /** The IED may accept lower values: see 'updateNegotiatedParameters' */
+    if (m_connectionParam.maxPduSize > 0) {
+        MmsConnection_setLocalDetail(mmsConnection, static_cast<int32_t>(m_connectionParam.maxPduSize));
+    }
+
+    if (m_connectionParam.maxOutstandingCalls > 0) {
+        int maxOutstandingCalls = static_cast<int>(m_connectionParam.maxOutstandingCalls);
+        IedConnection_setMaxOutstandingCalls(m_iedConnection, maxOutstandingCalls, maxOutstandingCalls);
+    }
 }
 
 void IEC61850ClientConnection::setOsiConnectionParameters()
@@ -99,37 +260,68 @@ void IEC61850ClientConnection::close()
 
 std::shared_ptr<WrappedMms>
 IEC61850ClientConnection::readDO(const std::string &doPath,
-                                 const FunctionalConstraint &functionalConstraint)
+                                 const FunctionalConstraint &functionalConstraint,
+                                 IedClientError &error)
 {
     // Preconditions
     if (! isConnected()) {
+        error = IED_ERROR_NOT_CONNECTED;
         return nullptr;
     }
 
     auto wrapped_mms = std::make_shared<WrappedMms>();
-    std::unique_lock<std::mutex> connectionGuard(m_iedConnectionMutex);
-    wrapped_mms->setMmsValue(IedConnection_readObject(m_iedConnection,
-                             &m_networkStack_error,
-                             doPath.c_str(),
-                             functionalConstraint));
+    error = IED_ERROR_OK;
+    IEC61850_PROBE_TIMER(readTimer, read_do_done);
+    IEC61850_PROBE3(read_do_start, m_iedKey.c_str(), doPath.c_str(),
+                    MMS_REQUEST_HEADER_SIZE + MMS_NAME_ENCODING_OVERHEAD + doPath.size());
+    {
+        IEC61850RequestScheduler::Turn turn(m_requestScheduler, ReadPriority::NORMAL);
+        std::unique_lock<std::mutex> connectionGuard(m_iedConnectionMutex);
+        wrapped_mms->setMmsValue(IedConnection_readObject(m_iedConnection,
+                                 &error,
+                                 doPath.c_str(),
+                                 functionalConstraint));
+    }
+
+    IEC61850_PROBE4(read_do_done, m_iedKey.c_str(), doPath.c_str(), static_cast<int>(error),
+                    IEC61850_PROBE_ELAPSED_US(readTimer));
+    recordRequestError(error);
     return wrapped_mms;
 }
 
 std::shared_ptr<WrappedMms>
-IEC61850ClientConnection::readDataset(const std::string &datasetRef)
+IEC61850ClientConnection::readDataset(const std::string &datasetRef,
+                                      IedClientError &error)
 {
     // Preconditions
     if (! isConnected()) {
+        error = IED_ERROR_NOT_CONNECTED;
         return nullptr;
     }
 
     auto wrapped_mms = std::make_shared<WrappedMms>();
-    std::unique_lock<std::mutex> connectionGuard(m_iedConnectionMutex);
+    error = IED_ERROR_OK;
+    ClientDataSet readDataset = nullptr;
+    IEC61850_PROBE_TIMER(readTimer, read_dataset_done);
+    IEC61850_PROBE3(read_dataset_start, m_iedKey.c_str(), datasetRef.c_str(),
+                    MMS_REQUEST_HEADER_SIZE + MMS_NAME_ENCODING_OVERHEAD + datasetRef.size());
+    {
+        IEC61850RequestScheduler::Turn turn(m_requestScheduler, ReadPriority::NORMAL);
+        std::unique_lock<std::mutex> connectionGuard(m_iedConnectionMutex);
+        readDataset = IedConnection_readDataSetValues(m_iedConnection,
+                                                      &error,
+                                                      datasetRef.c_str(),
+                                                      nullptr);
+    }
+
+    IEC61850_PROBE5(read_dataset_done, m_iedKey.c_str(), datasetRef.c_str(), static_cast<int>(error),
+                    readDataset ? MmsValue_getArraySize(ClientDataSet_getValues(readDataset)) : 0,
+                    IEC61850_PROBE_ELAPSED_US(readTimer));
+    recordRequestError(error);
 
-    ClientDataSet readDataset = IedConnection_readDataSetValues(m_iedConnection,
-                                                                &m_networkStack_error,
-                                                                datasetRef.c_str(),
-                                                                nullptr);
+    if (readDataset == nullptr) {
+        return wrapped_mms;
+    }
 
     /** Keep only the MmsValue, not the full ClientDataSet structure */
     wrapped_mms->setMmsValue(MmsValue_clone(ClientDataSet_getValues(readDataset)));
@@ -138,56 +330,238 @@ IEC61850ClientConnection::readDataset(const std::string &datasetRef)
     return wrapped_mms;
 }
 
-void
+std::shared_ptr<WrappedMms>
+IEC61850ClientConnection::readMultipleDO(const std::vector<std::string> &doPathListWithFC,
+                                         ReadPriority priority,
+                                         IedClientError &error)
+{
+    // Preconditions
+    if (! isConnected()) {
+        error = IED_ERROR_NOT_CONNECTED;
+        return nullptr;
+    }
+
+    error = IED_ERROR_OK;
+
+    auto wrapped_mms = std::make_shared<WrappedMms>();
+
+    /** Group the MMS variables by domain: 1 request per logical device */
+    std::map<std::string, std::vector<std::size_t>, std::less<>> indexesByDomain;
+    std::vector<std::string> itemIds(doPathListWithFC.size());
+
+    for (std::size_t index = 0; index < doPathListWithFC.size(); ++index) {
+        std::string domainId;
+
+        if (! toMmsVariableName(doPathListWithFC[index], domainId, itemIds[index])) {
+            Logger::getLogger()->error("IEC61850ClientConn: invalid DO reference %s",
+                                       doPathListWithFC[index].c_str());
+            error = IED_ERROR_OBJECT_REFERENCE_INVALID;
+            return wrapped_mms;
+        }
+
+        indexesByDomain[domainId].push_back(index);
+    }
+
+    MmsValue *allValues = MmsValue_createEmptyArray(static_cast<int>(doPathListWithFC.size()));
+
+    for (const auto &it : indexesByDomain) {
+        /** Several requests if the DO of the domain do not fit in 1 PDU */
+        std::vector<std::string> domainDoPaths;
+        domainDoPaths.reserve(it.second.size());
+
+        for (std::size_t index : it.second) {
+            domainDoPaths.push_back(doPathListWithFC[index]);
+        }
+
+        std::size_t batchBegin = 0;
+
+        for (std::size_t batchSize : splitIntoBatches(domainDoPaths, m_negotiatedMaxPduSize)) {
+            /** 1 turn per batch: a high priority request can be sent before the next batch */
+            IEC61850RequestScheduler::Turn turn(m_requestScheduler, priority);
+            std::unique_lock<std::mutex> connectionGuard(m_iedConnectionMutex);
+            MmsConnection mmsConnection = IedConnection_getMmsConnection(m_iedConnection);
+
+            /** The list only references the strings, it does not own them */
+            LinkedList items = LinkedList_create();
+
+            for (std::size_t rank = batchBegin; rank < batchBegin + batchSize; ++rank) {
+                LinkedList_add(items, const_cast<char*>(itemIds[it.second[rank]].c_str()));
+            }
+
+            MmsError mmsError = MMS_ERROR_NONE;
+            MmsValue *batchValues = MmsConnection_readMultipleVariables(mmsConnection,
+                                                                        &mmsError,
+                                                                        it.first.c_str(),
+                                                                        items);
+            LinkedList_destroyStatic(items);
+
+            if ( (mmsError != MMS_ERROR_NONE) || (batchValues == nullptr)
+                    || (MmsValue_getArraySize(batchValues) != batchSize)) {
+                error = toRequestError(mmsError);
+                recordRequestError(error);
+
+                IEC61850_LOG_RATE_LIMITED_ERROR("IEC61850ClientConn: failed to read the DO of %s (MMS error %d)",
+                                                it.first.c_str(), mmsError);
+
+                if (batchValues) {
+                    MmsValue_delete(batchValues);
+                }
+
+                MmsValue_delete(allValues);
+                return wrapped_mms;
+            }
+
+            /** Move each element at its place in the global result */
+            for (std::size_t rank = 0; rank < batchSize; ++rank) {
+                MmsValue_setElement(allValues, static_cast<int>(it.second[batchBegin + rank]),
+                                    MmsValue_getElement(batchValues, static_cast<int>(rank)));
+                MmsValue_setElement(batchValues, static_cast<int>(rank), nullptr);
+            }
+
+            MmsValue_delete(batchValues);
+            batchBegin += batchSize;
+        }
+    }
+
+    wrapped_mms->setMmsValue(allValues);
+    return wrapped_mms;
+}
+
+std::vector<std::size_t>
+IEC61850ClientConnection::splitIntoBatches(const std::vector<std::string> &names,
+                                           unsigned int maxPduSize)
+{
+    std::vector<std::size_t> batchSizes;
+    std::size_t batchSize = 0;
+    std::size_t requestSize = MMS_REQUEST_HEADER_SIZE;
+
+    for (const auto &name : names) {
+        std::size_t nameSize = name.size() + MMS_NAME_ENCODING_OVERHEAD;
+
+        /** (a name too long for any PDU is sent alone: the IED decides) */
+        if ( (maxPduSize > 0) && (batchSize > 0) && (requestSize + nameSize > maxPduSize)) {
+            batchSizes.push_back(batchSize);
+            batchSize = 0;
+            requestSize = MMS_REQUEST_HEADER_SIZE;
+        }
+
+        batchSize++;
+        requestSize += nameSize;
+    }
+
+    if (batchSize > 0) {
+        batchSizes.push_back(batchSize);
+    }
+
+    return batchSizes;
+}
+
+bool
+IEC61850ClientConnection::toMmsVariableName(const std::string &doPathWithFC,
+                                            std::string &domainId,
+                                            std::string &itemId)
+{
+    std::size_t domainEnd = doPathWithFC.find('/');
+    std::size_t fcBegin = doPathWithFC.find('[', domainEnd);
+    std::size_t fcEnd = doPathWithFC.find(']', fcBegin);
+
+    if ( (domainEnd == std::string::npos) || (fcBegin == std::string::npos)
+            || (fcEnd == std::string::npos)) {
+        return false;
+    }
+
+    std::size_t lnEnd = doPathWithFC.find('.', domainEnd);
+
+    if ( (lnEnd == std::string::npos) || (lnEnd > fcBegin)) {
+        return false;
+    }
+
+    domainId.assign(doPathWithFC, 0, domainEnd);
+
+    /** 'LN' + '$FC$' + 'DO.SDO' with '.' replaced by '$' */
+    itemId.assign(doPathWithFC, domainEnd + 1, lnEnd - domainEnd - 1);
+    itemId.append("$");
+    itemId.append(doPathWithFC, fcBegin + 1, fcEnd - fcBegin - 1);
+    itemId.append("$");
+    std::size_t doBegin = itemId.size();
+    itemId.append(doPathWithFC, lnEnd + 1, fcBegin - lnEnd - 1);
+    std::replace(itemId.begin() + doBegin, itemId.end(), '.', '$');
+
+    return true;
+}
+
+bool
 IEC61850ClientConnection::buildNameTree(const std::string &pathInDatamodel,
                                         const FunctionalConstraint &functionalConstraint,
                                         MmsNameNode *nameTree)
 {
     // Preconditions
     if (! nameTree) {
-        return;
+        return false;
     }
     if (! isConnected()) {
-        return;
+        return false;
     }
 
-    LinkedList dataAttributes = nullptr;
-    dataAttributes = getDataDirectory(pathInDatamodel, functionalConstraint);
-
-    if (dataAttributes != nullptr) {
-        LinkedList dataAttribute = LinkedList_getNext(dataAttributes);
-
-        while (dataAttribute != nullptr) {
-            std::string daName(static_cast<char*>(dataAttribute->data));
-
-            auto newNameNode = std::make_shared<MmsNameNode>();
-            newNameNode->mmsName = daName;
+    /** A local error: an unknown DO must not stop the other readings */
+    IedClientError error = IED_ERROR_OK;
+    MmsVariableSpecification *specification = nullptr;
+
+    {
+        IEC61850RequestScheduler::Turn turn(m_requestScheduler, ReadPriority::NORMAL);
+        std::unique_lock<std::mutex> connectionGuard(m_iedConnectionMutex);
+        specification = IedConnection_getVariableSpecification(m_iedConnection,
+                                                               &error,
+                                                               pathInDatamodel.c_str(),
+                                                               functionalConstraint);
+    }
 
-            buildNameTree(pathInDatamodel + "." + daName,
-                          functionalConstraint,
-                          newNameNode.get());
+    if ( (error != IED_ERROR_OK) || (specification == nullptr)) {
+        Logger::getLogger()->warn("IEC61850ClientConn: no specification for %s (error %d)",
+                                  pathInDatamodel.c_str(), error);
 
-            nameTree->children.push_back(std::move(newNameNode));
-            dataAttribute = LinkedList_getNext(dataAttribute);
+        if (specification) {
+            MmsVariableSpecification_destroy(specification);
         }
 
-        LinkedList_destroy(dataAttributes);
+        /** The IED answered that the DO does not exist: its tree stays empty */
+        return (error == IED_ERROR_OBJECT_DOES_NOT_EXIST);
     }
+
+    buildNameTreeFromSpecification(specification, nameTree);
+    MmsVariableSpecification_destroy(specification);
+    return true;
 }
 
-LinkedList
-IEC61850ClientConnection::getDataDirectory(const std::string &pathInDatamodel,
-                                           const FunctionalConstraint &functionalConstraint)
+void
+IEC61850ClientConnection::buildNameTreeFromSpecification(MmsVariableSpecification *specification,
+                                                         MmsNameNode *nameTree)
 {
-    std::unique_lock<std::mutex> connectionGuard(m_iedConnectionMutex);
-    LinkedList dataAttributes = nullptr;
+    /** Only the structure components are named: the leaves and arrays have no child */
+    if (MmsVariableSpecification_getType(specification) != MMS_STRUCTURE) {
+        return;
+    }
 
-    dataAttributes = IedConnection_getDataDirectoryByFC(m_iedConnection,
-                                                        &m_networkStack_error,
-                                                        pathInDatamodel.c_str(),
-                                                        functionalConstraint);
+    int componentCount = MmsVariableSpecification_getSize(specification);
 
-    return dataAttributes;
+    for (int index = 0; index < componentCount; ++index) {
+        MmsVariableSpecification *component =
+            MmsVariableSpecification_getChildSpecificationByIndex(specification, index);
+
+        if (component == nullptr) {
+            continue;
+        }
+
+        auto newNameNode = std::make_shared<MmsNameNode>();
+        const char *componentName = MmsVariableSpecification_getName(component);
+
+        if (componentName) {
+            newNameNode->mmsName = componentName;
+        }
+
+        buildNameTreeFromSpecification(component, newNameNode.get());
+        nameTree->children.push_back(std::move(newNameNode));
+    }
 }
 
 std::vector<std::string>
@@ -219,12 +593,80 @@ IEC61850ClientConnection::getDoPathListWithFCFromDataset(const std::string &data
 LinkedList
 IEC61850ClientConnection::getDataSetDirectory(const std::string &datasetRef)
 {
-    std::unique_lock<std::mutex> connectionGuard(m_iedConnectionMutex);
+    IedClientError error = IED_ERROR_OK;
     LinkedList dataSetMembers = nullptr;
-    dataSetMembers = IedConnection_getDataSetDirectory(m_iedConnection,
-                                                       &m_networkStack_error,
-                                                       datasetRef.c_str(),
-                                                       nullptr);
+    {
+        IEC61850RequestScheduler::Turn turn(m_requestScheduler, ReadPriority::NORMAL);
+        std::unique_lock<std::mutex> connectionGuard(m_iedConnectionMutex);
+        dataSetMembers = IedConnection_getDataSetDirectory(m_iedConnection,
+                                                           &error,
+                                                           datasetRef.c_str(),
+                                                           nullptr);
+    }
 
+    recordRequestError(error);
     return dataSetMembers;
 }
+
+bool
+IEC61850ClientConnection::createDataset(const std::string &datasetRef,
+                                        const std::vector<std::string> &doPathListWithFC)
+{
+    // Preconditions
+    if (! isConnected()) {
+        return false;
+    }
+
+    /** The list only references the strings, it does not own them */
+    LinkedList dataSetElements = LinkedList_create();
+
+    for (const auto &doPathWithFC : doPathListWithFC) {
+        LinkedList_add(dataSetElements, const_cast<char*>(doPathWithFC.c_str()));
+    }
+
+    IedClientError error = IED_ERROR_OK;
+    {
+        IEC61850RequestScheduler::Turn turn(m_requestScheduler, ReadPriority::NORMAL);
+        std::unique_lock<std::mutex> connectionGuard(m_iedConnectionMutex);
+        IedConnection_createDataSet(m_iedConnection,
+                                    &error,
+                                    datasetRef.c_str(),
+                                    dataSetElements);
+    }
+
+    LinkedList_destroyStatic(dataSetElements);
+
+    if (error != IED_ERROR_OK) {
+        Logger::getLogger()->warn("IEC61850ClientConn: creation of dataset %s refused (error %d)",
+                                  datasetRef.c_str(), error);
+        return false;
+    }
+
+    return true;
+}
+
+bool
+IEC61850ClientConnection::deleteDataset(const std::string &datasetRef)
+{
+    // Preconditions
+    if (! isConnected()) {
+        return false;
+    }
+
+    IedClientError error = IED_ERROR_OK;
+    {
+        IEC61850RequestScheduler::Turn turn(m_requestScheduler, ReadPriority::NORMAL);
+        std::unique_lock<std::mutex> connectionGuard(m_iedConnectionMutex);
+        IedConnection_deleteDataSet(m_iedConnection,
+                                    &error,
+                                    datasetRef.c_str());
+    }
+
+    if (error != IED_ERROR_OK) {
+        Logger::getLogger()->warn("IEC61850ClientConn: deletion of dataset %s refused (error %d)",
+                                  datasetRef.c_str(), error);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,244 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./iec61850_client_connection_pool.h"
+#include "./iec61850_client_connection.h"
+
+#include <algorithm>
+#include <utility>
+
+IEC61850ClientConnectionPool::IEC61850ClientConnectionPool(const ServerConnectionParameters &connParam,
+                                                           bool isAsyncConnect,
+                                                           const std::function<void()> &onConnectionLost)
+{
+    unsigned int associationCount = std::max(1u, connParam.associationCount);
+    Logger::getLogger()->info("IEC61850ClientConnPool: open %u associations", associationCount);
+
+    for (unsigned int index = 0; index < associationCount; ++index) {
+        m_associations.push_back(std::make_unique<IEC61850ClientConnection>(connParam,
+                                                                            isAsyncConnect,
+                                                                            onConnectionLost));
+    }
+
+    m_isAssociationBusy.resize(m_associations.size(), false);
+}
+
+IEC61850ClientConnectionPool::IEC61850ClientConnectionPool(
+    std::vector<std::unique_ptr<IEC61850ClientConnectionInterface>> associations)
+    : m_associations(std::move(associations))
+{
+    m_isAssociationBusy.resize(m_associations.size(), false);
+}
+
+bool IEC61850ClientConnectionPool::isConnected()
+{
+    return std::all_of(m_associations.begin(), m_associations.end(),
+                       [](const std::unique_ptr<IEC61850ClientConnectionInterface> &association) {
+                           return association->isConnected();
+                       });
+}
+
+bool IEC61850ClientConnectionPool::isConnecting()
+{
+    return std::any_of(m_associations.begin(), m_associations.end(),
+                       [](const std::unique_ptr<IEC61850ClientConnectionInterface> &association) {
+                           return association->isConnecting();
+                       });
+}
+
+bool IEC61850ClientConnectionPool::keepAlive()
+{
+    return std::all_of(m_associations.begin(), m_associations.end(),
+                       [](const std::unique_ptr<IEC61850ClientConnectionInterface> &association) {
+                           return association->keepAlive();
+                       });
+}
+
+unsigned int IEC61850ClientConnectionPool::getNegotiatedMaxPduSize()
+{
+    unsigned int maxPduSize = 0;
+
+    for (const auto &association : m_associations) {
+        unsigned int associationPduSize = association->getNegotiatedMaxPduSize();
+
+        if (associationPduSize == 0) {
+            return 0;
+        }
+
+        if ( (maxPduSize == 0) || (associationPduSize < maxPduSize)) {
+            maxPduSize = associationPduSize;
+        }
+    }
+
+    return maxPduSize;
+}
+
+RequestLatencies IEC61850ClientConnectionPool::getRequestLatencies() const
+{
+    RequestLatencies latencies;
+
+    for (const auto &association : m_associations) {
+        RequestLatencies associationLatencies = association->getRequestLatencies();
+
+        for (std::size_t priority = 0; priority < latencies.size(); ++priority) {
+            latencies[priority].merge(associationLatencies[priority]);
+        }
+    }
+
+    return latencies;
+}
+
+ResponseTimeSummary IEC61850ClientConnectionPool::takeResponseTimes()
+{
+    ResponseTimeSummary responseTimes;
+
+    for (const auto &association : m_associations) {
+        responseTimes.merge(association->takeResponseTimes());
+    }
+
+    return responseTimes;
+}
+
+std::size_t IEC61850ClientConnectionPool::acquireAssociation(ReadPriority priority)
+{
+    std::unique_lock<std::mutex> guard(m_mutex);
+    std::size_t associationIndex = 0;
+    bool isHighPriority = (priority == ReadPriority::HIGH);
+
+    if (isHighPriority) {
+        m_highPriorityWaitingCount++;
+    }
+
+    /** A normal request gives way to any waiting high priority request */
+    m_associationReleased.wait(guard, [this, &associationIndex, isHighPriority] {
+        if ( (! isHighPriority) && (m_highPriorityWaitingCount > 0)) {
+            return false;
+        }
+
+        auto freeIt = std::find(m_isAssociationBusy.begin(), m_isAssociationBusy.end(), false);
+        associationIndex = static_cast<std::size_t>(freeIt - m_isAssociationBusy.begin());
+        return (freeIt != m_isAssociationBusy.end());
+    });
+
+    if (isHighPriority) {
+        m_highPriorityWaitingCount--;
+    }
+
+    m_isAssociationBusy[associationIndex] = true;
+    return associationIndex;
+}
+
+void IEC61850ClientConnectionPool::releaseAssociation(std::size_t associationIndex)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_isAssociationBusy[associationIndex] = false;
+    }
+
+    m_associationReleased.notify_all();
+}
+
+template <typename Request>
+auto IEC61850ClientConnectionPool::sendOnFreeAssociation(Request request, ReadPriority priority)
+-> decltype(request(std::declval<IEC61850ClientConnectionInterface &>()))
+{
+    /** Release the association, even on exception */
+    struct AssociationGuard {
+        IEC61850ClientConnectionPool &pool;
+        std::size_t index;
+        ~AssociationGuard()
+        {
+            pool.releaseAssociation(index);
+        }
+    } associationGuard{*this, acquireAssociation(priority)};
+
+    return request(*m_associations[associationGuard.index]);
+}
+
+std::shared_ptr<WrappedMms>
+IEC61850ClientConnectionPool::readDO(const std::string &doPath,
+                                     const FunctionalConstraint &functionalConstraint,
+                                     IedClientError &error)
+{
+    return sendOnFreeAssociation([&doPath, &functionalConstraint, &error](IEC61850ClientConnectionInterface & association) {
+        return association.readDO(doPath, functionalConstraint, error);
+    });
+}
+
+std::shared_ptr<WrappedMms>
+IEC61850ClientConnectionPool::readDataset(const std::string &datasetRef,
+                                          IedClientError &error)
+{
+    return sendOnFreeAssociation([&datasetRef, &error](IEC61850ClientConnectionInterface & association) {
+        return association.readDataset(datasetRef, error);
+    });
+}
+
+std::shared_ptr<WrappedMms>
+IEC61850ClientConnectionPool::readMultipleDO(const std::vector<std::string> &doPathListWithFC,
+                                             ReadPriority priority,
+                                             IedClientError &error)
+{
+    return sendOnFreeAssociation([&doPathListWithFC, priority, &error](IEC61850ClientConnectionInterface & association) {
+        return association.readMultipleDO(doPathListWithFC, priority, error);
+    }, priority);
+}
+
+bool
+IEC61850ClientConnectionPool::buildNameTree(const std::string &pathInDatamodel,
+                                            const FunctionalConstraint &functionalConstraint,
+                                            MmsNameNode *nameTree)
+{
+    return sendOnFreeAssociation([&](IEC61850ClientConnectionInterface & association) {
+        return association.buildNameTree(pathInDatamodel, functionalConstraint, nameTree);
+    });
+}
+
+std::vector<std::string>
+IEC61850ClientConnectionPool::getDoPathListWithFCFromDataset(const std::string &datasetRef)
+{
+    return sendOnFreeAssociation([&datasetRef](IEC61850ClientConnectionInterface & association) {
+        return association.getDoPathListWithFCFromDataset(datasetRef);
+    });
+}
+
+bool
+IEC61850ClientConnectionPool::createDataset(const std::string &datasetRef,
+                                            const std::vector<std::string> &doPathListWithFC)
+{
+    /** The dataset is specific to an association: each one needs its own */
+    std::size_t createdCount = 0;
+
+    while ( (createdCount < m_associations.size())
+            && m_associations[createdCount]->createDataset(datasetRef, doPathListWithFC)) {
+        createdCount++;
+    }
+
+    if (createdCount == m_associations.size()) {
+        return true;
+    }
+
+    /** A dataset missing on 1 association is not used: do not leave it on the others */
+    for (std::size_t index = 0; index < createdCount; ++index) {
+        m_associations[index]->deleteDataset(datasetRef);
+    }
+
+    return false;
+}
+
+bool
+IEC61850ClientConnectionPool::deleteDataset(const std::string &datasetRef)
+{
+    bool isDeleted = true;
+
+    for (const auto &association : m_associations) {
+        isDeleted = association->deleteDataset(datasetRef) && isDeleted;
+    }
+
+    return isDeleted;
+}
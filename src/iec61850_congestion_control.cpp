@@ -0,0 +1,103 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./iec61850_congestion_control.h"
+
+#include <algorithm>
+
+/** Rate recovered after a cycle without congestion, in fraction of the nominal rate */
+constexpr double RATE_INCREASE = 0.1;
+
+void IEC61850CongestionControl::setParameters(const CongestionControlParameters &params, unsigned int maxWindow)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_params = params;
+    m_maxWindow = std::max(1u, maxWindow);
+    m_state.slowdown = 1.0;
+    m_state.window = m_maxWindow;
+    m_state.isCongested = false;
+}
+
+bool IEC61850CongestionControl::update(const ResponseTimeSummary &responseTimes)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    if ( (! m_params.isEnabled) || ( (responseTimes.responseCount == 0) && (responseTimes.timeoutCount == 0))) {
+        return m_state.isCongested;
+    }
+
+    std::chrono::microseconds meanResponseTime = responseTimes.getMeanResponseTime();
+
+    if (responseTimes.responseCount > 0) {
+        /** The baseline follows the fastest responses, and ages slowly (the IED or the link may change) */
+        if ( (m_state.baselineResponseTime.count() == 0) || (meanResponseTime < m_state.baselineResponseTime)) {
+            m_state.baselineResponseTime = meanResponseTime;
+        } else {
+            m_state.baselineResponseTime += (meanResponseTime - m_state.baselineResponseTime) / 64;
+        }
+
+        if (m_state.smoothedResponseTime.count() == 0) {
+            m_state.smoothedResponseTime = meanResponseTime;
+        } else {
+            m_state.smoothedResponseTime += (meanResponseTime - m_state.smoothedResponseTime) / 8;
+        }
+    }
+
+    std::chrono::microseconds threshold = (m_params.responseTimeThresholdInMs > 0)
+                                          ? std::chrono::microseconds(std::chrono::milliseconds(m_params.responseTimeThresholdInMs))
+                                          : m_state.baselineResponseTime * 4;
+
+    m_state.isCongested = (responseTimes.timeoutCount > 0) || (meanResponseTime > threshold);
+
+    if (m_state.isCongested) {
+        decrease();
+    } else {
+        m_state.slowdown = std::max(1.0, 1.0 / (1.0 / m_state.slowdown + RATE_INCREASE));
+        m_state.window = std::min(m_maxWindow, m_state.window + 1);
+    }
+
+    return m_state.isCongested;
+}
+
+void IEC61850CongestionControl::recordConnectionLoss()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    if (! m_params.isEnabled) {
+        return;
+    }
+
+    m_state.isCongested = true;
+    m_state.smoothedResponseTime = std::chrono::microseconds(0);
+    decrease();
+}
+
+void IEC61850CongestionControl::decrease()
+{
+    m_state.congestionCount++;
+    m_state.slowdown = std::min(static_cast<double>(std::max(1u, m_params.maxSlowdown)), m_state.slowdown * 2.0);
+    m_state.window = std::max(1u, m_state.window / 2);
+}
+
+std::chrono::milliseconds IEC61850CongestionControl::scalePeriod(std::chrono::milliseconds period) const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return std::chrono::milliseconds(static_cast<int64_t>(static_cast<double>(period.count()) * m_state.slowdown));
+}
+
+unsigned int IEC61850CongestionControl::getWindow() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_params.isEnabled ? m_state.window : m_maxWindow;
+}
+
+CongestionState IEC61850CongestionControl::getState() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_state;
+}
@@ -0,0 +1,123 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./iec61850_discovery_coordinator.h"
+
+#include <algorithm>
+
+/** Period of the stop order check, while waiting for a slot */
+constexpr const std::chrono::milliseconds STOP_ORDER_CHECK_PERIOD(100);
+
+IEC61850DiscoveryCoordinator::IEC61850DiscoveryCoordinator(unsigned int maxConcurrentDiscoveries)
+    : m_maxConcurrentDiscoveries(maxConcurrentDiscoveries)
+{
+}
+
+IEC61850DiscoveryCoordinator::Ticket
+IEC61850DiscoveryCoordinator::enqueue(std::size_t pointCount)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    Ticket ticket = m_nextTicket++;
+    m_waitingRequests.emplace(pointCount, ticket);
+    m_pointCountByTicket[ticket] = pointCount;
+
+    return ticket;
+}
+
+bool IEC61850DiscoveryCoordinator::waitForSlot(Ticket ticket,
+                                               std::chrono::milliseconds timeout,
+                                               const std::atomic<bool> &stopOrder)
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    std::unique_lock<std::mutex> guard(m_mutex);
+
+    auto ticketIt = m_pointCountByTicket.find(ticket);
+    if (ticketIt == m_pointCountByTicket.end()) {
+        return false;
+    }
+
+    const std::pair<std::size_t, Ticket> request(ticketIt->second, ticket);
+
+    while (! stopOrder) {
+        if (isGrantable(request)) {
+            m_waitingRequests.erase(request);
+            m_pointCountByTicket.erase(ticket);
+            m_runningDiscoveries++;
+
+            /** The next request may get a free slot too */
+            m_slotReleased.notify_all();
+            return true;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            break;
+        }
+
+        m_slotReleased.wait_until(guard, std::min(deadline, now + STOP_ORDER_CHECK_PERIOD));
+    }
+
+    return false;
+}
+
+void IEC61850DiscoveryCoordinator::release()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        if (m_runningDiscoveries > 0) {
+            m_runningDiscoveries--;
+        }
+    }
+
+    m_slotReleased.notify_all();
+}
+
+void IEC61850DiscoveryCoordinator::cancel(Ticket ticket)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        auto ticketIt = m_pointCountByTicket.find(ticket);
+        if (ticketIt == m_pointCountByTicket.end()) {
+            return;
+        }
+
+        m_waitingRequests.erase(std::make_pair(ticketIt->second, ticket));
+        m_pointCountByTicket.erase(ticketIt);
+    }
+
+    /** The next request may be grantable now */
+    m_slotReleased.notify_all();
+}
+
+void IEC61850DiscoveryCoordinator::setMaxConcurrentDiscoveries(unsigned int maxConcurrentDiscoveries)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_maxConcurrentDiscoveries = maxConcurrentDiscoveries;
+    }
+
+    /** A higher limit may grant waiting requests */
+    m_slotReleased.notify_all();
+}
+
+bool IEC61850DiscoveryCoordinator::isGrantable(const std::pair<std::size_t, Ticket> &request) const
+{
+    if (m_maxConcurrentDiscoveries == 0) {
+        return true;
+    }
+
+    if (m_runningDiscoveries >= m_maxConcurrentDiscoveries) {
+        return false;
+    }
+
+    /** Only the first request of the queue can get the slot */
+    return (! m_waitingRequests.empty()) && (*m_waitingRequests.begin() == request);
+}
@@ -0,0 +1,171 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./iec61850_latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+constexpr unsigned int LatencyHistogram::SUB_BUCKET_BITS;
+constexpr uint64_t LatencyHistogram::SUB_BUCKET_COUNT;
+constexpr unsigned int LatencyHistogram::MAX_VALUE_BITS;
+constexpr std::size_t LatencyHistogram::BUCKET_COUNT;
+
+LatencyHistogram::LatencyHistogram(const LatencyHistogram &other)
+{
+    *this = other;
+}
+
+LatencyHistogram &LatencyHistogram::operator = (const LatencyHistogram &other)
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    for (std::size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        m_counts[bucket].store(other.m_counts[bucket].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    m_totalInUs.store(other.m_totalInUs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_maxInUs.store(other.m_maxInUs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    return *this;
+}
+
+std::size_t LatencyHistogram::getBucketIndex(uint64_t valueInUs)
+{
+    valueInUs = std::min(valueInUs, (uint64_t(1) << MAX_VALUE_BITS) - 1);
+
+    /** The smallest values have 1 bucket each */
+    if (valueInUs < SUB_BUCKET_COUNT) {
+        return static_cast<std::size_t>(valueInUs);
+    }
+
+    unsigned int highestBit = 0;
+    for (uint64_t rest = valueInUs; rest > 1; rest >>= 1) {
+        highestBit++;
+    }
+
+    /** then each power of 2 is split by its next bits */
+    unsigned int shift = highestBit - SUB_BUCKET_BITS;
+    uint64_t subBucket = (valueInUs >> shift) - SUB_BUCKET_COUNT;
+
+    return static_cast<std::size_t>((highestBit - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + subBucket);
+}
+
+uint64_t LatencyHistogram::getBucketUpperBound(std::size_t bucketIndex)
+{
+    if (bucketIndex < SUB_BUCKET_COUNT) {
+        return bucketIndex;
+    }
+
+    unsigned int shift = static_cast<unsigned int>(bucketIndex / SUB_BUCKET_COUNT) - 1;
+    uint64_t lowerBound = (SUB_BUCKET_COUNT + bucketIndex % SUB_BUCKET_COUNT) << shift;
+
+    return lowerBound + (uint64_t(1) << shift) - 1;
+}
+
+void LatencyHistogram::updateMax(int64_t valueInUs)
+{
+    int64_t maxInUs = m_maxInUs.load(std::memory_order_relaxed);
+
+    while (valueInUs > maxInUs
+           && !m_maxInUs.compare_exchange_weak(maxInUs, valueInUs, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::record(std::chrono::microseconds duration)
+{
+    int64_t valueInUs = std::max<int64_t>(0, duration.count());
+
+    m_counts[getBucketIndex(static_cast<uint64_t>(valueInUs))].fetch_add(1, std::memory_order_relaxed);
+    m_totalInUs.fetch_add(valueInUs, std::memory_order_relaxed);
+    updateMax(valueInUs);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    for (std::size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        uint64_t count = other.m_counts[bucket].load(std::memory_order_relaxed);
+
+        if (count > 0) {
+            m_counts[bucket].fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+
+    m_totalInUs.fetch_add(other.m_totalInUs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    updateMax(other.m_maxInUs.load(std::memory_order_relaxed));
+}
+
+LatencyHistogram LatencyHistogram::take()
+{
+    LatencyHistogram taken;
+
+    /** (a duration recorded meanwhile goes to one histogram or the other, never lost) */
+    for (std::size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        taken.m_counts[bucket].store(m_counts[bucket].exchange(0, std::memory_order_relaxed),
+                                     std::memory_order_relaxed);
+    }
+
+    taken.m_totalInUs.store(m_totalInUs.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    taken.m_maxInUs.store(m_maxInUs.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+    return taken;
+}
+
+uint64_t LatencyHistogram::getCount() const
+{
+    uint64_t count = 0;
+
+    for (const auto &bucketCount : m_counts) {
+        count += bucketCount.load(std::memory_order_relaxed);
+    }
+
+    return count;
+}
+
+std::chrono::microseconds LatencyHistogram::getMean() const
+{
+    uint64_t count = getCount();
+
+    if (count == 0) {
+        return std::chrono::microseconds(0);
+    }
+
+    return std::chrono::microseconds(m_totalInUs.load(std::memory_order_relaxed) / static_cast<int64_t>(count));
+}
+
+std::chrono::microseconds LatencyHistogram::getPercentile(double percentile) const
+{
+    std::array<uint64_t, BUCKET_COUNT> counts;
+    uint64_t count = 0;
+
+    for (std::size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        counts[bucket] = m_counts[bucket].load(std::memory_order_relaxed);
+        count += counts[bucket];
+    }
+
+    if (count == 0) {
+        return std::chrono::microseconds(0);
+    }
+
+    /** Rank of the percentile, from 1 to the count */
+    double rankRatio = std::min(std::max(percentile, 0.0), 100.0) / 100.0;
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(rankRatio * static_cast<double>(count))));
+    uint64_t cumulatedCount = 0;
+
+    for (std::size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        cumulatedCount += counts[bucket];
+
+        if (cumulatedCount >= rank) {
+            return std::min(getMax(), std::chrono::microseconds(static_cast<int64_t>(getBucketUpperBound(bucket))));
+        }
+    }
+
+    return getMax();
+}
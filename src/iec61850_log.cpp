@@ -0,0 +1,174 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./iec61850_log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+constexpr unsigned int IEC61850LogRateLimiter::DEFAULT_PERIOD_IN_MS;
+constexpr unsigned int IEC61850LogRateLimiter::DEFAULT_BURST;
+
+/** (the level of the Fledge logger before any configuration) */
+std::atomic<int> IEC61850Log::s_minLevel{static_cast<int>(LogLevel::INFO_LEVEL)};
+
+namespace {
+
+/** \brief Rate limiters of all the call sites, built before the first one (destroyed after the last one) */
+struct RateLimiterRegistry {
+    std::mutex mutex;
+    std::vector<IEC61850LogRateLimiter *> rateLimiters;
+};
+
+RateLimiterRegistry &getRateLimiterRegistry()
+{
+    static RateLimiterRegistry registry;
+    return registry;
+}
+
+}  // namespace
+
+void IEC61850Log::setMinLevel(const std::string &level)
+{
+    Logger::getLogger()->setMinLevel(level);
+    s_minLevel.store(static_cast<int>(parseLevel(level)), std::memory_order_relaxed);
+}
+
+LogLevel IEC61850Log::parseLevel(const std::string &level)
+{
+    if (level == "debug") {
+        return LogLevel::DEBUG_LEVEL;
+    }
+    if (level == "warning") {
+        return LogLevel::WARNING_LEVEL;
+    }
+    if (level == "error") {
+        return LogLevel::ERROR_LEVEL;
+    }
+    if (level == "fatal") {
+        return LogLevel::FATAL_LEVEL;
+    }
+    return LogLevel::INFO_LEVEL;
+}
+
+void IEC61850Log::reportSuppressedMessages(std::chrono::steady_clock::time_point now)
+{
+    RateLimiterRegistry &registry = getRateLimiterRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+
+    for (IEC61850LogRateLimiter *rateLimiter : registry.rateLimiters) {
+        uint64_t suppressedCount = rateLimiter->takeExpiredSuppressedCount(now);
+
+        if (suppressedCount > 0) {
+            rateLimiter->logSuppressed(suppressedCount);
+        }
+    }
+}
+
+const char *IEC61850Log::getBasename(const char *path)
+{
+    const char *lastSeparator = std::strrchr(path, '/');
+
+    return (lastSeparator == nullptr) ? path : lastSeparator + 1;
+}
+
+void IEC61850Log::registerRateLimiter(IEC61850LogRateLimiter *rateLimiter)
+{
+    RateLimiterRegistry &registry = getRateLimiterRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    registry.rateLimiters.push_back(rateLimiter);
+}
+
+void IEC61850Log::unregisterRateLimiter(IEC61850LogRateLimiter *rateLimiter)
+{
+    RateLimiterRegistry &registry = getRateLimiterRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    registry.rateLimiters.erase(std::remove(registry.rateLimiters.begin(), registry.rateLimiters.end(), rateLimiter),
+                                registry.rateLimiters.end());
+}
+
+IEC61850LogRateLimiter::IEC61850LogRateLimiter(LogLevel level,
+                                               const char *file,
+                                               int line,
+                                               unsigned int periodInMs,
+                                               unsigned int burst)
+    : m_level(level),
+      m_file(IEC61850Log::getBasename(file)),
+      m_line(line),
+      m_period(periodInMs),
+      m_burst(burst)
+{
+    IEC61850Log::registerRateLimiter(this);
+}
+
+IEC61850LogRateLimiter::~IEC61850LogRateLimiter()
+{
+    IEC61850Log::unregisterRateLimiter(this);
+}
+
+bool IEC61850LogRateLimiter::tryAcquire(std::chrono::steady_clock::time_point now, uint64_t &suppressedCount)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    suppressedCount = 0;
+
+    if ( (m_loggedCount == 0) || (now - m_periodStart >= m_period) ) {
+        suppressedCount = m_suppressedCount;
+        m_suppressedCount = 0;
+        m_loggedCount = 0;
+        m_periodStart = now;
+    }
+
+    if (m_loggedCount < m_burst) {
+        m_loggedCount++;
+        return true;
+    }
+
+    m_suppressedCount++;
+    return false;
+}
+
+uint64_t IEC61850LogRateLimiter::takeExpiredSuppressedCount(std::chrono::steady_clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if ( (m_suppressedCount == 0) || (now - m_periodStart < m_period) ) {
+        return 0;
+    }
+
+    /** (the next message starts a new period) */
+    uint64_t suppressedCount = m_suppressedCount;
+    m_suppressedCount = 0;
+    m_loggedCount = 0;
+
+    return suppressedCount;
+}
+
+void IEC61850LogRateLimiter::logSuppressed(uint64_t suppressedCount) const
+{
+    static const char *format = "%llu similar messages suppressed (%s:%d)";
+    unsigned long long count = static_cast<unsigned long long>(suppressedCount);  // NOLINT
+
+    switch (m_level) {
+        case LogLevel::DEBUG_LEVEL:
+            Logger::getLogger()->debug(format, count, m_file, m_line);
+            break;
+        case LogLevel::INFO_LEVEL:
+            Logger::getLogger()->info(format, count, m_file, m_line);
+            break;
+        case LogLevel::WARNING_LEVEL:
+            Logger::getLogger()->warn(format, count, m_file, m_line);
+            break;
+        case LogLevel::ERROR_LEVEL:
+            Logger::getLogger()->error(format, count, m_file, m_line);
+            break;
+        default:
+            Logger::getLogger()->fatal(format, count, m_file, m_line);
+            break;
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./iec61850_name_tree_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+
+/** Minimum number of entries before purging the released subtrees */
+constexpr const std::size_t MIN_SIZE_BEFORE_PURGE = 64;
+
+void IEC61850NameTreeCache::internChildren(MmsNameNode &nameTree)
+{
+    for (auto &child : nameTree.children) {
+        child = intern(child);
+    }
+}
+
+std::shared_ptr<const MmsNameNode>
+IEC61850NameTreeCache::intern(const std::shared_ptr<const MmsNameNode> &nameNode)
+{
+    // Preconditions
+    if (! nameNode) {
+        return nameNode;
+    }
+
+    /** Share the children first (bottom-up), */
+    auto candidate = std::make_shared<MmsNameNode>();
+    candidate->mmsName = nameNode->mmsName;
+    candidate->children.reserve(nameNode->children.size());
+
+    for (const auto &child : nameNode->children) {
+        candidate->children.push_back(intern(child));
+    }
+
+    /** then identify this node by its name and its shared children. */
+    std::string key = candidate->mmsName;
+    key.push_back('\0');
+
+    for (const auto &child : candidate->children) {
+        auto address = reinterpret_cast<std::uintptr_t>(child.get());
+        key.append(reinterpret_cast<const char *>(&address), sizeof(address));
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    auto &entry = m_subtrees[key];
+    std::shared_ptr<const MmsNameNode> sharedNode = entry.lock();
+
+    if (! sharedNode) {
+        sharedNode = candidate;
+        entry = sharedNode;
+
+        if (m_subtrees.size() > std::max(MIN_SIZE_BEFORE_PURGE, 2 * m_sizeAfterPurge)) {
+            purgeReleasedSubtrees();
+        }
+    }
+
+    return sharedNode;
+}
+
+std::size_t IEC61850NameTreeCache::size()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    purgeReleasedSubtrees();
+
+    return m_subtrees.size();
+}
+
+void IEC61850NameTreeCache::purgeReleasedSubtrees()
+{
+    for (auto it = m_subtrees.begin(); it != m_subtrees.end();) {
+        if (it->second.expired()) {
+            it = m_subtrees.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    m_sizeAfterPurge = m_subtrees.size();
+}
@@ -0,0 +1,19 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./iec61850_probes.h"
+
+#ifdef IEC61850_USDT_PROBES
+
+/** The semaphores of the probes, in the section where the tracers look for them */
+#define IEC61850_PROBE_DEFINE_SEMAPHORE(name) \
+    unsigned short iec61850_##name##_semaphore __attribute__((section(".probes"))) = 0;
+IEC61850_PROBE_LIST(IEC61850_PROBE_DEFINE_SEMAPHORE)
+#undef IEC61850_PROBE_DEFINE_SEMAPHORE
+
+#endif  // IEC61850_USDT_PROBES
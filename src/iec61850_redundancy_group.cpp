@@ -0,0 +1,95 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./iec61850_redundancy_group.h"
+
+#include <utility>
+
+#include <logger.h>
+
+void IEC61850RedundancyGroup::addMember(const std::string &memberKey, PromotionCallback onPromotion)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    Member &member = m_members[memberKey];
+    member.isHealthy = false;
+    member.onPromotion = std::move(onPromotion);
+}
+
+void IEC61850RedundancyGroup::removeMember(const std::string &memberKey)
+{
+    PromotionCallback onPromotion;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_members.erase(memberKey);
+
+        if (m_activeMember == memberKey) {
+            m_activeMember.clear();
+            onPromotion = electActiveMember();
+        }
+    }
+
+    if (onPromotion) {
+        onPromotion();
+    }
+}
+
+bool IEC61850RedundancyGroup::updateHealth(const std::string &memberKey, bool isHealthy)
+{
+    PromotionCallback onPromotion;
+    bool isActive = false;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        auto memberIt = m_members.find(memberKey);
+        if (memberIt == m_members.end()) {
+            return false;
+        }
+
+        memberIt->second.isHealthy = isHealthy;
+
+        /** Failover: the active member is lost, promote a standby one */
+        if ( (m_activeMember == memberKey) && (! isHealthy)) {
+            Logger::getLogger()->warn("Redundancy: active connection %s lost", memberKey.c_str());
+            m_activeMember.clear();
+            onPromotion = electActiveMember();
+        } else if (m_activeMember.empty() && isHealthy) {
+            /** (the member is the caller: no need to wake it) */
+            electActiveMember();
+        }
+
+        isActive = (m_activeMember == memberKey);
+    }
+
+    if (onPromotion) {
+        onPromotion();
+    }
+
+    return isActive;
+}
+
+std::string IEC61850RedundancyGroup::getActiveMember() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_activeMember;
+}
+
+IEC61850RedundancyGroup::PromotionCallback IEC61850RedundancyGroup::electActiveMember()
+{
+    for (const auto &member : m_members) {
+        if (member.second.isHealthy) {
+            m_activeMember = member.first;
+            Logger::getLogger()->info("Redundancy: connection %s is active", m_activeMember.c_str());
+            return member.second.onPromotion;
+        }
+    }
+
+    Logger::getLogger()->warn("Redundancy: no healthy connection");
+    return nullptr;
+}
@@ -0,0 +1,153 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./iec61850_request_budget.h"
+
+#include <algorithm>
+
+/** Estimated size of an MMS read request and of its response, without the data */
+constexpr std::size_t ESTIMATED_EXCHANGE_OVERHEAD = 64;
+/** Estimated size of the value of a DO in a response (a few attributes, with quality and time) */
+constexpr std::size_t ESTIMATED_DO_RESPONSE_SIZE = 64;
+/** Shortest wait for the refill, to avoid spinning on tiny debts */
+constexpr std::chrono::milliseconds MIN_REFILL_WAIT(1);
+
+void IEC61850RequestBudget::Bucket::refill(double elapsedSeconds)
+{
+    if (rate > 0.0) {
+        tokens = std::min(rate, tokens + rate * elapsedSeconds);
+    }
+}
+
+bool IEC61850RequestBudget::Bucket::canDraw(double cost, double reserveShare) const
+{
+    return (secondsUntilDrawable(cost, reserveShare) <= 0.0);
+}
+
+double IEC61850RequestBudget::Bucket::secondsUntilDrawable(double cost, double reserveShare) const
+{
+    if (rate <= 0.0) {
+        return 0.0;
+    }
+
+    /** (a cost larger than the bucket is drawn from a full bucket: the debt is paid later) */
+    double reserve = reserveShare * rate;
+    double neededTokens = std::min(cost, rate - reserve) + reserve;
+
+    return std::max(0.0, (neededTokens - tokens) / rate);
+}
+
+IEC61850RequestBudget::IEC61850RequestBudget(const RequestBudgetParameters &budgetParams)
+    : m_lastRefillTime(std::chrono::steady_clock::now())
+{
+    setParameters(budgetParams);
+}
+
+void IEC61850RequestBudget::setParameters(const RequestBudgetParameters &budgetParams)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        refill();
+
+        /** A new limit starts with a full bucket, a changed one keeps its tokens (up to the new size) */
+        for (auto &bucketRate : {std::make_pair(&m_requestBucket, budgetParams.requestsPerSecond),
+                                 std::make_pair(&m_byteBucket, budgetParams.bytesPerSecond)}) {
+            Bucket &bucket = *bucketRate.first;
+            double newRate = std::max(0.0, bucketRate.second);
+            bucket.tokens = (bucket.rate > 0.0) ? std::min(bucket.tokens, newRate) : newRate;
+            bucket.rate = newRate;
+        }
+
+        m_highPriorityShare = std::min(std::max(budgetParams.highPriorityShare, 0.0), 1.0);
+    }
+
+    m_budgetChanged.notify_all();
+}
+
+void IEC61850RequestBudget::refill()
+{
+    auto now = std::chrono::steady_clock::now();
+    double elapsedSeconds = std::chrono::duration<double>(now - m_lastRefillTime).count();
+    m_lastRefillTime = now;
+
+    m_requestBucket.refill(elapsedSeconds);
+    m_byteBucket.refill(elapsedSeconds);
+}
+
+bool IEC61850RequestBudget::acquire(ReadPriority priority,
+                                    std::size_t estimatedBytes,
+                                    const std::atomic<bool> &isCancelled)
+{
+    auto requestTime = std::chrono::steady_clock::now();
+    bool isDelayed = false;
+    auto bytes = static_cast<double>(estimatedBytes);
+
+    std::unique_lock<std::mutex> guard(m_mutex);
+
+    while (true) {
+        if (isCancelled) {
+            return false;
+        }
+
+        refill();
+
+        /** (the normal reads leave the reserved share to the high priority ones) */
+        double reserveShare = (priority == ReadPriority::HIGH) ? 0.0 : m_highPriorityShare;
+        double waitSeconds = std::max(m_requestBucket.secondsUntilDrawable(1.0, reserveShare),
+                                      m_byteBucket.secondsUntilDrawable(bytes, reserveShare));
+
+        if (waitSeconds <= 0.0) {
+            break;
+        }
+
+        isDelayed = true;
+        auto waitDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::duration<double>(waitSeconds));
+        m_budgetChanged.wait_for(guard, std::max<std::chrono::microseconds>(waitDuration, MIN_REFILL_WAIT));
+    }
+
+    if (m_requestBucket.rate > 0.0) {
+        m_requestBucket.tokens -= 1.0;
+    }
+
+    if (m_byteBucket.rate > 0.0) {
+        m_byteBucket.tokens -= bytes;
+    }
+
+    m_statistics.grantedRequests++;
+    m_statistics.grantedBytes += estimatedBytes;
+
+    if (isDelayed) {
+        m_statistics.delayedRequests++;
+        m_statistics.totalDelay += std::chrono::duration_cast<std::chrono::microseconds>(
+                                       std::chrono::steady_clock::now() - requestTime);
+    }
+
+    return true;
+}
+
+void IEC61850RequestBudget::interrupt()
+{
+    {
+        /** (the lock avoids a lost wake up between the check and the wait) */
+        std::lock_guard<std::mutex> guard(m_mutex);
+    }
+
+    m_budgetChanged.notify_all();
+}
+
+IEC61850RequestBudget::Statistics IEC61850RequestBudget::getStatistics() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_statistics;
+}
+
+std::size_t IEC61850RequestBudget::estimateExchangeSize(std::size_t doCount, std::size_t referenceBytes)
+{
+    return ESTIMATED_EXCHANGE_OVERHEAD + referenceBytes + doCount * ESTIMATED_DO_RESPONSE_SIZE;
+}
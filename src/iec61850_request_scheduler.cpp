@@ -0,0 +1,148 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./iec61850_request_scheduler.h"
+
+#include <algorithm>
+
+#include <logger.h>
+
+// local library
+#include "./iec61850_tracer.h"
+
+void ResponseTimeSummary::record(std::chrono::microseconds responseTime)
+{
+    responseCount++;
+    totalResponseTime += responseTime;
+    maxResponseTime = std::max(maxResponseTime, responseTime);
+    histogram.record(responseTime);
+}
+
+void ResponseTimeSummary::merge(const ResponseTimeSummary &other)
+{
+    responseCount += other.responseCount;
+    totalResponseTime += other.totalResponseTime;
+    maxResponseTime = std::max(maxResponseTime, other.maxResponseTime);
+    timeoutCount += other.timeoutCount;
+    histogram.merge(other.histogram);
+}
+
+std::chrono::microseconds ResponseTimeSummary::getMeanResponseTime() const
+{
+    if (responseCount == 0) {
+        return std::chrono::microseconds(0);
+    }
+
+    return totalResponseTime / static_cast<int64_t>(responseCount);
+}
+
+IEC61850RequestScheduler::Turn::Turn(IEC61850RequestScheduler &scheduler, ReadPriority priority)
+    : m_scheduler(scheduler),
+      m_priority(priority),
+      m_requestTime(std::chrono::steady_clock::now())
+{
+    {
+        IEC61850TraceSpan waitSpan("connection_wait");
+        m_scheduler.acquire(m_priority);
+    }
+
+    m_exchangeStartTime = std::chrono::steady_clock::now();
+
+    if (IEC61850Tracer::isEnabled()) {
+        m_isTraced = true;
+        IEC61850Tracer::getTracer().recordEvent("mms_exchange", 'B');
+    }
+}
+
+IEC61850RequestScheduler::Turn::~Turn()
+{
+    if (m_isTraced) {
+        IEC61850Tracer::getTracer().recordEvent("mms_exchange", 'E');
+    }
+
+    auto releaseTime = std::chrono::steady_clock::now();
+    m_scheduler.release(m_priority,
+                        std::chrono::duration_cast<std::chrono::microseconds>(releaseTime - m_requestTime),
+                        std::chrono::duration_cast<std::chrono::microseconds>(releaseTime - m_exchangeStartTime));
+}
+
+void IEC61850RequestScheduler::acquire(ReadPriority priority)
+{
+    auto priorityIndex = static_cast<std::size_t>(priority);
+    std::unique_lock<std::mutex> guard(m_mutex);
+    m_waitingCount[priorityIndex]++;
+
+    /** A normal request gives way to any waiting high priority request */
+    m_connectionReleased.wait(guard, [this, priority] {
+        return (! m_isBusy)
+               && ( (priority == ReadPriority::HIGH)
+                    || (m_waitingCount[static_cast<std::size_t>(ReadPriority::HIGH)] == 0));
+    });
+
+    m_waitingCount[priorityIndex]--;
+    m_isBusy = true;
+}
+
+void IEC61850RequestScheduler::release(ReadPriority priority,
+                                       std::chrono::microseconds latency,
+                                       std::chrono::microseconds responseTime)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_isBusy = false;
+        m_latencies[static_cast<std::size_t>(priority)].record(latency);
+        m_responseTimes.record(responseTime);
+    }
+
+    /** (all: the high priority requests are not necessarily the first ones woken) */
+    m_connectionReleased.notify_all();
+}
+
+RequestLatencies IEC61850RequestScheduler::getLatencies() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_latencies;
+}
+
+void IEC61850RequestScheduler::recordTimeout()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_responseTimes.timeoutCount++;
+}
+
+ResponseTimeSummary IEC61850RequestScheduler::takeResponseTimes()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    ResponseTimeSummary responseTimes = m_responseTimes;
+    m_responseTimes = ResponseTimeSummary();
+
+    return responseTimes;
+}
+
+void IEC61850RequestScheduler::logLatencies(const RequestLatencies &latencies)
+{
+    static const std::array<const char *, READ_PRIORITY_COUNT> priorityNames{{"high", "normal"}};
+
+    for (std::size_t priority = 0; priority < latencies.size(); ++priority) {
+        const LatencyHistogram &histogram = latencies[priority];
+        uint64_t requestCount = histogram.getCount();
+
+        if (requestCount == 0) {
+            continue;
+        }
+
+        Logger::getLogger()->info("Request latencies (%s priority): %llu requests, mean %lld us, p50 %lld us, "
+                                  "p99 %lld us, max %lld us",
+                                  priorityNames[priority],
+                                  static_cast<unsigned long long>(requestCount),
+                                  static_cast<long long>(histogram.getMean().count()),
+                                  static_cast<long long>(histogram.getPercentile(50.0).count()),
+                                  static_cast<long long>(histogram.getPercentile(99.0).count()),
+                                  static_cast<long long>(histogram.getMax().count()));
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./iec61850_runtime_statistics.h"
+
+IEC61850RuntimeStatistics::IEC61850RuntimeStatistics(std::chrono::steady_clock::time_point now)
+    : m_intervalStartTime(now)
+{
+}
+
+void IEC61850RuntimeStatistics::recordCycle(std::chrono::microseconds duration)
+{
+    m_cycleCount.fetch_add(1, std::memory_order_relaxed);
+    m_cycleDurations.record(duration);
+}
+
+void IEC61850RuntimeStatistics::recordResponseTimes(const ResponseTimeSummary &responseTimes)
+{
+    m_timeoutCount.fetch_add(responseTimes.timeoutCount, std::memory_order_relaxed);
+    m_responseTimes.merge(responseTimes.histogram);
+}
+
+void IEC61850RuntimeStatistics::recordReading(std::chrono::microseconds ingestLockWait)
+{
+    m_readingCount.fetch_add(1, std::memory_order_relaxed);
+    m_ingestLockWaits.record(ingestLockWait);
+}
+
+bool IEC61850RuntimeStatistics::isPublicationDue(std::chrono::steady_clock::time_point now,
+                                                 std::chrono::milliseconds period) const
+{
+    std::lock_guard<std::mutex> guard(m_intervalMutex);
+    return (now - m_intervalStartTime >= period);
+}
+
+RuntimeStatisticsSnapshot IEC61850RuntimeStatistics::takeSnapshot(std::chrono::steady_clock::time_point now)
+{
+    RuntimeStatisticsSnapshot snapshot;
+
+    {
+        std::lock_guard<std::mutex> guard(m_intervalMutex);
+        snapshot.interval = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_intervalStartTime);
+        m_intervalStartTime = now;
+    }
+
+    /** (a count recorded meanwhile goes to one interval or the other, never lost) */
+    snapshot.cycleDurations = m_cycleDurations.take();
+    snapshot.responseTimes = m_responseTimes.take();
+    snapshot.ingestLockWaits = m_ingestLockWaits.take();
+    snapshot.cycleCount = m_cycleCount.exchange(0, std::memory_order_relaxed);
+    snapshot.readingCount = m_readingCount.exchange(0, std::memory_order_relaxed);
+    snapshot.conversionErrorCount = m_conversionErrorCount.exchange(0, std::memory_order_relaxed);
+    snapshot.timeoutCount = m_timeoutCount.exchange(0, std::memory_order_relaxed);
+    snapshot.connectionLossCount = m_connectionLossCount.exchange(0, std::memory_order_relaxed);
+
+    if (snapshot.interval.count() > 0) {
+        snapshot.readingsPerSecond = static_cast<double>(snapshot.readingCount) * 1000.0
+                                     / static_cast<double>(snapshot.interval.count());
+    }
+
+    return snapshot;
+}
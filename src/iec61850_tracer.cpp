@@ -0,0 +1,163 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./iec61850_tracer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <tuple>
+
+#include <logger.h>
+
+constexpr std::size_t IEC61850Tracer::BUFFER_CAPACITY;
+
+std::atomic<bool> IEC61850Tracer::s_isEnabled{false};
+
+IEC61850Tracer::IEC61850Tracer()
+    : m_epoch(std::chrono::steady_clock::now())
+{
+}
+
+IEC61850Tracer &IEC61850Tracer::getTracer()
+{
+    static IEC61850Tracer tracer;
+    return tracer;
+}
+
+void IEC61850Tracer::setEnabled(bool isEnabled)
+{
+    s_isEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+IEC61850Tracer::ThreadBufferHandle::~ThreadBufferHandle()
+{
+    if (buffer) {
+        buffer->isInUse.store(false, std::memory_order_release);
+    }
+}
+
+IEC61850Tracer::ThreadBuffer *IEC61850Tracer::getThreadBuffer()
+{
+    thread_local ThreadBufferHandle handle;
+
+    if (handle.buffer) {
+        return handle.buffer;
+    }
+
+    /** (only at the first event of a thread) */
+    std::lock_guard<std::mutex> guard(m_buffersMutex);
+
+    for (const auto &buffer : m_buffers) {
+        bool isInUse = false;
+        if (buffer->isInUse.compare_exchange_strong(isInUse, true, std::memory_order_acquire)) {
+            handle.buffer = buffer.get();
+            return handle.buffer;
+        }
+    }
+
+    m_buffers.push_back(std::make_unique<ThreadBuffer>());
+    m_buffers.back()->threadId = static_cast<uint32_t>(m_buffers.size());
+    handle.buffer = m_buffers.back().get();
+
+    return handle.buffer;
+}
+
+void IEC61850Tracer::recordEvent(const char *name, char phase)
+{
+    int64_t timestampInUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - m_epoch).count();
+    ThreadBuffer *buffer = getThreadBuffer();
+    uint64_t writeCount = buffer->writeCount.load(std::memory_order_relaxed);
+    Event &event = buffer->events[writeCount % BUFFER_CAPACITY];
+
+    /** Seqlock: odd while written, then 2 * (rank of the event + 1) */
+    event.sequence.store(2 * writeCount + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    event.name.store(name, std::memory_order_relaxed);
+    event.timestampInUs.store(timestampInUs, std::memory_order_relaxed);
+    event.phase.store(phase, std::memory_order_relaxed);
+    event.sequence.store(2 * writeCount + 2, std::memory_order_release);
+
+    buffer->writeCount.store(writeCount + 1, std::memory_order_relaxed);
+}
+
+std::string IEC61850Tracer::exportChromeTrace() const
+{
+    /** (thread, rank in the thread, event): the events of a thread stay in their order */
+    std::vector<std::tuple<uint32_t, uint64_t, const char *, int64_t, char>> events;
+
+    {
+        std::lock_guard<std::mutex> guard(m_buffersMutex);
+
+        for (const auto &buffer : m_buffers) {
+            for (const Event &event : buffer->events) {
+                uint64_t sequenceBefore = event.sequence.load(std::memory_order_acquire);
+                const char *name = event.name.load(std::memory_order_relaxed);
+                int64_t timestampInUs = event.timestampInUs.load(std::memory_order_relaxed);
+                char phase = event.phase.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                uint64_t sequenceAfter = event.sequence.load(std::memory_order_relaxed);
+
+                /** (skip the empty slots, and the slots written meanwhile) */
+                if ( (sequenceBefore == 0) || (sequenceBefore % 2 == 1) || (sequenceBefore != sequenceAfter)) {
+                    continue;
+                }
+
+                events.emplace_back(buffer->threadId, sequenceBefore / 2, name, timestampInUs, phase);
+            }
+        }
+    }
+
+    std::sort(events.begin(), events.end());
+
+    std::string trace = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool isFirstEvent = true;
+
+    for (const auto &event : events) {
+        if (! isFirstEvent) {
+            trace += ",";
+        }
+
+        isFirstEvent = false;
+        trace += "{\"name\":\"" + std::string(std::get<2>(event))
+                 + "\",\"cat\":\"iec61850\",\"ph\":\"" + std::string(1, std::get<4>(event))
+                 + "\",\"ts\":" + std::to_string(std::get<3>(event))
+                 + ",\"pid\":1,\"tid\":" + std::to_string(std::get<0>(event)) + "}";
+    }
+
+    trace += "]}";
+    return trace;
+}
+
+bool IEC61850Tracer::dumpChromeTrace(const std::string &filePath) const
+{
+    std::ofstream traceFile(filePath, std::ios::out | std::ios::trunc);
+
+    if (! traceFile) {
+        Logger::getLogger()->error("Tracer: cannot write the trace in %s", filePath.c_str());
+        return false;
+    }
+
+    traceFile << exportChromeTrace();
+    Logger::getLogger()->info("Tracer: trace written in %s", filePath.c_str());
+
+    return traceFile.good();
+}
+
+void IEC61850Tracer::clear()
+{
+    std::lock_guard<std::mutex> guard(m_buffersMutex);
+
+    for (const auto &buffer : m_buffers) {
+        for (Event &event : buffer->events) {
+            event.sequence.store(0, std::memory_order_relaxed);
+        }
+
+        buffer->writeCount.store(0, std::memory_order_relaxed);
+    }
+}
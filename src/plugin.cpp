@@ -20,6 +20,7 @@
 #include "./version.h"
 #include "./plugin.h"
 #include "./iec61850.h"
+#include "./iec61850_log.h"
 
 /**
  * \brief Function pointer type for the 'Reading' object processing.
@@ -53,7 +54,7 @@ extern "C" {
      */
     PLUGIN_HANDLE plugin_init(ConfigCategory *config)  // NOSONAR (Fledge API)
     {
-        Logger::getLogger()->setMinLevel("info");
+        IEC61850Log::setMinLevel("info");
         IEC61850 *iec61850;
         Logger::getLogger()->info("Initializing the plugin");
 
@@ -85,7 +86,7 @@ extern "C" {
 
         Logger::getLogger()->info("Starting the plugin");
         auto iec61850 = static_cast<IEC61850 *>(handle);
-        Logger::getLogger()->setMinLevel(iec61850->getLogMinLevel());
+        IEC61850Log::setMinLevel(iec61850->getLogMinLevel());
         iec61850->start();
     }
 
@@ -124,10 +125,8 @@ extern "C" {
         try {
             ConfigCategory config("new", newConfig);
             auto *iec61850 = static_cast<IEC61850 *>(*handle);
-            iec61850->stop();
-            iec61850->setConfig(config);
-            Logger::getLogger()->setMinLevel(iec61850->getLogMinLevel());
-            iec61850->start();
+            iec61850->reconfigure(config);
+            IEC61850Log::setMinLevel(iec61850->getLogMinLevel());
         } catch (std::exception &e) {
             Logger::getLogger()->error("%s", e.what());
             throw;
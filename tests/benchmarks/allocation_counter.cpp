@@ -0,0 +1,57 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./allocation_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+    /** (a plain thread_local: no allocation, no lock in the counting 'operator new') */
+    thread_local uint64_t t_allocationCount = 0;
+}
+
+/** The array and 'nothrow' forms of the standard library call this one */
+void *operator new(std::size_t size)
+{
+    ++t_allocationCount;
+
+    if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+AllocationCounter::AllocationCounter(benchmark::State &state)
+    : m_state(state),
+      m_initialCount(getThreadAllocationCount())
+{
+}
+
+AllocationCounter::~AllocationCounter()
+{
+    /** (the counters of the threads are summed, then divided by all their iterations) */
+    m_state.counters["allocs_per_op"] =
+        benchmark::Counter(static_cast<double>(getThreadAllocationCount() - m_initialCount),
+                           benchmark::Counter::kAvgIterations);
+}
+
+uint64_t AllocationCounter::getThreadAllocationCount()
+{
+    return t_allocationCount;
+}
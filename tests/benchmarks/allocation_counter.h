@@ -0,0 +1,44 @@
+#ifndef INCLUDE_ALLOCATION_COUNTER_H_
+#define INCLUDE_ALLOCATION_COUNTER_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+/** \class AllocationCounter
+ *  \brief Report the heap allocations per iteration of a benchmark
+ *
+ *  The benchmark binary replaces the global 'operator new' by a counting one
+ *  (see allocation_counter.cpp): only the C++ allocations are counted, not
+ *  the 'malloc' of libiec61850.
+ *  Each thread counts its own allocations: create the counter in the
+ *  benchmark function, just before the timed loop.
+ */
+class AllocationCounter
+{
+    public :
+        explicit AllocationCounter(benchmark::State &state);
+        ~AllocationCounter();
+
+        /** Disable copy constructor */
+        AllocationCounter(const AllocationCounter &) = delete;
+        /** Disable copy assignment operator */
+        AllocationCounter &operator = (const AllocationCounter &) = delete;
+
+        /** \brief Allocations of the calling thread so far */
+        static uint64_t getThreadAllocationCount();
+
+    private :
+        benchmark::State &m_state;
+        uint64_t m_initialCount;
+};
+
+#endif  // INCLUDE_ALLOCATION_COUNTER_H_
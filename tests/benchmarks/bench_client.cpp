@@ -0,0 +1,285 @@
+#include <benchmark/benchmark.h>
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <reading.h>
+
+// South_IEC61850_Plugin headers
+#include "iec61850.h"
+#include "iec61850_client.h"
+#include "wrapped_mms.h"
+
+#include "fake_iec61850_client_connection.h"
+#include "mock_iec61850_client_connection.h"
+#include "./allocation_counter.h"
+
+using namespace ::testing;
+
+/** \class IEC61850ClientBenchmark
+ *  \brief Access to the hot paths of the client (friend of IEC61850Client)
+ */
+class IEC61850ClientBenchmark
+{
+    public :
+        static Datapoint *buildDatapointFromMms(const MmsValue *mmsValue, const MmsNameNode *mmsNameNode)
+        {
+            return IEC61850Client::buildDatapointFromMms(mmsValue, mmsNameNode, "LD1/GGIO1.Bench");
+        }
+
+        static void setConnection(IEC61850Client &client, IEC61850ClientConnectionInterface *connection)
+        {
+            client.m_connection.reset(connection);
+        }
+
+        static void readAndExportOneDataset(IEC61850Client &client,
+                                            const std::string &datasetRef,
+                                            ExchangedData &exchangedDataset)
+        {
+            client.readAndExportOneDataset(datasetRef, exchangedDataset);
+        }
+
+        static void readAndExportAllDO(IEC61850Client &client)
+        {
+            client.readAndExportAllDO();
+        }
+};
+
+static std::shared_ptr<MmsNameNode> makeNameNode(const std::string &mmsName)
+{
+    auto node = std::make_shared<MmsNameNode>();
+    node->mmsName = mmsName;
+    return node;
+}
+
+/** \brief SPS: stVal, q, t */
+static MmsValue *buildSpsValue(std::shared_ptr<MmsNameNode> &nameTree, const std::string &label)
+{
+    nameTree = makeNameNode(label);
+    nameTree->children.push_back(makeNameNode("stVal"));
+    nameTree->children.push_back(makeNameNode("q"));
+    nameTree->children.push_back(makeNameNode("t"));
+
+    MmsValue *quality = MmsValue_newBitString(13);
+    MmsValue_setBitStringFromInteger(quality, 0);
+
+    MmsValue *value = MmsValue_createEmptyStructure(3);
+    MmsValue_setElement(value, 0, MmsValue_newBoolean(true));
+    MmsValue_setElement(value, 1, quality);
+    MmsValue_setElement(value, 2, MmsValue_newUtcTime(1700000000));
+    return value;
+}
+
+/** \brief MV: mag.f, q, t */
+static MmsValue *buildMvValue(std::shared_ptr<MmsNameNode> &nameTree, const std::string &label)
+{
+    nameTree = makeNameNode(label);
+    auto magnitude = makeNameNode("mag");
+    magnitude->children.push_back(makeNameNode("f"));
+    nameTree->children.push_back(magnitude);
+    nameTree->children.push_back(makeNameNode("q"));
+    nameTree->children.push_back(makeNameNode("t"));
+
+    MmsValue *magnitudeValue = MmsValue_createEmptyStructure(1);
+    MmsValue_setElement(magnitudeValue, 0, MmsValue_newFloat(42.5f));
+
+    MmsValue *quality = MmsValue_newBitString(13);
+    MmsValue_setBitStringFromInteger(quality, 0);
+
+    MmsValue *value = MmsValue_createEmptyStructure(3);
+    MmsValue_setElement(value, 0, magnitudeValue);
+    MmsValue_setElement(value, 1, quality);
+    MmsValue_setElement(value, 2, MmsValue_newUtcTime(1700000000));
+    return value;
+}
+
+/** \brief Structure of 'fieldCount' nested SPS-like structures */
+static MmsValue *buildLargeStructureValue(std::shared_ptr<MmsNameNode> &nameTree, std::size_t fieldCount)
+{
+    nameTree = makeNameNode("large");
+    MmsValue *value = MmsValue_createEmptyStructure(static_cast<int>(fieldCount));
+
+    for (std::size_t field = 0; field < fieldCount; ++field) {
+        std::shared_ptr<MmsNameNode> fieldTree;
+        MmsValue_setElement(value, static_cast<int>(field), buildSpsValue(fieldTree, "field" + std::to_string(field)));
+        nameTree->children.push_back(fieldTree);
+    }
+    return value;
+}
+
+/** \brief Array of 'elementCount' integers */
+static MmsValue *buildArrayValue(std::shared_ptr<MmsNameNode> &nameTree, std::size_t elementCount)
+{
+    nameTree = makeNameNode("array");
+    MmsValue *value = MmsValue_createEmptyArray(static_cast<int>(elementCount));
+
+    for (std::size_t element = 0; element < elementCount; ++element) {
+        nameTree->children.push_back(makeNameNode(std::to_string(element)));
+        MmsValue_setElement(value, static_cast<int>(element),
+                            MmsValue_newIntegerFromInt32(static_cast<int32_t>(element)));
+    }
+    return value;
+}
+
+static void runBuildDatapoint(benchmark::State &state, MmsValue *mmsValue, const MmsNameNode *nameTree)
+{
+    WrappedMms wrappedMms;
+    wrappedMms.setMmsValue(mmsValue);
+    AllocationCounter allocationCounter(state);
+
+    for (auto _ : state) {
+        Datapoint *datapoint = IEC61850ClientBenchmark::buildDatapointFromMms(wrappedMms.getMmsValue(), nameTree);
+        benchmark::DoNotOptimize(datapoint);
+        delete datapoint;
+    }
+}
+
+static void BM_BuildDatapointSps(benchmark::State &state)
+{
+    std::shared_ptr<MmsNameNode> nameTree;
+    MmsValue *mmsValue = buildSpsValue(nameTree, "TS1");
+    runBuildDatapoint(state, mmsValue, nameTree.get());
+}
+BENCHMARK(BM_BuildDatapointSps);
+
+static void BM_BuildDatapointMv(benchmark::State &state)
+{
+    std::shared_ptr<MmsNameNode> nameTree;
+    MmsValue *mmsValue = buildMvValue(nameTree, "TM1");
+    runBuildDatapoint(state, mmsValue, nameTree.get());
+}
+BENCHMARK(BM_BuildDatapointMv);
+
+static void BM_BuildDatapointLargeStructure(benchmark::State &state)
+{
+    std::shared_ptr<MmsNameNode> nameTree;
+    MmsValue *mmsValue = buildLargeStructureValue(nameTree, static_cast<std::size_t>(state.range(0)));
+    runBuildDatapoint(state, mmsValue, nameTree.get());
+}
+BENCHMARK(BM_BuildDatapointLargeStructure)->Arg(16)->Arg(128);
+
+static void BM_BuildDatapointArray(benchmark::State &state)
+{
+    std::shared_ptr<MmsNameNode> nameTree;
+    MmsValue *mmsValue = buildArrayValue(nameTree, static_cast<std::size_t>(state.range(0)));
+    runBuildDatapoint(state, mmsValue, nameTree.get());
+}
+BENCHMARK(BM_BuildDatapointArray)->Arg(64)->Arg(1024);
+
+/** (the readings are dropped: the Reading object deletes its datapoints) */
+static void dropReading(void *, Reading)
+{
+}
+
+/**
+ * Split of a dataset of N SPS/MV members into N readings, up to the ingest
+ * callback. The fake IED returns a copy of the dataset value at each read:
+ * the copy is measured too (libiec61850 'malloc', not counted as allocations).
+ */
+static void BM_ReadAndExportOneDataset(benchmark::State &state)
+{
+    std::size_t memberCount = static_cast<std::size_t>(state.range(0));
+    const std::string datasetRef = "LD1/LLN0.Bench";
+
+    ExchangedData exchangedDataset(memberCount);
+    WrappedMms datasetValue;
+    datasetValue.setMmsValue(MmsValue_createEmptyArray(static_cast<int>(memberCount)));
+
+    for (std::size_t member = 0; member < memberCount; ++member) {
+        DatapointConfig &dpConfig = exchangedDataset[member];
+        bool isSps = (member % 2 == 0);
+        dpConfig.label = (isSps ? "TS" : "TM") + std::to_string(member);
+        dpConfig.datapointType = isSps ? "SPS" : "MV";
+        dpConfig.dataPath = "LD1/GGIO1." + dpConfig.label;
+        MmsValue *memberValue = isSps ? buildSpsValue(dpConfig.mmsNameTree, dpConfig.label)
+                                      : buildMvValue(dpConfig.mmsNameTree, dpConfig.label);
+        MmsValue_setElement(const_cast<MmsValue *>(datasetValue.getMmsValue()), static_cast<int>(member),
+                            memberValue);
+    }
+
+    IEC61850 iec61850;
+    iec61850.registerIngest(nullptr, dropReading);
+
+    ServerConnectionParameters connParam;
+    ApplicationParameters applicationParams;
+    applicationParams.readMode = ReadMode::DATASET_READING;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    IEC61850Client client(&iec61850, connParam, exchangedData, exchangedDatasets, applicationParams);
+
+    auto *mockConnection = new NiceMock<MockIEC61850ClientConnection>();
+    ON_CALL(*mockConnection, readDataset(datasetRef, _))
+    .WillByDefault(Invoke([&datasetValue](const std::string &, IedClientError &) {
+        auto wrappedMms = std::make_shared<WrappedMms>();
+        wrappedMms->setMmsValue(MmsValue_clone(datasetValue.getMmsValue()));
+        return wrappedMms;
+    }));
+    IEC61850ClientBenchmark::setConnection(client, mockConnection);
+
+    AllocationCounter allocationCounter(state);
+
+    for (auto _ : state) {
+        IEC61850ClientBenchmark::readAndExportOneDataset(client, datasetRef, exchangedDataset);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadAndExportOneDataset)->Arg(16)->Arg(256)->Arg(1024);
+
+/**
+ * Reads of 256 DO per cycle, sharded over 1 to 8 associations, against a fake
+ * IED (log-normal RTT of median 5 ms, 1 % of timeouts after 1 s): the wall
+ * time is the overhead of the client, 'virtual_cycle_ms' the duration of the
+ * cycle as seen by the IED, without socket nor sleep.
+ */
+static void BM_ScheduleReadsOverFakeIed(benchmark::State &state)
+{
+    constexpr std::size_t DO_COUNT = 256;
+
+    ExchangedData exchangedData(DO_COUNT);
+    for (std::size_t index = 0; index < DO_COUNT; ++index) {
+        DatapointConfig &dpConfig = exchangedData[index];
+        dpConfig.label = "TS" + std::to_string(index);
+        dpConfig.datapointType = "SPS";
+        dpConfig.dataPath = "LD1/GGIO1.Ind" + std::to_string(index);
+        dpConfig.functionalConstraint = IEC61850_FC_ST;
+    }
+
+    IEC61850 iec61850;
+    iec61850.registerIngest(nullptr, dropReading);
+
+    ServerConnectionParameters connParam;
+    connParam.associationCount = static_cast<unsigned int>(state.range(0));
+    ApplicationParameters applicationParams;
+    ExchangedDatasets exchangedDatasets;
+    IEC61850Client client(&iec61850, connParam, exchangedData, exchangedDatasets, applicationParams);
+
+    FakeIedProfile profile;
+    profile.rttDistribution = RttDistribution::LOG_NORMAL;
+    profile.rtt = std::chrono::milliseconds(5);
+    profile.rttSigma = 0.5;
+    profile.timeoutRatio = 0.01;
+    profile.requestTimeout = std::chrono::seconds(1);
+    VirtualClock clock;
+    auto *fakeConnection = new FakeIEC61850ClientConnection(profile, clock);
+    IEC61850ClientBenchmark::setConnection(client, fakeConnection);
+
+    std::chrono::microseconds virtualCycleTime(0);
+
+    for (auto _ : state) {
+        fakeConnection->beginCycle();
+        std::chrono::microseconds cycleStart = clock.now();
+        IEC61850ClientBenchmark::readAndExportAllDO(client);
+        virtualCycleTime += clock.now() - cycleStart;
+    }
+
+    state.counters["virtual_cycle_ms"] = benchmark::Counter(static_cast<double>(virtualCycleTime.count()) / 1000.0,
+                                                            benchmark::Counter::kAvgIterations);
+    state.counters["timeouts"] = benchmark::Counter(
+        static_cast<double>(fakeConnection->getOutcomeCount(FakeCallOutcome::TIMEOUT)),
+        benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(DO_COUNT));
+}
+BENCHMARK(BM_ScheduleReadsOverFakeIed)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->ArgName("associations")->UseRealTime();
@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <config_category.h>
+
+// South_IEC61850_Plugin headers
+#include "iec61850_client_config.h"
+
+#include "./allocation_counter.h"
+#include "./configuration_builder.h"
+
+/** \brief Configuration of 'pointCount' datapoints, half SPS and half MV */
+static std::string buildConfiguration(std::size_t pointCount)
+{
+    std::string exchangedData = R"({"exchanged_data":{"name":"iec61850client","version":"1.0","datapoints":[)";
+
+    for (std::size_t point = 0; point < pointCount; ++point) {
+        bool isSps = (point % 2 == 0);
+        std::string index = std::to_string(point);
+
+        if (point > 0) {
+            exchangedData += ",";
+        }
+        exchangedData += R"({"label":")" + std::string(isSps ? "TS" : "TM") + index
+                         + R"(","pivot_id":"ID)" + index
+                         + R"(","protocols":[{"name":"iec61850","address":"simpleIOGenericIO/GGIO)"
+                         + std::to_string(point / 64) + (isSps ? ".Ind" : ".AnIn") + index
+                         + R"(","typeid":")" + (isSps ? "SPS" : "MV") + R"("}]})";
+    }
+    exchangedData += "]}}";
+
+    return buildConfigCategoryJson({{"protocol_stack", buildProtocolStackJson("simpleIO", {102}, "{}")},
+                                    {"exchanged_data", exchangedData}});
+}
+
+static void BM_ImportConfig(benchmark::State &state)
+{
+    ConfigCategory config("BenchmarkConfig", buildConfiguration(static_cast<std::size_t>(state.range(0))));
+    AllocationCounter allocationCounter(state);
+
+    for (auto _ : state) {
+        IEC61850ClientConfig clientConfig;
+        clientConfig.importConfig(config);
+        benchmark::DoNotOptimize(clientConfig.exchangedData.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ImportConfig)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>  // NOLINT
+#include <string>
+#include <vector>
+
+#include <reading.h>
+
+// South_IEC61850_Plugin headers
+#include "iec61850.h"
+
+#include "./allocation_counter.h"
+
+/** (the readings are dropped: the Reading object deletes its datapoints) */
+static void dropReading(void *, Reading)
+{
+}
+
+/** \brief The plugin shared by the threads of the benchmark */
+static IEC61850 &getSharedPlugin()
+{
+    static IEC61850 *iec61850 = []() {
+        auto *plugin = new IEC61850();  // NOSONAR (kept until the end of the process)
+        plugin->registerIngest(nullptr, dropReading);
+        return plugin;
+    }();
+    return *iec61850;
+}
+
+/**
+ * Readings of 1 datapoint sent by 1 to 16 clients at once: the ingest lock
+ * serializes them. The wait for the lock is reported per reading.
+ */
+static void BM_IngestUnderContention(benchmark::State &state)
+{
+    IEC61850 &iec61850 = getSharedPlugin();
+    const std::string assetName = "TS" + std::to_string(state.thread_index());
+    std::chrono::microseconds totalLockWait(0);
+
+    AllocationCounter allocationCounter(state);
+
+    for (auto _ : state) {
+        DatapointValue value(static_cast<long>(1));
+        std::vector<Datapoint *> points{new Datapoint(assetName, value)};
+        std::chrono::microseconds lockWait(0);
+        iec61850.ingest(points, assetName, lockWait);
+        totalLockWait += lockWait;
+    }
+
+    state.counters["lock_wait_us"] = benchmark::Counter(static_cast<double>(totalLockWait.count()),
+                                                        benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_IngestUnderContention)->ThreadRange(1, 16)->UseRealTime();
@@ -0,0 +1,268 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>  // NOLINT
+#include <mutex>   // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <config_category.h>
+#include <reading.h>
+
+// Libiec61850 headers
+#include <hal_thread.h>
+
+// South_IEC61850_Plugin headers
+#include "iec61850.h"
+#include "iec61850_request_scheduler.h"
+
+// test utilities headers
+#include "../common/mms_server_farm/mms_server_farm.h"
+#include "./configuration_builder.h"
+
+/** Until each IED sent its first values (connections and model discoveries) */
+constexpr std::chrono::seconds WARM_UP_TIMEOUT(120);
+constexpr std::chrono::seconds MEASURE_DURATION(10);
+
+/** \class FarmReadingMonitor
+ *  \brief Count of the readings of the farm, and latency of the changes of its MV
+ *
+ *  The latency of a change is its age when its reading is ingested: the wait
+ *  for the next polling cycle, the MMS exchange, the conversion and the ingest.
+ *  Thread safe.
+ */
+class FarmReadingMonitor
+{
+    public :
+        explicit FarmReadingMonitor(const MmsServerFarm &farm, int iedCount)
+            : m_farm(farm),
+              m_iedCount(iedCount),
+              m_hasSentReadings(iedCount, false)
+        {
+        }
+
+        static void ingestReading(void *monitor, Reading reading)
+        {
+            static_cast<FarmReadingMonitor *>(monitor)->recordReading(reading);
+        }
+
+        void startMeasure()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_readingCount = 0;
+            m_latencies = LatencyHistogram();
+            m_isMeasuring = true;
+        }
+
+        void stopMeasure()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isMeasuring = false;
+        }
+
+        int getActiveIedCount()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_activeIedCount;
+        }
+
+        uint64_t getReadingCount()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_readingCount;
+        }
+
+        LatencyHistogram getLatencies()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_latencies;
+        }
+
+    private :
+        void recordReading(Reading &reading)
+        {
+            uint64_t nowInMs = Hal_getTimeInMs();
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_isMeasuring) {
+                m_readingCount++;
+            }
+
+            for (Datapoint *datapoint : reading.getReadingData()) {
+                /** (only the MV carry a stamp) */
+                if ( (datapoint->getName().compare(0, 4, "AnIn") != 0)
+                        || (datapoint->getData().getType() != DatapointValue::T_DP_DICT)) {
+                    continue;
+                }
+
+                for (Datapoint *child : *datapoint->getData().getDpVec()) {
+                    if (child->getName() == "do_value") {
+                        recordStamp(datapoint->getName(), child->getData().toDouble(), nowInMs);
+                    }
+                }
+            }
+        }
+
+        void recordStamp(const std::string &label, double stamp, uint64_t nowInMs)
+        {
+            int iedIndex = 0;
+            uint64_t ageInMs = 0;
+
+            if (! m_farm.decodeStamp(stamp, nowInMs, iedIndex, ageInMs)) {
+                return;
+            }
+
+            if (! m_hasSentReadings[iedIndex]) {
+                m_hasSentReadings[iedIndex] = true;
+                m_activeIedCount++;
+            }
+
+            /** A stamp read again is not a change: the first one of a DO is the reference */
+            auto &lastStamps = m_lastStamps[label];
+            if (lastStamps.empty()) {
+                lastStamps.assign(m_iedCount, -1.0);
+            }
+
+            double &lastStamp = lastStamps[iedIndex];
+            if ( (lastStamp >= 0.0) && (stamp != lastStamp) && m_isMeasuring) {
+                m_latencies.record(std::chrono::milliseconds(ageInMs));
+            }
+            lastStamp = stamp;
+        }
+
+        std::mutex m_mutex;
+        const MmsServerFarm &m_farm;
+        int m_iedCount;
+        std::vector<bool> m_hasSentReadings;
+        int m_activeIedCount = 0;
+        std::unordered_map<std::string, std::vector<double>> m_lastStamps;
+
+        bool m_isMeasuring = false;
+        uint64_t m_readingCount = 0;
+        LatencyHistogram m_latencies;
+};
+
+/** \brief Plugin configuration to read the MV and SPS of the farm (the plugin does not read DPS) */
+static std::string buildFarmConfiguration(const MmsServerFarm &farm,
+                                          const MmsServerFarmParameters &farmParameters,
+                                          bool isDatasetReading)
+{
+    std::vector<int> ports;
+    for (int iedIndex = 0; iedIndex < farmParameters.iedCount; ++iedIndex) {
+        ports.push_back(farmParameters.basePort + iedIndex);
+    }
+
+    const auto &dataObjects = farm.getDataObjects();
+    std::string applicationLayer = R"({"reading_period":1000,"read_mode":")"
+                                   + std::string(isDatasetReading ? "dataset" : "do") + R"("})";
+    std::vector<std::pair<std::string, std::string>> jsonItems;
+    jsonItems.emplace_back("protocol_stack", buildProtocolStackJson(MmsServerFarm::IED_NAME, ports,
+                                                                    applicationLayer));
+
+    if (isDatasetReading) {
+        std::string datasets;
+
+        for (const auto &dataset : farm.getDatasets()) {
+            std::string members;
+
+            for (std::size_t index : dataset.memberIndexes) {
+                if (dataObjects[index].typeId == "DPS") {
+                    continue;
+                }
+                members += std::string(members.empty() ? "" : ",")
+                           + R"({"label":")" + dataObjects[index].label
+                           + R"(","typeid":")" + dataObjects[index].typeId
+                           + R"(","doName":")" + dataObjects[index].label + R"("})";
+            }
+
+            datasets += std::string(datasets.empty() ? "" : ",")
+                        + R"({"dataset_ref":")" + dataset.datasetRef + R"(","data_objects":[)" + members + "]}";
+        }
+
+        jsonItems.emplace_back("exchanged_datasets",
+                               R"({"exchanged_datasets":{"name":"farm","version":"1.0","datasets":[)"
+                               + datasets + "]}}");
+    } else {
+        std::string datapoints;
+
+        for (const auto &dataObject : dataObjects) {
+            if (dataObject.typeId == "DPS") {
+                continue;
+            }
+            datapoints += std::string(datapoints.empty() ? "" : ",")
+                          + R"({"label":")" + dataObject.label
+                          + R"(","protocols":[{"name":"iec61850","address":")" + dataObject.doPath
+                          + R"(","typeid":")" + dataObject.typeId + R"("}]})";
+        }
+
+        jsonItems.emplace_back("exchanged_data",
+                               R"({"exchanged_data":{"name":"farm","version":"1.0","datapoints":[)"
+                               + datapoints + "]}}");
+    }
+
+    return buildConfigCategoryJson(jsonItems);
+}
+
+/**
+ * The plugin reads a farm of 1 to 500 IEDs on localhost, each with 10 GGIO
+ * (MV, SPS, DPS) changing 10 values per second, every second: by DO
+ * (dataset=0) or by datasets of 30 DO (dataset=1).
+ */
+static void BM_IedFarmEndToEnd(benchmark::State &state)
+{
+    MmsServerFarmParameters farmParameters;
+    farmParameters.iedCount = static_cast<int>(state.range(0));
+    farmParameters.logicalNodeCount = 10;
+    farmParameters.datasetSize = 30;
+    farmParameters.changesPerSecond = 10.0;
+    bool isDatasetReading = (state.range(1) == 1);
+
+    MmsServerFarm farm(farmParameters);
+    if (! farm.start()) {
+        state.SkipWithError("the IED farm cannot start");
+        return;
+    }
+
+    FarmReadingMonitor monitor(farm, farmParameters.iedCount);
+    ConfigCategory config("IedFarm", buildFarmConfiguration(farm, farmParameters, isDatasetReading));
+
+    IEC61850 iec61850;
+    iec61850.setConfig(config);
+    iec61850.registerIngest(&monitor, FarmReadingMonitor::ingestReading);
+    iec61850.start();
+
+    auto warmUpEnd = std::chrono::steady_clock::now() + WARM_UP_TIMEOUT;
+    while ( (monitor.getActiveIedCount() < farmParameters.iedCount)
+            && (std::chrono::steady_clock::now() < warmUpEnd)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    for (auto _ : state) {
+        monitor.startMeasure();
+        std::this_thread::sleep_for(MEASURE_DURATION);
+        monitor.stopMeasure();
+        state.SetIterationTime(std::chrono::duration<double>(MEASURE_DURATION).count());
+    }
+
+    iec61850.stop();
+    farm.stop();
+
+    double measureInSeconds = std::chrono::duration<double>(MEASURE_DURATION).count();
+    LatencyHistogram latencies = monitor.getLatencies();
+    auto toMs = [](std::chrono::microseconds duration) { return static_cast<double>(duration.count()) / 1000.0; };
+
+    state.counters["active_ieds"] = monitor.getActiveIedCount();
+    state.counters["readings_per_s"] = static_cast<double>(monitor.getReadingCount()) / measureInSeconds;
+    state.counters["changes_per_s"] = static_cast<double>(latencies.getCount()) / measureInSeconds;
+    state.counters["latency_p50_ms"] = toMs(latencies.getPercentile(50.0));
+    state.counters["latency_p99_ms"] = toMs(latencies.getPercentile(99.0));
+    state.counters["latency_max_ms"] = toMs(latencies.getMax());
+}
+BENCHMARK(BM_IedFarmEndToEnd)
+->ArgsProduct({{1, 10, 100, 500}, {0, 1}})
+->ArgNames({"ieds", "dataset"})
+->Iterations(1)
+->UseManualTime()
+->Unit(benchmark::kSecond);
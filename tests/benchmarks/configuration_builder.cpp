@@ -0,0 +1,57 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./configuration_builder.h"
+
+/** \brief JSON text as the string value of a configuration item */
+static std::string quoteJson(const std::string &json)
+{
+    std::string quoted = "\"";
+    quoted.reserve(json.size() + json.size() / 4 + 2);
+
+    for (char character : json) {
+        if (character == '"' || character == '\\') {
+            quoted += '\\';
+        }
+        quoted += character;
+    }
+    return quoted + "\"";
+}
+
+std::string buildConfigCategoryJson(const std::vector<std::pair<std::string, std::string>> &jsonItems)
+{
+    std::string category = "{";
+
+    for (const auto &item : jsonItems) {
+        if (category.size() > 1) {
+            category += ",";
+        }
+        category += "\"" + item.first + R"(":{"description":")" + item.first
+                    + R"(","type":"JSON","value":)" + quoteJson(item.second) + "}";
+    }
+
+    return category + "}";
+}
+
+std::string buildProtocolStackJson(const std::string &iedName,
+                                   const std::vector<int> &ports,
+                                   const std::string &applicationLayer)
+{
+    std::string connections;
+
+    for (int port : ports) {
+        if (! connections.empty()) {
+            connections += ",";
+        }
+        connections += R"({"srv_ip":"127.0.0.1","port":)" + std::to_string(port) + "}";
+    }
+
+    return R"({"protocol_stack":{"name":"iec61850client","version":"1.0",)"
+           R"("transport_layer":{"ied_name":")" + iedName + R"(","connections":[)" + connections + "]},"
+           R"("application_layer":)" + applicationLayer + "}}";
+}
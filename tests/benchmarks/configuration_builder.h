@@ -0,0 +1,29 @@
+#ifndef INCLUDE_CONFIGURATION_BUILDER_H_
+#define INCLUDE_CONFIGURATION_BUILDER_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * \brief JSON of a configuration category, from the JSON of its items
+ *
+ * The generated configurations are too large for the QUOTE examples of the
+ * tests: each item is given as (item name, JSON value) and quoted here.
+ */
+std::string buildConfigCategoryJson(const std::vector<std::pair<std::string, std::string>> &jsonItems);
+
+/** \brief Protocol stack of an IED name, with 1 connection per port */
+std::string buildProtocolStackJson(const std::string &iedName,
+                                   const std::vector<int> &ports,
+                                   const std::string &applicationLayer);
+
+#endif  // INCLUDE_CONFIGURATION_BUILDER_H_
@@ -0,0 +1,18 @@
+#include <benchmark/benchmark.h>
+
+// South_IEC61850_Plugin headers
+#include "iec61850_log.h"
+
+int main(int argc, char **argv)
+{
+    /** (the syslog writes of the info logs would dominate the measures) */
+    IEC61850Log::setMinLevel("warning");
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
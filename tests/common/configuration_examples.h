@@ -1198,6 +1198,715 @@ const std::string validExchangedDataWithIgnoredProtocols = QUOTE({
         });
 
 
+const std::string protocolStackWithDynamicDatasets = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "reading_period" : 500,
+            "read_mode" : "do",
+            "dynamic_datasets" : true
+        }
+    }
+});
+
+const std::string protocolStackDynamicDatasetsBadFormat = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "dynamic_datasets" : "yes"
+        }
+    }
+});
+
+const std::string protocolStackWithPartialReadThreshold = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "read_mode" : "dataset",
+            "partial_read_threshold" : 0.25
+        }
+    }
+});
+
+const std::string protocolStackPartialReadThresholdOutOfRange = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "partial_read_threshold" : 1.5
+        }
+    }
+});
+
+const std::string protocolStackWithMaxConcurrentDiscoveries = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "max_concurrent_discoveries" : 8
+        }
+    }
+});
+
+const std::string protocolStackMaxConcurrentDiscoveriesBadFormat = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "max_concurrent_discoveries" : -1
+        }
+    }
+});
+
+
+const std::string protocolStackWithConnectionTimeouts = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102,
+                    "connect_timeout" : 2000,
+                    "request_timeout" : 3000,
+                    "reconnect_min_delay" : 500,
+                    "reconnect_max_delay" : 60000
+                }
+            ]
+        },
+        "application_layer" : {
+        }
+    }
+});
+
+const std::string protocolStackConnectionTimeoutBadFormat = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102,
+                    "connect_timeout" : "2000"
+                }
+            ]
+        },
+        "application_layer" : {
+        }
+    }
+});
+
+const std::string protocolStackReconnectDelaysInWrongOrder = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102,
+                    "reconnect_min_delay" : 5000,
+                    "reconnect_max_delay" : 1000
+                }
+            ]
+        },
+        "application_layer" : {
+        }
+    }
+});
+
+
+const std::string protocolStackWithRedundantConnections = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "redundant_connections" : true,
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                },
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 8102
+                }
+            ]
+        },
+        "application_layer" : {
+        }
+    }
+});
+
+const std::string protocolStackRedundantConnectionsBadFormat = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "redundant_connections" : "yes",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                },
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 8102
+                }
+            ]
+        },
+        "application_layer" : {
+        }
+    }
+});
+
+
+const std::string protocolStackWithAssociationCount = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102,
+                    "associations" : 4
+                }
+            ]
+        },
+        "application_layer" : {
+        }
+    }
+});
+
+const std::string protocolStackAssociationCountOutOfRange = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102,
+                    "associations" : 0
+                }
+            ]
+        },
+        "application_layer" : {
+        }
+    }
+});
+
+
+const std::string protocolStackWithMmsTuning = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102,
+                    "max_pdu_size" : 16384,
+                    "max_outstanding_calls" : 8
+                }
+            ]
+        },
+        "application_layer" : {
+        }
+    }
+});
+
+const std::string protocolStackMaxPduSizeOutOfRange = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102,
+                    "max_pdu_size" : 100000
+                }
+            ]
+        },
+        "application_layer" : {
+        }
+    }
+});
+
+const std::string protocolStackMaxOutstandingCallsBadFormat = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102,
+                    "max_outstanding_calls" : "8"
+                }
+            ]
+        },
+        "application_layer" : {
+        }
+    }
+});
+
+
+const std::string exchangedDataWithPriorities = QUOTE({
+            "exchanged_data": {
+                "name" : "iec61850client",
+                "version" : "1.0",
+                "datapoints": [
+                    {
+                        "label":"TS1",
+                        "protocols":[
+                           {
+                              "name":"iec61850",
+                              "address":"simpleIOGenericIO/GGIO1.Ind1",
+                              "typeid":"SPS",
+                              "priority":"high"
+                           }
+                        ]
+                    },
+                    {
+                        "label":"TM1",
+                        "protocols":[
+                           {
+                              "name":"iec61850",
+                              "address":"simpleIOGenericIO/GGIO1.AnIn1",
+                              "typeid":"MV",
+                              "priority":"normal"
+                           }
+                        ]
+                    },
+                    {
+                        "label":"TM2",
+                        "protocols":[
+                           {
+                              "name":"iec61850",
+                              "address":"simpleIOGenericIO/GGIO1.AnIn2",
+                              "typeid":"MV"
+                           }
+                        ]
+                    }
+                ]
+            }
+        });
+
+const std::string datapointWithUnknownPriority = QUOTE({
+            "exchanged_data": {
+                "name" : "iec61850client",
+                "version" : "1.0",
+                "datapoints": [
+                    {
+                        "label":"TS1",
+                        "protocols":[
+                           {
+                              "name":"iec61850",
+                              "address":"simpleIOGenericIO/GGIO1.Ind1",
+                              "typeid":"SPS",
+                              "priority":"urgent"
+                           }
+                        ]
+                    }
+                ]
+            }
+        });
+
+const std::string protocolStackWithHighPriorityReadingPeriod = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "high_priority_reading_period" : 100
+        }
+    }
+});
+
+const std::string protocolStackWithRequestBudgets = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102,
+                    "link_group" : "substationA"
+                },
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 103
+                }
+            ]
+        },
+        "application_layer" : {
+            "request_budget" : {
+                "requests_per_second" : 50
+            },
+            "link_budgets" : {
+                "substationA" : {
+                    "requests_per_second" : 20,
+                    "bytes_per_second" : 8000,
+                    "high_priority_share" : 0.25
+                }
+            }
+        }
+    }
+});
+
+const std::string protocolStackRequestBudgetNegative = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "request_budget" : {
+                "bytes_per_second" : -1
+            }
+        }
+    }
+});
+
+const std::string protocolStackHighPriorityShareOutOfRange = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "link_budgets" : {
+                "substationA" : {
+                    "requests_per_second" : 20,
+                    "high_priority_share" : 1
+                }
+            }
+        }
+    }
+});
+
+const std::string protocolStackWithAdaptivePolling = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "reading_period" : 100,
+            "adaptive_polling" : {
+                "min_period" : 200,
+                "max_period" : 60000
+            }
+        }
+    }
+});
+
+const std::string protocolStackAdaptivePollingWithoutMaxPeriod = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "adaptive_polling" : {
+                "min_period" : 200
+            }
+        }
+    }
+});
+
+const std::string exchangedDataWithPollingPeriods = QUOTE({
+    "exchanged_data" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "datapoints" : [
+            {
+                "label" : "TS1",
+                "protocols" : [
+                    {
+                        "name" : "iec61850",
+                        "address" : "simpleIOGenericIO/GGIO1.SPCSO1",
+                        "typeid" : "SPS",
+                        "min_period" : 100,
+                        "max_period" : 5000
+                    }
+                ]
+            },
+            {
+                "label" : "TM1",
+                "protocols" : [
+                    {
+                        "name" : "iec61850",
+                        "address" : "simpleIOGenericIO/GGIO1.AnIn1",
+                        "typeid" : "MV"
+                    }
+                ]
+            }
+        ]
+    }
+});
+
+const std::string datapointWithInvertedPollingPeriods = QUOTE({
+    "exchanged_data" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "datapoints" : [
+            {
+                "label" : "TS1",
+                "protocols" : [
+                    {
+                        "name" : "iec61850",
+                        "address" : "simpleIOGenericIO/GGIO1.SPCSO1",
+                        "typeid" : "SPS",
+                        "min_period" : 5000,
+                        "max_period" : 100
+                    }
+                ]
+            }
+        ]
+    }
+});
+
+const std::string exchangedDatasetsWithPollingPeriods = QUOTE({
+    "exchanged_datasets" : {
+        "name" : "SAMPLE",
+        "version" : "1.0",
+        "datasets" : [
+            {
+                "dataset_ref" : "simpleIOGenericIO/LLN0.RTEEvents",
+                "min_period" : 1000,
+                "max_period" : 30000,
+                "data_objects" : [
+                    {
+                        "label" : "TS1",
+                        "typeid" : "SPS",
+                        "doName" : "SPSSO1"
+                    }
+                ]
+            }
+        ]
+    }
+});
+
+
+const std::string protocolStackWithCongestionControl = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "congestion_control" : {
+                "response_time_threshold" : 500,
+                "max_slowdown" : 8
+            }
+        }
+    }
+});
+
+const std::string protocolStackCongestionControlWithoutSlowdown = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "congestion_control" : {
+                "max_slowdown" : 0
+            }
+        }
+    }
+});
+
+const std::string protocolStackWithRuntimeStatistics = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "statistics" : {
+                "asset_name" : "ied_statistics",
+                "period" : 10000
+            }
+        }
+    }
+});
+
+const std::string protocolStackRuntimeStatisticsWithBadPeriod = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "statistics" : {
+                "period" : 0
+            }
+        }
+    }
+});
+
+const std::string protocolStackWithTracing = QUOTE({
+    "protocol_stack" : {
+        "name" : "iec61850client",
+        "version" : "1.0",
+        "transport_layer" : {
+            "ied_name" : "simpleIO",
+            "connections" : [
+                {
+                    "srv_ip" : "0.0.0.0",
+                    "port" : 102
+                }
+            ]
+        },
+        "application_layer" : {
+            "tracing" : {
+                "enabled" : true,
+                "file" : "/var/tmp/ied_trace.json"
+            }
+        }
+    }
+});
+
 //// Functional tests section
 //
 #define FUNCTIONAL_TESTS_PROTOCOL_STACK_DO_MODE                                \
@@ -1250,6 +1959,28 @@ const std::string validExchangedDataWithIgnoredProtocols = QUOTE({
             }                                                                  \
         })
 
+#define FUNCTIONAL_TESTS_PROTOCOL_STACK_DYNAMIC_DATASET_MODE                   \
+    QUOTE({                                                                    \
+            "protocol_stack" : {                                               \
+                "name" : "iec61850client",                                     \
+                "version" : "1.0",                                             \
+                "transport_layer" : {                                          \
+                    "ied_name" : "simpleIO",                                   \
+                    "connections" : [                                          \
+                        {                                                      \
+                            "srv_ip" : "0.0.0.0",                              \
+                            "port" : 8102                                      \
+                        }                                                      \
+                    ]                                                          \
+                },                                                             \
+                "application_layer" : {                                        \
+                    "reading_period" : 1000,                                   \
+                    "read_mode" : "do",                                        \
+                    "dynamic_datasets" : true                                  \
+                }                                                              \
+            }                                                                  \
+        })
+
 #define FUNCTIONAL_TESTS_EXCHANGED_DATA                                        \
             QUOTE({                                                            \
             "exchanged_data": {                                                \
@@ -1419,6 +2150,57 @@ static const char *const functional_tests_config_dataset_reading_mode = QUOTE({
         "default" : FUNCTIONAL_TESTS_EXCHANGED_DATASETS
     }
 });
+
+static const char *const functional_tests_config_dynamic_dataset_reading_mode = QUOTE({
+    "plugin" : {
+        "description" : "iec61850 south plugin",
+        "type" : "string",
+        "default" : PLUGIN_NAME,
+        "readonly" : "true"
+    },
+
+    "log min level" : {
+        "description" : "minimum level for the Fledge logger (debug, info)",
+        "type" : "string",
+        "default" : "info",
+        "displayName" : "logger minimum level",
+        "order" : "1",
+        "mandatory" : "true"
+    },
+
+    "asset" : {
+        "description" : "Asset name",
+        "type" : "string",
+        "default" : "iec61850",
+        "displayName" : "Asset Name",
+        "order" : "2",
+        "mandatory" : "true"
+    },
+
+    "protocol_stack" : {
+        "description" : "protocol stack parameters",
+        "type" : "JSON",
+        "displayName" : "Protocol stack parameters",
+        "order" : "3",
+        "default" : FUNCTIONAL_TESTS_PROTOCOL_STACK_DYNAMIC_DATASET_MODE
+    },
+
+    "exchanged_data" : {
+        "description" : "exchanged data list",
+        "type" : "JSON",
+        "displayName" : "Exchanged data list",
+        "order" : "4",
+        "default" : FUNCTIONAL_TESTS_EXCHANGED_DATA
+    },
+
+    "exchanged_datasets" : {
+        "description" : "exchanged dataset list",
+        "type" : "JSON",
+        "displayName" : "Exchanged dataset list",
+        "order" : "5",
+        "default" : FUNCTIONAL_TESTS_EXCHANGED_DATASETS
+    }
+});
 // *INDENT-ON*
 //
 #endif
@@ -0,0 +1,273 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./mms_server_farm.h"
+
+// C headers
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+
+// Libiec61850 headers
+#include <hal_thread.h>
+#include <iec61850_cdc.h>
+#include <iec61850_dynamic_model.h>
+
+constexpr int MmsServerFarm::MAX_IED_COUNT;
+constexpr uint64_t MmsServerFarm::STAMP_PERIOD_IN_MS;
+constexpr const char *MmsServerFarm::IED_NAME;
+constexpr const char *MmsServerFarm::LD_NAME;
+
+/** Period of the changes of values */
+constexpr int CHANGE_PERIOD_IN_MS = 10;
+
+MmsServerFarm::MmsServerFarm(const MmsServerFarmParameters &parameters)
+    : m_parameters(parameters)
+{
+    m_parameters.iedCount = std::min(std::max(m_parameters.iedCount, 1), MAX_IED_COUNT);
+    m_parameters.logicalNodeCount = std::max(m_parameters.logicalNodeCount, 1);
+    m_parameters.datasetSize = std::max(m_parameters.datasetSize, 0);
+    buildDataObjectList();
+}
+
+MmsServerFarm::~MmsServerFarm()
+{
+    stop();
+}
+
+void MmsServerFarm::buildDataObjectList()
+{
+    const std::string ldPath = std::string(IED_NAME) + LD_NAME + "/";
+
+    for (int node = 1; node <= m_parameters.logicalNodeCount; ++node) {
+        std::string nodeName = "GGIO" + std::to_string(node);
+        std::string index = std::to_string(node);
+
+        m_dataObjects.push_back({"AnIn" + index, "MV", ldPath + nodeName + ".AnIn" + index});
+        m_dataObjects.push_back({"Ind" + index, "SPS", ldPath + nodeName + ".Ind" + index});
+        m_dataObjects.push_back({"Pos" + index, "DPS", ldPath + nodeName + ".Pos" + index});
+    }
+
+    if (m_parameters.datasetSize == 0) {
+        return;
+    }
+
+    /** The DO are spread over the datasets, in the order of the model */
+    for (std::size_t first = 0; first < m_dataObjects.size(); first += m_parameters.datasetSize) {
+        FarmDataset dataset;
+        dataset.datasetRef = ldPath + "LLN0.Farm" + std::to_string(m_datasets.size() + 1);
+
+        std::size_t last = std::min(first + m_parameters.datasetSize, m_dataObjects.size());
+        for (std::size_t index = first; index < last; ++index) {
+            dataset.memberIndexes.push_back(index);
+        }
+
+        m_datasets.push_back(dataset);
+    }
+}
+
+IedModel *MmsServerFarm::createModel(std::vector<ChangedAttributes> &attributes) const
+{
+    IedModel *model = IedModel_create(IED_NAME);
+    LogicalDevice *logicalDevice = LogicalDevice_create(LD_NAME, model);
+    LogicalNode *lln0 = LogicalNode_create("LLN0", logicalDevice);
+    CDC_ENS_create("Mod", (ModelNode *) lln0, 0);
+    CDC_ENS_create("Health", (ModelNode *) lln0, 0);
+
+    attributes.clear();
+
+    for (int node = 1; node <= m_parameters.logicalNodeCount; ++node) {
+        std::string index = std::to_string(node);
+        LogicalNode *ggio = LogicalNode_create(("GGIO" + index).c_str(), logicalDevice);
+
+        DataObject *mv = CDC_MV_create(("AnIn" + index).c_str(), (ModelNode *) ggio, 0, false);
+        DataObject *sps = CDC_SPS_create(("Ind" + index).c_str(), (ModelNode *) ggio, 0);
+        DataObject *dps = CDC_DPS_create(("Pos" + index).c_str(), (ModelNode *) ggio, 0);
+
+        for (const auto &dataObject : {std::make_pair(mv, "mag.f"),
+                                       std::make_pair(sps, "stVal"),
+                                       std::make_pair(dps, "stVal")}) {
+            ChangedAttributes changed;
+            changed.value = (DataAttribute *) ModelNode_getChild((ModelNode *) dataObject.first,
+                                                                 dataObject.second);
+            changed.timestamp = (DataAttribute *) ModelNode_getChild((ModelNode *) dataObject.first, "t");
+            attributes.push_back(changed);
+        }
+    }
+
+    for (const auto &dataset : m_datasets) {
+        std::string datasetName = dataset.datasetRef.substr(dataset.datasetRef.find('.') + 1);
+        DataSet *modelDataset = DataSet_create(datasetName.c_str(), lln0);
+
+        for (std::size_t memberIndex : dataset.memberIndexes) {
+            /** (reference in the logical device: "GGIO1$MX$AnIn1") */
+            const FarmDataObject &dataObject = m_dataObjects[memberIndex];
+            std::string nodeName = dataObject.doPath.substr(dataObject.doPath.find('/') + 1);
+            nodeName = nodeName.substr(0, nodeName.find('.'));
+            std::string variable = nodeName + (dataObject.typeId == "MV" ? "$MX$" : "$ST$") + dataObject.label;
+            DataSetEntry_create(modelDataset, variable.c_str(), -1, NULL);
+        }
+    }
+
+    return model;
+}
+
+bool MmsServerFarm::start()
+{
+    m_ieds.resize(m_parameters.iedCount);
+
+    for (int iedIndex = 0; iedIndex < m_parameters.iedCount; ++iedIndex) {
+        FarmIed &ied = m_ieds[iedIndex];
+        ied.model = createModel(ied.attributes);
+
+        IedServerConfig config = IedServerConfig_create();
+        IedServerConfig_setEdition(config, IEC_61850_EDITION_2);
+        IedServerConfig_enableFileService(config, false);
+        IedServerConfig_enableDynamicDataSetService(config, true);
+        IedServerConfig_enableLogService(config, false);
+        /** (the plugin may open several associations per IED) */
+        IedServerConfig_setMaxMmsConnections(config, 8);
+        ied.server = IedServer_createWithConfig(ied.model, NULL, config);
+        IedServerConfig_destroy(config);
+
+        IedServer_setServerIdentity(ied.server, "FledgePower", "mms server farm", "1.0");
+
+        /** The MV start with a stamp of their IED: a client tells the IEDs apart at once */
+        float initialStamp = makeStamp(iedIndex, Hal_getTimeInMs());
+
+        for (std::size_t index = 0; index < ied.attributes.size(); ++index) {
+            if (m_dataObjects[index].typeId == "MV") {
+                IedServer_updateFloatAttributeValue(ied.server, ied.attributes[index].value, initialStamp);
+            }
+        }
+
+        IedServer_start(ied.server, m_parameters.basePort + iedIndex);
+
+        if (! IedServer_isRunning(ied.server)) {
+            printf("Starting the IED %d of the farm failed (port %d already in use?)\n",
+                   iedIndex, m_parameters.basePort + iedIndex);
+            stop();
+            return false;
+        }
+    }
+
+    m_isRunning = true;
+    m_changeThread = std::thread(&MmsServerFarm::runChanges, this);
+    return true;
+}
+
+void MmsServerFarm::stop()
+{
+    m_isRunning = false;
+
+    if (m_changeThread.joinable()) {
+        m_changeThread.join();
+    }
+
+    for (auto &ied : m_ieds) {
+        if (ied.server) {
+            if (IedServer_isRunning(ied.server)) {
+                IedServer_stop(ied.server);
+            }
+            IedServer_destroy(ied.server);
+        }
+
+        if (ied.model) {
+            IedModel_destroy(ied.model);
+        }
+    }
+
+    m_ieds.clear();
+}
+
+void MmsServerFarm::runChanges()
+{
+    auto lastChangeTime = std::chrono::steady_clock::now();
+
+    while (m_isRunning) {
+        Thread_sleep(CHANGE_PERIOD_IN_MS);
+
+        auto changeTime = std::chrono::steady_clock::now();
+        double elapsedInSeconds = std::chrono::duration<double>(changeTime - lastChangeTime).count();
+        lastChangeTime = changeTime;
+        uint64_t nowInMs = Hal_getTimeInMs();
+
+        for (int iedIndex = 0; iedIndex < static_cast<int>(m_ieds.size()); ++iedIndex) {
+            changeValues(iedIndex, m_ieds[iedIndex], nowInMs, elapsedInSeconds);
+        }
+    }
+}
+
+void MmsServerFarm::changeValues(int iedIndex, FarmIed &ied, uint64_t nowInMs, double elapsedInSeconds)
+{
+    /** (the fractions of changes are carried over to the next period) */
+    ied.pendingChanges += m_parameters.changesPerSecond * elapsedInSeconds;
+    auto changeCount = static_cast<std::size_t>(ied.pendingChanges);
+
+    if (changeCount == 0) {
+        return;
+    }
+
+    ied.pendingChanges -= static_cast<double>(changeCount);
+    changeCount = std::min(changeCount, ied.attributes.size());
+
+    Timestamp iecTimestamp;
+    Timestamp_clearFlags(&iecTimestamp);
+    Timestamp_setTimeInMilliseconds(&iecTimestamp, nowInMs);
+
+    float stamp = makeStamp(iedIndex, nowInMs);
+
+    IedServer_lockDataModel(ied.server);
+
+    for (std::size_t change = 0; change < changeCount; ++change) {
+        std::size_t index = ied.nextChange;
+        ied.nextChange = (ied.nextChange + 1) % ied.attributes.size();
+        const ChangedAttributes &changed = ied.attributes[index];
+        const std::string &typeId = m_dataObjects[index].typeId;
+
+        if (typeId == "MV") {
+            IedServer_updateFloatAttributeValue(ied.server, changed.value, stamp);
+        } else if (typeId == "SPS") {
+            bool isOn = MmsValue_getBoolean(IedServer_getAttributeValue(ied.server, changed.value));
+            IedServer_updateBooleanAttributeValue(ied.server, changed.value, ! isOn);
+        } else {
+            Dbpos position = (Dbpos_fromMmsValue(IedServer_getAttributeValue(ied.server, changed.value)) == DBPOS_ON)
+                             ? DBPOS_OFF : DBPOS_ON;
+            IedServer_updateDbposValue(ied.server, changed.value, position);
+        }
+
+        IedServer_updateTimestampAttributeValue(ied.server, changed.timestamp, &iecTimestamp);
+    }
+
+    IedServer_unlockDataModel(ied.server);
+}
+
+float MmsServerFarm::makeStamp(int iedIndex, uint64_t nowInMs)
+{
+    return static_cast<float>(static_cast<uint64_t>(iedIndex) * STAMP_PERIOD_IN_MS + nowInMs % STAMP_PERIOD_IN_MS);
+}
+
+bool MmsServerFarm::decodeStamp(double magnitude, uint64_t nowInMs, int &iedIndex, uint64_t &ageInMs) const
+{
+    if ( (magnitude < 0.0) || (magnitude >= static_cast<double>(MAX_IED_COUNT * STAMP_PERIOD_IN_MS)) ) {
+        return false;
+    }
+
+    auto stamp = static_cast<uint64_t>(magnitude);
+    iedIndex = static_cast<int>(stamp / STAMP_PERIOD_IN_MS);
+
+    if (iedIndex >= m_parameters.iedCount) {
+        return false;
+    }
+
+    /** (modulo the period of the stamps) */
+    uint64_t changeTime = stamp % STAMP_PERIOD_IN_MS;
+    ageInMs = (nowInMs % STAMP_PERIOD_IN_MS + STAMP_PERIOD_IN_MS - changeTime) % STAMP_PERIOD_IN_MS;
+    return true;
+}
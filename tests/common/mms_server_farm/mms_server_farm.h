@@ -0,0 +1,125 @@
+#ifndef MMS_SERVER_FARM_H_
+#define MMS_SERVER_FARM_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Libiec61850 headers
+#include <iec61850_server.h>
+
+/**
+ *  \brief Shape and activity of a simulated IED farm
+ */
+struct MmsServerFarmParameters {
+    int basePort = 20102;            /**< IED 'i' listens on 'basePort + i' */
+    int iedCount = 1;                /**< at most MmsServerFarm::MAX_IED_COUNT */
+    int logicalNodeCount = 10;       /**< GGIO<k>, each with an MV, an SPS and a DPS */
+    int datasetSize = 30;            /**< DO per dataset of LLN0 (0: no dataset) */
+    double changesPerSecond = 10.0;  /**< value changes per second, per IED */
+};
+
+/**
+ *  \brief DO of the generated model, as addressed by the plugin
+ */
+struct FarmDataObject {
+    std::string label;     /**< e.g. "AnIn3" (unique in the model) */
+    std::string typeId;    /**< "MV", "SPS" or "DPS" */
+    std::string doPath;    /**< e.g. "farmLD0/GGIO3.AnIn3" */
+};
+
+/**
+ *  \brief Dataset of the generated model
+ */
+struct FarmDataset {
+    std::string datasetRef;                /**< e.g. "farmLD0/LLN0.Farm1" */
+    std::vector<std::size_t> memberIndexes;  /**< in 'getDataObjects()' */
+};
+
+/** \class MmsServerFarm
+ *  \brief Load generator: N in-process IED servers on consecutive ports
+ *
+ *  Each IED serves the same generated model: an IED "farm", with a logical
+ *  device "LD0" of 'logicalNodeCount' GGIO, and datasets of 'datasetSize'
+ *  DO in LLN0. One thread changes 'changesPerSecond' values per IED, in
+ *  turn over the MV, SPS and DPS.
+ *
+ *  The 'mag.f' of a changed MV is a stamp of the change:
+ *  iedIndex * STAMP_PERIOD_IN_MS + (change time in ms) % STAMP_PERIOD_IN_MS,
+ *  exact in a float. A client finds with 'decodeStamp' the IED and the
+ *  latency of the change, up to STAMP_PERIOD_IN_MS.
+ */
+class MmsServerFarm
+{
+    public:
+        static constexpr int MAX_IED_COUNT = 512;
+        static constexpr uint64_t STAMP_PERIOD_IN_MS = 32768;
+        static constexpr const char *IED_NAME = "farm";
+        static constexpr const char *LD_NAME = "LD0";
+
+        explicit MmsServerFarm(const MmsServerFarmParameters &parameters);
+        ~MmsServerFarm();
+
+        /** Disable copy constructor */
+        MmsServerFarm(const MmsServerFarm &) = delete;
+        /** Disable copy assignment operator */
+        MmsServerFarm &operator = (const MmsServerFarm &) = delete;
+
+        /** \return false if an IED cannot listen on its port (the farm is stopped) */
+        bool start();
+        void stop();
+
+        const std::vector<FarmDataObject> &getDataObjects() const { return m_dataObjects; }
+        const std::vector<FarmDataset> &getDatasets() const { return m_datasets; }
+
+        /**
+         * \brief IED and age of an MV stamp
+         *
+         * \param nowInMs same clock as the farm (Hal_getTimeInMs)
+         * \return false if the value is not a stamp of the farm
+         */
+        bool decodeStamp(double magnitude, uint64_t nowInMs, int &iedIndex, uint64_t &ageInMs) const;
+
+    private:
+        /** \brief Attributes changed by the farm, for one DO of one IED */
+        struct ChangedAttributes {
+            DataAttribute *value = nullptr;      /**< mag.f or stVal */
+            DataAttribute *timestamp = nullptr;  /**< t */
+        };
+
+        /** \brief One server, with its own copy of the model */
+        struct FarmIed {
+            IedModel *model = nullptr;
+            IedServer server = nullptr;
+            std::vector<ChangedAttributes> attributes;  /**< by index in 'm_dataObjects' */
+            std::size_t nextChange = 0;
+            double pendingChanges = 0.0;
+        };
+
+        static float makeStamp(int iedIndex, uint64_t nowInMs);
+
+        void buildDataObjectList();
+        IedModel *createModel(std::vector<ChangedAttributes> &attributes) const;
+        void changeValues(int iedIndex, FarmIed &ied, uint64_t nowInMs, double elapsedInSeconds);
+        void runChanges();
+
+        MmsServerFarmParameters m_parameters;
+        std::vector<FarmDataObject> m_dataObjects;
+        std::vector<FarmDataset> m_datasets;
+        std::vector<FarmIed> m_ieds;
+
+        std::thread m_changeThread;
+        std::atomic<bool> m_isRunning{false};
+};
+
+#endif  // MMS_SERVER_FARM_H_
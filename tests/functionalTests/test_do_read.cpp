@@ -81,3 +81,40 @@ TEST_F(SouthIEC61850PluginTestWithIEC61850Server, readDO)
     ASSERT_LE(getIntValue(getChild(*dp, "do_ts")), 2147483648);
     ASSERT_GE(getIntValue(getChild(*dp, "do_ts")), 1670509743);
 }
+
+TEST_F(SouthIEC61850PluginTestWithIEC61850Server, readDOThroughDynamicDatasets)
+{
+    ConfigCategory config("TestDefaultConfig", functional_tests_config_dynamic_dataset_reading_mode);
+    config.setItemsValueFromDefault();
+
+    PLUGIN_HANDLE handle = nullptr;
+    handle = plugin_init(&config);
+
+    ASSERT_NO_THROW(
+           plugin_register_ingest((PLUGIN_HANDLE)handle,
+                                   SouthIEC61850PluginTestWithIEC61850Server::ingestCallback,
+                                   NULL)
+    );
+
+    ASSERT_NO_THROW(plugin_start((PLUGIN_HANDLE)handle));
+
+    sleep(2);
+    plugin_shutdown((PLUGIN_HANDLE)handle);
+
+    ASSERT_GE(ingestCallCount, 2);
+    ASSERT_LE(ingestCallCount, 4);
+
+    /** Both DO belong to the same logical device: same dataset, same order */
+    ASSERT_EQ("TS1", storedReadings.at(0)->getAssetName());
+    ASSERT_EQ("TM1", storedReadings.at(1)->getAssetName());
+
+    Datapoint *dp = getObject(*(storedReadings.at(1)), "TM1");
+    ASSERT_THAT(dp, NotNull());
+
+    ASSERT_TRUE(hasChild(*dp, "do_type"));
+    ASSERT_EQ("MV", getStrValue(getChild(*dp, "do_type")));
+
+    ASSERT_TRUE(hasChild(*dp, "do_value"));
+    ASSERT_LE(getDoubleValue(getChild(*dp, "do_value")), 1.0);
+    ASSERT_GE(getDoubleValue(getChild(*dp, "do_value")), -1.0);
+}
@@ -0,0 +1,439 @@
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include "./fake_iec61850_client_connection.h"
+
+#include <algorithm>
+#include <cmath>
+
+// local library
+#include "./iec61850_client_config.h"
+
+/** \brief SplitMix64 finalizer: a well spread 64 bits value from any input */
+static uint64_t mixBits(uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+/** \brief FNV-1a: the same hash on every platform, unlike std::hash */
+static uint64_t hashReference(const std::string &reference)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+
+    for (char character : reference) {
+        hash = (hash ^ static_cast<unsigned char>(character)) * 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+/** Streams of the random draws of a request */
+constexpr uint64_t TIMEOUT_STREAM = 1;
+constexpr uint64_t RTT_STREAM = 2;
+constexpr uint64_t RTT_ANGLE_STREAM = 3;
+constexpr uint64_t MISMATCH_STREAM = 4;
+
+void VirtualClock::advance(std::chrono::microseconds duration)
+{
+    m_nowInUs += duration.count();
+}
+
+void VirtualClock::advanceTo(std::chrono::microseconds time)
+{
+    int64_t now = m_nowInUs.load();
+
+    while ( (time.count() > now) && (! m_nowInUs.compare_exchange_weak(now, time.count()))) {
+        // 'now' is reloaded by the failed exchange
+    }
+}
+
+FakeIEC61850ClientConnection::FakeIEC61850ClientConnection(const FakeIedProfile &profile,
+                                                           VirtualClock &clock)
+    : m_profile(profile),
+      m_clock(clock),
+      m_cycleStart(clock.now())
+{
+}
+
+bool FakeIEC61850ClientConnection::isConnected()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_isConnected;
+}
+
+bool FakeIEC61850ClientConnection::keepAlive()
+{
+    return isConnected();
+}
+
+RequestLatencies FakeIEC61850ClientConnection::getRequestLatencies() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_latencies;
+}
+
+ResponseTimeSummary FakeIEC61850ClientConnection::takeResponseTimes()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    ResponseTimeSummary responseTimes = m_responseTimes;
+    m_responseTimes = ResponseTimeSummary();
+
+    return responseTimes;
+}
+
+std::shared_ptr<WrappedMms> FakeIEC61850ClientConnection::readDO(const std::string &doPath,
+                                                                 const FunctionalConstraint &functionalConstraint,
+                                                                 IedClientError &error)
+{
+    FakeCallOutcome outcome = exchange("readDO", doPath, 1, ReadPriority::NORMAL);
+    error = toRequestError(outcome);
+
+    if ( (outcome != FakeCallOutcome::ANSWERED) && (outcome != FakeCallOutcome::STRUCTURE_MISMATCH)) {
+        return nullptr;
+    }
+
+    auto wrappedMms = std::make_shared<WrappedMms>();
+    wrappedMms->setMmsValue(createDOValue(functionalConstraint, outcome == FakeCallOutcome::STRUCTURE_MISMATCH));
+    return wrappedMms;
+}
+
+std::shared_ptr<WrappedMms> FakeIEC61850ClientConnection::readDataset(const std::string &datasetRef,
+                                                                      IedClientError &error)
+{
+    std::vector<std::string> members = getDoPathListWithFCFromDataset(datasetRef);
+    FakeCallOutcome outcome = exchange("readDataset", datasetRef, std::max<std::size_t>(1, members.size()),
+                                       ReadPriority::NORMAL);
+    error = toRequestError(outcome);
+
+    /** (an unknown dataset is answered by an access error) */
+    if (members.empty()) {
+        if (error == IED_ERROR_OK) {
+            error = IED_ERROR_OBJECT_DOES_NOT_EXIST;
+        }
+        return nullptr;
+    }
+
+    return respond(outcome, members);
+}
+
+std::shared_ptr<WrappedMms> FakeIEC61850ClientConnection::readMultipleDO(
+    const std::vector<std::string> &doPathListWithFC,
+    ReadPriority priority,
+    IedClientError &error)
+{
+    if (doPathListWithFC.empty()) {
+        error = IED_ERROR_USER_PROVIDED_INVALID_ARGUMENT;
+        return nullptr;
+    }
+
+    FakeCallOutcome outcome = exchange("readMultipleDO", doPathListWithFC.front(), doPathListWithFC.size(),
+                                       priority);
+    error = toRequestError(outcome);
+    return respond(outcome, doPathListWithFC);
+}
+
+bool FakeIEC61850ClientConnection::buildNameTree(const std::string &pathInDatamodel,
+                                                 const FunctionalConstraint &functionalConstraint,
+                                                 MmsNameNode *nameTree)
+{
+    auto makeLeaf = [](const std::string &mmsName) {
+        auto node = std::make_shared<MmsNameNode>();
+        node->mmsName = mmsName;
+        return node;
+    };
+
+    nameTree->mmsName = pathInDatamodel.substr(pathInDatamodel.find_last_of("./") + 1);
+    nameTree->children.clear();
+
+    if (functionalConstraint == IEC61850_FC_MX) {
+        auto magnitude = makeLeaf("mag");
+        magnitude->children.push_back(makeLeaf("f"));
+        nameTree->children.push_back(magnitude);
+    } else {
+        nameTree->children.push_back(makeLeaf("stVal"));
+    }
+
+    nameTree->children.push_back(makeLeaf("q"));
+    nameTree->children.push_back(makeLeaf("t"));
+    return true;
+}
+
+std::vector<std::string> FakeIEC61850ClientConnection::getDoPathListWithFCFromDataset(const std::string &datasetRef)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto datasetIt = m_datasets.find(datasetRef);
+
+    if (datasetIt == m_datasets.end()) {
+        return {};
+    }
+
+    return datasetIt->second;
+}
+
+bool FakeIEC61850ClientConnection::createDataset(const std::string &datasetRef,
+                                                 const std::vector<std::string> &doPathListWithFC)
+{
+    setDataset(datasetRef, doPathListWithFC);
+    return true;
+}
+
+bool FakeIEC61850ClientConnection::deleteDataset(const std::string &datasetRef)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return (m_datasets.erase(datasetRef) > 0);
+}
+
+void FakeIEC61850ClientConnection::setDataset(const std::string &datasetRef,
+                                              const std::vector<std::string> &doPathListWithFC)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_datasets[datasetRef] = doPathListWithFC;
+}
+
+void FakeIEC61850ClientConnection::beginCycle()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_peakOutstandingCalls = std::max(m_peakOutstandingCalls, countPeakOverlap(m_cycleCalls));
+    m_cycleStart = m_clock.now();
+    m_threadTimes.clear();
+    m_cycleCalls.clear();
+}
+
+void FakeIEC61850ClientConnection::disconnect()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_isConnected = false;
+}
+
+void FakeIEC61850ClientConnection::reconnect()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_isConnected = true;
+    m_requestsSinceConnection = 0;
+}
+
+std::vector<FakeCallRecord> FakeIEC61850ClientConnection::getCallLog() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_callLog;
+}
+
+uint64_t FakeIEC61850ClientConnection::getOutcomeCount(FakeCallOutcome outcome) const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_outcomeCounts[static_cast<std::size_t>(outcome)];
+}
+
+unsigned int FakeIEC61850ClientConnection::getPeakOutstandingCalls() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return std::max(m_peakOutstandingCalls, countPeakOverlap(m_cycleCalls));
+}
+
+unsigned int FakeIEC61850ClientConnection::countPeakOverlap(
+    const std::vector<std::pair<std::chrono::microseconds, std::chrono::microseconds>> &calls)
+{
+    /** Sweep of the starts (+1) and ends (-1) in virtual time, an end before a start at the same time */
+    std::vector<std::pair<std::chrono::microseconds, int>> events;
+    events.reserve(calls.size() * 2);
+
+    for (const auto &call : calls) {
+        events.emplace_back(call.first, 1);
+        events.emplace_back(call.second, -1);
+    }
+
+    std::sort(events.begin(), events.end());
+
+    int outstandingCalls = 0;
+    int peak = 0;
+
+    for (const auto &event : events) {
+        outstandingCalls += event.second;
+        peak = std::max(peak, outstandingCalls);
+    }
+
+    return static_cast<unsigned int>(peak);
+}
+
+double FakeIEC61850ClientConnection::drawUniform(uint64_t requestKey, uint64_t stream) const
+{
+    /** 53 random bits, in [0, 1) */
+    uint64_t bits = mixBits(requestKey ^ mixBits(m_profile.seed + stream));
+    return static_cast<double>(bits >> 11) / 9007199254740992.0;
+}
+
+std::chrono::microseconds FakeIEC61850ClientConnection::drawRtt(uint64_t requestKey, std::size_t itemCount) const
+{
+    double rttInUs = static_cast<double>(m_profile.rtt.count());
+
+    switch (m_profile.rttDistribution) {
+        case RttDistribution::UNIFORM:
+            rttInUs += drawUniform(requestKey, RTT_STREAM)
+                       * static_cast<double>(std::max(m_profile.maxRtt, m_profile.rtt).count() - m_profile.rtt.count());
+            break;
+
+        case RttDistribution::LOG_NORMAL: {
+            /** (Box-Muller: 1 - u is in (0, 1]) */
+            double radius = std::sqrt(-2.0 * std::log(1.0 - drawUniform(requestKey, RTT_STREAM)));
+            double angle = 2.0 * M_PI * drawUniform(requestKey, RTT_ANGLE_STREAM);
+            rttInUs *= std::exp(m_profile.rttSigma * radius * std::cos(angle));
+            break;
+        }
+
+        case RttDistribution::CONSTANT:
+        default:
+            break;
+    }
+
+    return std::chrono::microseconds(static_cast<int64_t>(rttInUs))
+           + m_profile.rttPerItem * static_cast<int64_t>(itemCount);
+}
+
+FakeCallOutcome FakeIEC61850ClientConnection::exchange(const char *method,
+                                                       const std::string &reference,
+                                                       std::size_t itemCount,
+                                                       ReadPriority priority)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    /** The first request of a thread in the cycle is sent at the start of the cycle */
+    auto threadIt = m_threadTimes.emplace(std::this_thread::get_id(), m_cycleStart).first;
+
+    FakeCallRecord record;
+    record.method = method;
+    record.reference = reference;
+    record.itemCount = itemCount;
+    record.priority = priority;
+    record.start = threadIt->second;
+
+    uint64_t requestKey = mixBits(hashReference(reference) ^ mixBits(m_requestCountByReference[reference]++));
+
+    auto outstandingCalls = static_cast<unsigned int>(
+        std::count_if(m_cycleCalls.begin(), m_cycleCalls.end(), [&record](const auto &call) {
+            return (call.first <= record.start) && (record.start < call.second);
+        }));
+
+    if (! m_isConnected) {
+        record.outcome = FakeCallOutcome::DISCONNECTED;
+    } else if ( (m_profile.maxOutstandingCalls > 0) && (outstandingCalls >= m_profile.maxOutstandingCalls)) {
+        /** (refused by the client stack, before any exchange) */
+        record.outcome = FakeCallOutcome::REFUSED;
+    } else if ( (m_profile.disconnectAfterRequests > 0)
+                && (m_requestsSinceConnection >= m_profile.disconnectAfterRequests)) {
+        m_isConnected = false;
+        record.outcome = FakeCallOutcome::DISCONNECTED;
+    } else {
+        m_requestsSinceConnection++;
+
+        if (drawUniform(requestKey, TIMEOUT_STREAM) < m_profile.timeoutRatio) {
+            record.outcome = FakeCallOutcome::TIMEOUT;
+            record.rtt = m_profile.requestTimeout;
+            m_responseTimes.timeoutCount++;
+        } else {
+            record.outcome = (drawUniform(requestKey, MISMATCH_STREAM) < m_profile.structureMismatchRatio)
+                             ? FakeCallOutcome::STRUCTURE_MISMATCH : FakeCallOutcome::ANSWERED;
+            record.rtt = drawRtt(requestKey, itemCount);
+            m_responseTimes.record(record.rtt);
+        }
+
+        m_latencies[static_cast<std::size_t>(priority)].record(record.rtt);
+        m_cycleCalls.emplace_back(record.start, record.start + record.rtt);
+    }
+
+    threadIt->second = record.start + record.rtt;
+    m_clock.advanceTo(threadIt->second);
+
+    m_outcomeCounts[static_cast<std::size_t>(record.outcome)]++;
+
+    if (m_callLog.size() < m_profile.maxCallLogSize) {
+        m_callLog.push_back(record);
+    }
+
+    return record.outcome;
+}
+
+IedClientError FakeIEC61850ClientConnection::toRequestError(FakeCallOutcome outcome)
+{
+    switch (outcome) {
+        case FakeCallOutcome::TIMEOUT:
+            return IED_ERROR_TIMEOUT;
+
+        case FakeCallOutcome::DISCONNECTED:
+            return IED_ERROR_CONNECTION_LOST;
+
+        case FakeCallOutcome::REFUSED:
+            return IED_ERROR_OUTSTANDING_CALL_LIMIT_REACHED;
+
+        default:
+            /** (a mismatching response is only detected by the client) */
+            return IED_ERROR_OK;
+    }
+}
+
+std::shared_ptr<WrappedMms> FakeIEC61850ClientConnection::respond(FakeCallOutcome outcome,
+                                                                  const std::vector<std::string> &doPathListWithFC) const
+{
+    if ( (outcome != FakeCallOutcome::ANSWERED) && (outcome != FakeCallOutcome::STRUCTURE_MISMATCH)) {
+        return nullptr;
+    }
+
+    /** A mismatching response misses its last member */
+    std::size_t memberCount = doPathListWithFC.size();
+    if (outcome == FakeCallOutcome::STRUCTURE_MISMATCH) {
+        memberCount--;
+    }
+
+    MmsValue *members = MmsValue_createEmptyArray(static_cast<int>(memberCount));
+
+    for (std::size_t index = 0; index < memberCount; ++index) {
+        MmsValue_setElement(members, static_cast<int>(index),
+                            createDOValue(parseFunctionalConstraint(doPathListWithFC[index]), false));
+    }
+
+    auto wrappedMms = std::make_shared<WrappedMms>();
+    wrappedMms->setMmsValue(members);
+    return wrappedMms;
+}
+
+FunctionalConstraint FakeIEC61850ClientConnection::parseFunctionalConstraint(const std::string &doPathWithFC)
+{
+    std::size_t bracket = doPathWithFC.rfind('[');
+
+    if ( (bracket != std::string::npos) && (doPathWithFC.compare(bracket, 4, "[MX]") == 0)) {
+        return IEC61850_FC_MX;
+    }
+
+    return IEC61850_FC_ST;
+}
+
+MmsValue *FakeIEC61850ClientConnection::createDOValue(const FunctionalConstraint &functionalConstraint,
+                                                      bool isTruncated)
+{
+    MmsValue *value = MmsValue_createEmptyStructure(isTruncated ? 2 : 3);
+
+    if (functionalConstraint == IEC61850_FC_MX) {
+        MmsValue *magnitude = MmsValue_createEmptyStructure(1);
+        MmsValue_setElement(magnitude, 0, MmsValue_newFloat(42.5f));
+        MmsValue_setElement(value, 0, magnitude);
+    } else {
+        MmsValue_setElement(value, 0, MmsValue_newBoolean(true));
+    }
+
+    MmsValue *quality = MmsValue_newBitString(13);
+    MmsValue_setBitStringFromInteger(quality, 0);
+    MmsValue_setElement(value, 1, quality);
+
+    if (! isTruncated) {
+        MmsValue_setElement(value, 2, MmsValue_newUtcTime(1700000000));
+    }
+
+    return value;
+}
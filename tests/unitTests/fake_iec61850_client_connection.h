@@ -0,0 +1,226 @@
+#ifndef INCLUDE_FAKE_IEC61850_CLIENT_CONNECTION_H_
+#define INCLUDE_FAKE_IEC61850_CLIENT_CONNECTION_H_
+
+/*
+ * Fledge IEC 61850 south plugin.
+ *
+ * Copyright (c) 2022, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+// local library
+#include "./iec61850_client_connection_interface.h"
+
+/** \class VirtualClock
+ *  \brief Time of a simulated IED, moved forward by its exchanges only
+ *
+ *  Thread safe.
+ */
+class VirtualClock
+{
+    public :
+        std::chrono::microseconds now() const { return std::chrono::microseconds(m_nowInUs.load()); }
+
+        void advance(std::chrono::microseconds duration);
+
+        /** \brief Move to 'time', if later than now (the clock never goes back) */
+        void advanceTo(std::chrono::microseconds time);
+
+    private:
+        std::atomic<int64_t> m_nowInUs{0};
+};
+
+/**
+ *  \brief Distribution of the round trip times of a simulated IED
+ */
+enum class RttDistribution {
+    CONSTANT = 0,
+    UNIFORM,
+    LOG_NORMAL
+};
+
+/**
+ *  \brief Behaviour of a simulated IED, and of the network in between
+ *
+ *  The random draws of a request depend only on the seed, on its reference
+ *  and on the number of previous requests with this reference: they do not
+ *  depend on the order of the requests of parallel threads.
+ */
+struct FakeIedProfile {
+    RttDistribution rttDistribution = RttDistribution::CONSTANT;
+    std::chrono::microseconds rtt{1000};     /**< constant RTT, minimum of the uniform, median of the log-normal */
+    std::chrono::microseconds maxRtt{1000};  /**< maximum of the uniform */
+    double rttSigma = 0.5;                   /**< standard deviation of the log of the log-normal */
+    std::chrono::microseconds rttPerItem{0}; /**< added per DO of the request (response size) */
+
+    double timeoutRatio = 0.0;               /**< requests without response, in [0, 1] */
+    std::chrono::microseconds requestTimeout{std::chrono::seconds(10)};
+
+    uint64_t disconnectAfterRequests = 0;    /**< the next request loses the connection (0: never) */
+    double structureMismatchRatio = 0.0;     /**< responses with an element missing, in [0, 1] */
+    unsigned int maxOutstandingCalls = 0;    /**< requests in flight above are refused (0: no limit) */
+
+    unsigned int maxPduSize = 65000;
+    uint64_t seed = 1;
+
+    std::size_t maxCallLogSize = 10000;      /**< requests kept in the call log, the later ones are only counted */
+};
+
+/**
+ *  \brief Outcome of a request sent to the simulated IED
+ */
+enum class FakeCallOutcome {
+    ANSWERED = 0,
+    STRUCTURE_MISMATCH,
+    TIMEOUT,
+    DISCONNECTED,
+    REFUSED,          /**< above the outstanding call limit */
+    OUTCOME_COUNT
+};
+
+/**
+ *  \brief Request sent to the simulated IED, in virtual time
+ */
+struct FakeCallRecord {
+    std::string method;     /**< "readDO", "readDataset" or "readMultipleDO" */
+    std::string reference;  /**< DO path, dataset reference or first DO path with FC */
+    std::size_t itemCount = 1;
+    ReadPriority priority = ReadPriority::NORMAL;
+    std::chrono::microseconds start{0};
+    std::chrono::microseconds rtt{0};
+    FakeCallOutcome outcome = FakeCallOutcome::ANSWERED;
+};
+
+/** \class FakeIEC61850ClientConnection
+ *  \brief Programmable connection to a simulated IED, without socket
+ *
+ *  Each request takes a virtual RTT drawn from the profile, and may time
+ *  out, lose the connection, be refused above the outstanding call limit
+ *  or get a response of a wrong structure. Nothing sleeps: the virtual
+ *  clock is moved forward to the end of each exchange.
+ *
+ *  Each thread has its own virtual time, from the start of the cycle
+ *  ('beginCycle'): the requests of parallel shards overlap in virtual time
+ *  as they would on the associations of a real IED, and the clock ends at
+ *  the end of the slowest shard.
+ *
+ *  The peak of outstanding calls is computed from all the exchanges of the
+ *  cycle, whatever their order of arrival. The refusals above
+ *  'maxOutstandingCalls' are decided when a request arrives, against the
+ *  exchanges already simulated: they only do not depend on the interleaving
+ *  of the threads with 1 shard (or without limit).
+ *
+ *  The DO with the MX functional constraint are MV (mag.f, q, t), the
+ *  others are SPS (stVal, q, t).
+ *  Thread safe.
+ */
+class FakeIEC61850ClientConnection : public IEC61850ClientConnectionInterface
+{
+    public :
+        FakeIEC61850ClientConnection(const FakeIedProfile &profile, VirtualClock &clock);
+
+        bool isConnected() override;
+        bool isConnecting() override { return false; }
+        bool keepAlive() override;
+        unsigned int getNegotiatedMaxPduSize() override { return m_profile.maxPduSize; }
+
+        RequestLatencies getRequestLatencies() const override;
+        ResponseTimeSummary takeResponseTimes() override;
+
+        std::shared_ptr<WrappedMms> readDO(const std::string &doPath,
+                                           const FunctionalConstraint &functionalConstraint,
+                                           IedClientError &error) override;
+
+        std::shared_ptr<WrappedMms> readDataset(const std::string &datasetRef,
+                                                IedClientError &error) override;
+
+        std::shared_ptr<WrappedMms> readMultipleDO(const std::vector<std::string> &doPathListWithFC,
+                                                   ReadPriority priority,
+                                                   IedClientError &error) override;
+
+        bool buildNameTree(const std::string &pathInDatamodel,
+                           const FunctionalConstraint &functionalConstraint,
+                           MmsNameNode *nameTree) override;
+
+        std::vector<std::string> getDoPathListWithFCFromDataset(const std::string &datasetRef) override;
+
+        bool createDataset(const std::string &datasetRef,
+                           const std::vector<std::string> &doPathListWithFC) override;
+
+        bool deleteDataset(const std::string &datasetRef) override;
+
+        /** \brief Dataset of the IED model, e.g. members "LD1/GGIO1.AnIn1[MX]" */
+        void setDataset(const std::string &datasetRef, const std::vector<std::string> &doPathListWithFC);
+
+        /** \brief Start of a reading cycle: each thread starts at the current virtual time */
+        void beginCycle();
+
+        void disconnect();
+
+        /** \brief Connection restored, the count of 'disconnectAfterRequests' starts again */
+        void reconnect();
+
+        std::vector<FakeCallRecord> getCallLog() const;
+        uint64_t getOutcomeCount(FakeCallOutcome outcome) const;
+
+        /** \brief Most requests in flight at once, since the creation */
+        unsigned int getPeakOutstandingCalls() const;
+
+    private:
+        std::chrono::microseconds drawRtt(uint64_t requestKey, std::size_t itemCount) const;
+        double drawUniform(uint64_t requestKey, uint64_t stream) const;
+
+        /** \brief Simulate the exchange of 1 request, in the virtual time of the calling thread */
+        FakeCallOutcome exchange(const char *method,
+                                 const std::string &reference,
+                                 std::size_t itemCount,
+                                 ReadPriority priority);
+
+        static IedClientError toRequestError(FakeCallOutcome outcome);
+
+        std::shared_ptr<WrappedMms> respond(FakeCallOutcome outcome,
+                                            const std::vector<std::string> &doPathListWithFC) const;
+
+        /** \brief Most exchanges in progress at once, among the given ones [start, end) */
+        static unsigned int countPeakOverlap(
+            const std::vector<std::pair<std::chrono::microseconds, std::chrono::microseconds>> &calls);
+
+        static FunctionalConstraint parseFunctionalConstraint(const std::string &doPathWithFC);
+        static MmsValue *createDOValue(const FunctionalConstraint &functionalConstraint, bool isTruncated);
+
+        FakeIedProfile m_profile;
+        VirtualClock &m_clock;
+
+        bool m_isConnected = true;
+        uint64_t m_requestsSinceConnection = 0;
+        std::unordered_map<std::string, uint64_t> m_requestCountByReference;
+        std::map<std::string, std::vector<std::string>> m_datasets;
+
+        std::chrono::microseconds m_cycleStart{0};
+        std::map<std::thread::id, std::chrono::microseconds> m_threadTimes;
+        /** (start and end of the requests of the cycle) */
+        std::vector<std::pair<std::chrono::microseconds, std::chrono::microseconds>> m_cycleCalls;
+        unsigned int m_peakOutstandingCalls = 0;  /**< of the previous cycles */
+
+        std::vector<FakeCallRecord> m_callLog;
+        std::array<uint64_t, static_cast<std::size_t>(FakeCallOutcome::OUTCOME_COUNT)> m_outcomeCounts{};
+        RequestLatencies m_latencies;
+        ResponseTimeSummary m_responseTimes;
+
+        mutable std::mutex m_mutex;  /**< Protect all the members above */
+};
+
+#endif  // INCLUDE_FAKE_IEC61850_CLIENT_CONNECTION_H_
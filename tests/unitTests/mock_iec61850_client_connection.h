@@ -20,16 +20,26 @@ class MockIEC61850ClientConnection : public IEC61850ClientConnectionInterface
 {
     public:
         MOCK_METHOD(bool, isConnected, (), (override));
-        MOCK_METHOD(bool, isNoError, (), (const, override));
-        MOCK_METHOD(void, logError, (), (const, override));
+        MOCK_METHOD(bool, isConnecting, (), (override));
+        MOCK_METHOD(bool, keepAlive, (), (override));
+        MOCK_METHOD(unsigned int, getNegotiatedMaxPduSize, (), (override));
+        MOCK_METHOD(RequestLatencies, getRequestLatencies, (), (const, override));
+        MOCK_METHOD(ResponseTimeSummary, takeResponseTimes, (), (override));
         MOCK_METHOD(std::shared_ptr<WrappedMms>,
                     readDO, (const std::string &doPath,
-                             const FunctionalConstraint &functionalConstraint), (override));
+                             const FunctionalConstraint &functionalConstraint,
+                             IedClientError &error), (override));
 
         MOCK_METHOD(std::shared_ptr<WrappedMms>,
-                    readDataset, (const std::string &datasetRef), (override));
+                    readDataset, (const std::string &datasetRef,
+                                  IedClientError &error), (override));
 
-        MOCK_METHOD(void,
+        MOCK_METHOD(std::shared_ptr<WrappedMms>,
+                    readMultipleDO, (const std::vector<std::string> &doPathListWithFC,
+                                     ReadPriority priority,
+                                     IedClientError &error), (override));
+
+        MOCK_METHOD(bool,
                     buildNameTree, (const std::string &pathInDatamodel,
                                     const FunctionalConstraint &functionalConstraint,
                                     MmsNameNode *nameTree), (override));
@@ -37,5 +47,14 @@ class MockIEC61850ClientConnection : public IEC61850ClientConnectionInterface
         MOCK_METHOD(std::vector<std::string>,
                     getDoPathListWithFCFromDataset,
                     (const std::string &datasetRef), (override));
+
+        MOCK_METHOD(bool,
+                    createDataset,
+                    (const std::string &datasetRef,
+                     const std::vector<std::string> &doPathListWithFC), (override));
+
+        MOCK_METHOD(bool,
+                    deleteDataset,
+                    (const std::string &datasetRef), (override));
 };
 #endif  // INCLUDE_MOCK_IEC61850_CLIENT_CONNECTION_H_
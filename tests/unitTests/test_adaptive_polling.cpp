@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <chrono>  // NOLINT
+#include <string>
+
+// South_IEC61850_Plugin headers
+#include "iec61850_adaptive_polling.h"
+
+using namespace ::testing;
+
+static PollingPeriodBounds makeBounds(unsigned int minPeriodInMs, unsigned int maxPeriodInMs)
+{
+    PollingPeriodBounds bounds;
+    bounds.minPeriodInMs = minPeriodInMs;
+    bounds.maxPeriodInMs = maxPeriodInMs;
+    return bounds;
+}
+
+TEST(IEC61850AdaptivePollingTest, adaptPeriodToChanges)
+{
+    // Test Init
+    IEC61850AdaptivePolling adaptivePolling;
+    PollingPeriodBounds bounds = makeBounds(100, 1000);
+    std::chrono::steady_clock::time_point now(std::chrono::seconds(100));
+    std::chrono::milliseconds tolerance(0);
+
+    // Test Body: a new unit is due at once, at its min period
+    ASSERT_TRUE(adaptivePolling.isDue("DO1", bounds, now, tolerance));
+    adaptivePolling.recordRead("DO1", 42, now);
+    ASSERT_FALSE(adaptivePolling.isDue("DO1", bounds, now + std::chrono::milliseconds(99), tolerance));
+    ASSERT_TRUE(adaptivePolling.isDue("DO1", bounds, now + std::chrono::milliseconds(100), tolerance));
+
+    /** The period lengthens while the value is unchanged, up to the max period */
+    for (int read = 0; read < 10; ++read) {
+        now += std::chrono::seconds(1);
+        adaptivePolling.recordRead("DO1", 42, now);
+    }
+
+    PollingRateDistribution distribution = adaptivePolling.getDistribution();
+    ASSERT_EQ(1, distribution.unitCount);
+    ASSERT_EQ(std::chrono::milliseconds(1000), distribution.longestPeriod);
+    ASSERT_EQ(1, distribution.unitsAtMaxPeriod);
+    ASSERT_FALSE(adaptivePolling.isDue("DO1", bounds, now + std::chrono::milliseconds(999), tolerance));
+
+    /** Each change halves the period, down to the min period */
+    adaptivePolling.recordRead("DO1", 43, now);
+    ASSERT_EQ(std::chrono::milliseconds(500), adaptivePolling.getDistribution().shortestPeriod);
+
+    for (int read = 0; read < 5; ++read) {
+        adaptivePolling.recordRead("DO1", 44 + read, now);
+    }
+
+    distribution = adaptivePolling.getDistribution();
+    ASSERT_EQ(std::chrono::milliseconds(100), distribution.shortestPeriod);
+    ASSERT_EQ(1, distribution.unitsAtMinPeriod);
+    ASSERT_DOUBLE_EQ(10.0, distribution.readsPerSecond);
+
+    /** The tolerance absorbs the jitter of the cycles */
+    ASSERT_TRUE(adaptivePolling.isDue("DO1", bounds, now + std::chrono::milliseconds(60),
+                                      std::chrono::milliseconds(50)));
+
+    /** A new configuration starts again */
+    adaptivePolling.clear();
+    ASSERT_EQ(0, adaptivePolling.getDistribution().unitCount);
+}
+
+TEST(IEC61850AdaptivePollingTest, followNewBounds)
+{
+    // Test Init
+    IEC61850AdaptivePolling adaptivePolling;
+    std::chrono::steady_clock::time_point now(std::chrono::seconds(100));
+
+    ASSERT_TRUE(adaptivePolling.isDue("DS1", makeBounds(100, 1000), now, std::chrono::milliseconds(0)));
+    adaptivePolling.recordRead("DS1", 1, now);
+
+    // Test Body: the period is clamped in the new bounds
+    adaptivePolling.isDue("DS1", makeBounds(200, 400), now, std::chrono::milliseconds(0));
+    ASSERT_EQ(std::chrono::milliseconds(200), adaptivePolling.getDistribution().shortestPeriod);
+}
+
+TEST(IEC61850AdaptivePollingTest, resolveBounds)
+{
+    PollingPeriodBounds defaultBounds = makeBounds(500, 60000);
+
+    // Test Body: the unset bounds are the default ones
+    PollingPeriodBounds bounds = IEC61850AdaptivePolling::resolveBounds(makeBounds(0, 5000), defaultBounds);
+    ASSERT_EQ(500, bounds.minPeriodInMs);
+    ASSERT_EQ(5000, bounds.maxPeriodInMs);
+
+    /** (the max period is never below the min period) */
+    bounds = IEC61850AdaptivePolling::resolveBounds(makeBounds(100000, 0), defaultBounds);
+    ASSERT_EQ(100000, bounds.minPeriodInMs);
+    ASSERT_EQ(100000, bounds.maxPeriodInMs);
+
+    /** A group follows its most demanding member */
+    bounds = IEC61850AdaptivePolling::tightestBounds(makeBounds(100, 60000), makeBounds(1000, 2000));
+    ASSERT_EQ(100, bounds.minPeriodInMs);
+    ASSERT_EQ(2000, bounds.maxPeriodInMs);
+}
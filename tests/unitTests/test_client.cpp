@@ -1,4 +1,9 @@
+#include <chrono>  // NOLINT
+#include <future>
+#include <mutex>   // NOLINT
+#include <set>
 #include <string>
+#include <thread>  // NOLINT
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
@@ -6,8 +11,10 @@
 // Fledge headers
 #include <config_category.h>
 
+#include "iec61850.h"
 #include "iec61850_client.h"
 #include "iec61850_client_config.h"
+#include "fake_iec61850_client_connection.h"
 #include "mock_iec61850_client_connection.h"
 
 using namespace ::testing;
@@ -150,6 +157,27 @@ TEST(IEC61850ClientTest, initializeConnectionFailed)
     initializeConnectionThread.join();
 }
 
+TEST(IEC61850ClientTest, noConnectionAfterStopOrder)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+    // Test Body
+    client.requestStop();
+    client.initializeConnection();
+    ASSERT_THAT(client.m_connection, IsNull());
+    client.launch();
+    ASSERT_THAT(client.m_connection, IsNull());
+    ASSERT_EQ(false, client.m_isMmsReadingActivated);
+}
+
 TEST(IEC61850ClientTest, startAndStop)
 {
     // Configuration of the Mock objects
@@ -160,12 +188,10 @@ TEST(IEC61850ClientTest, startAndStop)
     .Times(5)
     .WillRepeatedly(Return(true));
     EXPECT_CALL(mockConnectedConnection, buildNameTree(_, _, _))
-    .Times(1);
-    EXPECT_CALL(mockConnectedConnection, readDO(_, _))
+    .WillOnce(Return(true));
+    EXPECT_CALL(mockConnectedConnection, readDO(_, _, _))
     .Times(2)
     .WillRepeatedly(Return(empty_mms));
-    EXPECT_CALL(mockConnectedConnection, isNoError())
-    .WillRepeatedly(Return(true));
     // End of configuration of the Mock objects
     // Test Init
     ServerConnectionParameters connParam;
@@ -188,7 +214,8 @@ TEST(IEC61850ClientTest, startAndStop)
     std::thread startClientThread(&IEC61850Client::start,
                                   &client);
     IEC61850ClientTest_injectMockConnection_Test::injectMockConnection(client, &mockConnectedConnection);
-    sleep(3);
+    // The reading starts as soon as connected: 2 reading cycles, at 0 and 1 s
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
     ASSERT_THAT(client.m_connection, NotNull());
     ASSERT_EQ(true, client.m_connection->isConnected());
     ASSERT_EQ(false, client.m_stopOrder);
@@ -523,3 +550,1358 @@ TEST(IEC61850ClientTest, buildComplexDatapointWithErroneousStructure)
         FAIL();
     }
 }
+
+TEST(IEC61850ClientTest, createDynamicDatasetsByLogicalDevice)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+    applicationParams.useDynamicDatasets = true;
+
+    DatapointConfig dpConfig;
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO1";
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    exchangedData.push_back(dpConfig);
+    dpConfig.dataPath = "LD1/GGIO1.AnIn1";
+    dpConfig.functionalConstraint = IEC61850_FC_MX;
+    exchangedData.push_back(dpConfig);
+    dpConfig.dataPath = "LD2/GGIO1.SPSSO1";
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    exchangedData.push_back(dpConfig);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    EXPECT_CALL(*mockConnection, createDataset("@FledgeDO0",
+                                               ElementsAre("LD1/GGIO1.SPSSO1[ST]",
+                                                           "LD1/GGIO1.AnIn1[MX]")))
+    .WillOnce(Return(true));
+    EXPECT_CALL(*mockConnection, createDataset("@FledgeDO1",
+                                               ElementsAre("LD2/GGIO1.SPSSO1[ST]")))
+    .WillOnce(Return(true));
+    client.m_connection.reset(mockConnection);
+
+    // Test Body
+    client.createDynamicDatasets();
+
+    ASSERT_EQ(2, client.m_dynamicDatasetMembers.size());
+    ASSERT_THAT(client.m_dynamicDatasetMembers["@FledgeDO0"], ElementsAre(0, 1));
+    ASSERT_THAT(client.m_dynamicDatasetMembers["@FledgeDO1"], ElementsAre(2));
+    ASSERT_THAT(client.m_isReadByDynamicDataset, ElementsAre(true, true, true));
+}
+
+TEST(IEC61850ClientTest, createDynamicDatasetsWithinPduSize)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+    applicationParams.useDynamicDatasets = true;
+
+    DatapointConfig dpConfig;
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO1";
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    exchangedData.push_back(dpConfig);
+    dpConfig.dataPath = "LD1/GGIO1.AnIn1";
+    dpConfig.functionalConstraint = IEC61850_FC_MX;
+    exchangedData.push_back(dpConfig);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    /** The creation request of both DO does not fit in the PDU */
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    EXPECT_CALL(*mockConnection, getNegotiatedMaxPduSize())
+    .WillRepeatedly(Return(80));
+    EXPECT_CALL(*mockConnection, createDataset("@FledgeDO0",
+                                               ElementsAre("LD1/GGIO1.SPSSO1[ST]")))
+    .WillOnce(Return(true));
+    EXPECT_CALL(*mockConnection, createDataset("@FledgeDO1",
+                                               ElementsAre("LD1/GGIO1.AnIn1[MX]")))
+    .WillOnce(Return(true));
+    client.m_connection.reset(mockConnection);
+
+    // Test Body
+    client.createDynamicDatasets();
+
+    ASSERT_EQ(2, client.m_dynamicDatasetMembers.size());
+    ASSERT_THAT(client.m_dynamicDatasetMembers["@FledgeDO0"], ElementsAre(0));
+    ASSERT_THAT(client.m_dynamicDatasetMembers["@FledgeDO1"], ElementsAre(1));
+    ASSERT_THAT(client.m_isReadByDynamicDataset, ElementsAre(true, true));
+}
+
+TEST(IEC61850ClientTest, createDynamicDatasetsRefused)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+    applicationParams.useDynamicDatasets = true;
+
+    DatapointConfig dpConfig;
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO1";
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    exchangedData.push_back(dpConfig);
+    dpConfig.dataPath = "LD1/GGIO1.AnIn1";
+    dpConfig.functionalConstraint = IEC61850_FC_MX;
+    exchangedData.push_back(dpConfig);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    EXPECT_CALL(*mockConnection, createDataset(_, _))
+    .WillOnce(Return(false));
+    EXPECT_CALL(*mockConnection, readDataset(_, _))
+    .Times(0);
+    EXPECT_CALL(*mockConnection, readDO(_, _, _))
+    .Times(2)
+    .WillRepeatedly(Return(nullptr));
+    client.m_connection.reset(mockConnection);
+
+    // Test Body: fall back to the DO by DO reading
+    client.buildConfigurationNameTrees();
+
+    ASSERT_EQ(0, client.m_dynamicDatasetMembers.size());
+    ASSERT_THAT(client.m_isReadByDynamicDataset, ElementsAre(false, false));
+    /** The name may exist on some associations: the next dataset has another one */
+    ASSERT_EQ(1, client.m_associationDatasetCount);
+
+    client.readAndExportAllDO();
+}
+
+/** A dataset of 4 members, with 1 selected member */
+static ExchangedDatasets buildSelectionOfOneMemberOutOfFour(MockIEC61850ClientConnection *mockConnection)
+{
+    ExchangedDatasets selectedDOInExchangedDatasets;
+    DatapointConfig selectedDO;
+    selectedDO.dataPath = "SPSSO2";
+    selectedDO.label = "TS2";
+    selectedDOInExchangedDatasets["LD1/LLN0.Events"].push_back(selectedDO);
+
+    EXPECT_CALL(*mockConnection, getDoPathListWithFCFromDataset("LD1/LLN0.Events"))
+    .WillRepeatedly(Return(std::vector<std::string>({"LD1/GGIO1.SPSSO1[ST]",
+                                                     "LD1/GGIO1.SPSSO2[ST]",
+                                                     "LD1/GGIO1.SPSSO3[ST]",
+                                                     "LD1/GGIO1.SPSSO4[ST]"})));
+
+    return selectedDOInExchangedDatasets;
+}
+
+TEST(IEC61850ClientTest, readFullDatasetAboveThreshold)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ApplicationParameters applicationParams;
+    applicationParams.readMode = ReadMode::DATASET_READING;
+    applicationParams.partialReadThreshold = 0.25f;
+
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    ExchangedDatasets exchangedDatasets = buildSelectionOfOneMemberOutOfFour(mockConnection);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    EXPECT_CALL(*mockConnection, createDataset(_, _))
+    .Times(0);
+    client.m_connection.reset(mockConnection);
+
+    // Test Body: 1/4 is not below the threshold
+    client.buildConfigurationNameTrees();
+
+    ASSERT_EQ(1, client.m_localExchangedDatasets.size());
+    ASSERT_EQ(4, client.m_localExchangedDatasets["LD1/LLN0.Events"].size());
+    ASSERT_EQ(DatasetReadStrategy::FULL_DATASET,
+              client.m_datasetReadStrategies["LD1/LLN0.Events"]);
+}
+
+TEST(IEC61850ClientTest, readTrimmedDatasetBelowThreshold)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ApplicationParameters applicationParams;
+    applicationParams.readMode = ReadMode::DATASET_READING;
+    applicationParams.partialReadThreshold = 0.5f;
+
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    ExchangedDatasets exchangedDatasets = buildSelectionOfOneMemberOutOfFour(mockConnection);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    EXPECT_CALL(*mockConnection, createDataset("@FledgeDS0",
+                                               ElementsAre("LD1/GGIO1.SPSSO2[ST]")))
+    .WillOnce(Return(true));
+    EXPECT_CALL(*mockConnection, readDataset("@FledgeDS0", _))
+    .WillOnce(Return(nullptr));
+    EXPECT_CALL(*mockConnection, readMultipleDO(_, ReadPriority::NORMAL, _))
+    .Times(0);
+    client.m_connection.reset(mockConnection);
+
+    // Test Body
+    client.buildConfigurationNameTrees();
+
+    ASSERT_EQ(1, client.m_localExchangedDatasets.size());
+    ASSERT_EQ(1, client.m_localExchangedDatasets["@FledgeDS0"].size());
+    ASSERT_EQ("TS2", client.m_localExchangedDatasets["@FledgeDS0"][0].label);
+    ASSERT_EQ(DatasetReadStrategy::TRIMMED_DATASET,
+              client.m_datasetReadStrategies["@FledgeDS0"]);
+
+    client.readAndExportAllDatasets();
+}
+
+TEST(IEC61850ClientTest, readSelectedMembersWhenTrimRefused)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ApplicationParameters applicationParams;
+    applicationParams.readMode = ReadMode::DATASET_READING;
+    applicationParams.partialReadThreshold = 0.5f;
+
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    ExchangedDatasets exchangedDatasets = buildSelectionOfOneMemberOutOfFour(mockConnection);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    EXPECT_CALL(*mockConnection, createDataset(_, _))
+    .WillOnce(Return(false));
+    EXPECT_CALL(*mockConnection, readDataset(_, _))
+    .Times(0);
+    EXPECT_CALL(*mockConnection, readMultipleDO(ElementsAre("LD1/GGIO1.SPSSO2[ST]"), ReadPriority::NORMAL, _))
+    .WillOnce(Return(nullptr));
+    client.m_connection.reset(mockConnection);
+
+    // Test Body: fall back to the reading of the selected members only
+    client.buildConfigurationNameTrees();
+
+    ASSERT_EQ(1, client.m_localExchangedDatasets["LD1/LLN0.Events"].size());
+    ASSERT_EQ(DatasetReadStrategy::SELECTED_MEMBERS,
+              client.m_datasetReadStrategies["LD1/LLN0.Events"]);
+
+    client.readAndExportAllDatasets();
+}
+
+TEST(IEC61850ClientTest, splitDoPathWithFC)
+{
+    std::string doPath;
+    FunctionalConstraint functionalConstraint;
+
+    IEC61850Client::splitDoPathWithFC("LD1/GGIO1.AnIn1[MX]", doPath, functionalConstraint);
+    ASSERT_EQ("LD1/GGIO1.AnIn1", doPath);
+    ASSERT_EQ(IEC61850_FC_MX, functionalConstraint);
+
+    IEC61850Client::splitDoPathWithFC("LD1/GGIO1.SPSSO1", doPath, functionalConstraint);
+    ASSERT_EQ("LD1/GGIO1.SPSSO1", doPath);
+    ASSERT_EQ(IEC61850_FC_NONE, functionalConstraint);
+
+    IEC61850Client::splitDoPathWithFC("LD1/GGIO1.SPSSO1[S", doPath, functionalConstraint);
+    ASSERT_EQ("LD1/GGIO1.SPSSO1", doPath);
+    ASSERT_EQ(IEC61850_FC_NONE, functionalConstraint);
+}
+
+TEST(IEC61850ClientTest, matchSelectedDOExactly)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ApplicationParameters applicationParams;
+    applicationParams.readMode = ReadMode::DATASET_READING;
+
+    ExchangedDatasets exchangedDatasets;
+    DatapointConfig selectedDO;
+    selectedDO.dataPath = "SPSSO1";
+    selectedDO.label = "TS1";
+    exchangedDatasets["LD1/LLN0.Events"].push_back(selectedDO);
+    selectedDO.dataPath = "PhV.phsA";
+    selectedDO.label = "TM1";
+    exchangedDatasets["LD1/LLN0.Events"].push_back(selectedDO);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    EXPECT_CALL(*mockConnection, getDoPathListWithFCFromDataset("LD1/LLN0.Events"))
+    .WillOnce(Return(std::vector<std::string>({"LD1/GGIO1.SPSSO10[ST]",
+                                               "LD1/GGIO1.SPSSO1[ST]",
+                                               "LD1/MMXU1.PhV.phsA[MX]",
+                                               "LD1/MMXU1.PhV.phsAB[MX]"})));
+    client.m_connection.reset(mockConnection);
+
+    // Test Body: 'SPSSO1' does not select 'SPSSO10'
+    client.buildConfigurationNameTrees();
+
+    const ExchangedData &dataset = client.m_localExchangedDatasets["LD1/LLN0.Events"];
+    ASSERT_EQ(4, dataset.size());
+    ASSERT_EQ("", dataset[0].label);
+    ASSERT_EQ("TS1", dataset[1].label);
+    ASSERT_EQ(IEC61850_FC_ST, dataset[1].functionalConstraint);
+    ASSERT_EQ("TM1", dataset[2].label);
+    ASSERT_EQ("LD1/MMXU1.PhV.phsA", dataset[2].dataPath);
+    ASSERT_EQ(IEC61850_FC_MX, dataset[2].functionalConstraint);
+    ASSERT_EQ("", dataset[3].label);
+}
+
+TEST(IEC61850ClientTest, matchSelectedDOOnDataAttributeMember)
+{
+    std::unordered_map<std::string, const DatapointConfig *> selectedDOByName;
+    DatapointConfig spsso1;
+    DatapointConfig phv;
+    selectedDOByName.emplace("SPSSO1", &spsso1);
+    selectedDOByName.emplace("PhV", &phv);
+    std::string nameBuffer;
+
+    /** A member of a dataset can be a data attribute of the selected DO */
+    ASSERT_EQ(&spsso1, IEC61850Client::findSelectedDO("LD1/GGIO1.SPSSO1.stVal", selectedDOByName, nameBuffer));
+    ASSERT_EQ(&phv, IEC61850Client::findSelectedDO("LD1/MMXU1.PhV.phsA.cVal", selectedDOByName, nameBuffer));
+    ASSERT_EQ(nullptr, IEC61850Client::findSelectedDO("LD1/GGIO1.SPSSO10.stVal", selectedDOByName, nameBuffer));
+    ASSERT_EQ(nullptr, IEC61850Client::findSelectedDO("LD1/GGIO1", selectedDOByName, nameBuffer));
+}
+
+TEST(IEC61850ClientTest, readDOBeforeDiscovery)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+
+    DatapointConfig dpConfig;
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO1";
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    exchangedData.push_back(dpConfig);
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO2";
+    exchangedData.push_back(dpConfig);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    auto boolean_mms = std::make_shared<WrappedMms>();
+    boolean_mms->setMmsValue(MmsValue_newBoolean(true));
+
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    EXPECT_CALL(*mockConnection, buildNameTree("LD1/GGIO1.SPSSO1", _, _))
+    .WillOnce(Return(true));
+    EXPECT_CALL(*mockConnection, buildNameTree("LD1/GGIO1.SPSSO2", _, _))
+    .WillOnce(Return(true));
+    EXPECT_CALL(*mockConnection, readDO(_, _, _))
+    .Times(4)
+    .WillRepeatedly(Return(boolean_mms));
+    client.m_connection.reset(mockConnection);
+
+    // Test Body: 1 DO per discovery step (the deadline is already reached)
+    client.resetDiscovery();
+    ASSERT_FALSE(client.discoverNameTrees(std::chrono::steady_clock::now()));
+    ASSERT_EQ(1, client.m_discoveredDOCount);
+    ASSERT_THAT(client.m_nameTrees[1], IsNull());
+
+    /** The 2nd DO is read too, its structure is resolved with its 1st value */
+    client.readAndExportAllDO();
+    ASSERT_THAT(client.m_nameTrees[1], NotNull());
+
+    /** and is not resolved again by the discovery */
+    ASSERT_TRUE(client.discoverNameTrees(std::chrono::steady_clock::now()));
+    ASSERT_EQ(2, client.m_discoveredDOCount);
+    ASSERT_TRUE(client.m_isDiscoveryComplete);
+    client.readAndExportAllDO();
+}
+
+TEST(IEC61850ClientTest, retryNameTreeAfterFailedQuery)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+
+    DatapointConfig dpConfig;
+    dpConfig.label = "TS1";
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO1";
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    exchangedData.push_back(dpConfig);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    auto boolean_mms = std::make_shared<WrappedMms>();
+    boolean_mms->setMmsValue(MmsValue_newBoolean(true));
+
+    /** The first query times out, the second one is answered */
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    EXPECT_CALL(*mockConnection, buildNameTree("LD1/GGIO1.SPSSO1", _, _))
+    .WillOnce(Return(false))
+    .WillOnce(Invoke([](const std::string &, const FunctionalConstraint &, MmsNameNode *nameTree) {
+        auto daNode = std::make_shared<MmsNameNode>();
+        daNode->mmsName = "stVal";
+        nameTree->children.push_back(daNode);
+        return true;
+    }));
+    EXPECT_CALL(*mockConnection, readDO(_, _, _))
+    .Times(2)
+    .WillRepeatedly(Return(boolean_mms));
+    client.m_connection.reset(mockConnection);
+
+    // Test Body: no tree is kept after the failed query
+    client.resetDiscovery();
+    ASSERT_TRUE(client.discoverNameTrees(std::chrono::steady_clock::time_point::max()));
+    ASSERT_THAT(client.m_nameTrees[0], IsNull());
+
+    /** the first value queries it again */
+    client.readAndExportAllDO();
+    ASSERT_THAT(client.m_nameTrees[0], NotNull());
+    ASSERT_EQ("TS1", client.m_nameTrees[0]->mmsName);
+    ASSERT_EQ(1, client.m_nameTrees[0]->children.size());
+
+    /** and only once */
+    client.readAndExportAllDO();
+}
+
+TEST(IEC61850ClientTest, skipValueWithUnknownStructure)
+{
+    // Test Init: 2 DO read in the same shard, the structure query of the first one fails
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+
+    DatapointConfig dpConfig;
+    dpConfig.label = "TS1";
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO1";
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    exchangedData.push_back(dpConfig);
+    dpConfig.label = "TS2";
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO2";
+    exchangedData.push_back(dpConfig);
+
+    IEC61850 iec61850;
+    IEC61850Client client(&iec61850,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    auto boolean_mms = std::make_shared<WrappedMms>();
+    boolean_mms->setMmsValue(MmsValue_newBoolean(true));
+
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    EXPECT_CALL(*mockConnection, buildNameTree("LD1/GGIO1.SPSSO1", _, _))
+    .Times(2)
+    .WillRepeatedly(Return(false));
+    EXPECT_CALL(*mockConnection, buildNameTree("LD1/GGIO1.SPSSO2", _, _))
+    .WillOnce(Invoke([](const std::string &, const FunctionalConstraint &, MmsNameNode *nameTree) {
+        auto daNode = std::make_shared<MmsNameNode>();
+        daNode->mmsName = "stVal";
+        nameTree->children.push_back(daNode);
+        return true;
+    }));
+    EXPECT_CALL(*mockConnection, readDO(_, _, _))
+    .Times(4)
+    .WillRepeatedly(Return(boolean_mms));
+    client.m_connection.reset(mockConnection);
+
+    // Test Body: the value of TS1 is skipped, TS2 is still exported
+    client.readAndExportAllDO();
+    ASSERT_THAT(client.m_nameTrees[0], IsNull());
+    ASSERT_THAT(client.m_nameTrees[1], NotNull());
+
+    /** and the structure of TS1 is queried again with its next value */
+    client.readAndExportAllDO();
+
+    RuntimeStatisticsSnapshot snapshot = client.m_runtimeStatistics.takeSnapshot(std::chrono::steady_clock::now());
+    ASSERT_EQ(2, snapshot.readingCount);
+    ASSERT_EQ(0, snapshot.conversionErrorCount);
+}
+
+TEST(IEC61850ClientTest, waitForDiscoverySlot)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+
+    DatapointConfig dpConfig;
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO1";
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    exchangedData.push_back(dpConfig);
+
+    IEC61850DiscoveryCoordinator coordinator(1);
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams,
+                          &coordinator);
+
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    EXPECT_CALL(*mockConnection, buildNameTree(_, _, _))
+    .WillOnce(Return(true));
+    client.m_connection.reset(mockConnection);
+    client.resetDiscovery();
+
+    // Test Body: the only slot is taken by another client
+    std::atomic<bool> noStopOrder{false};
+    auto otherTicket = coordinator.enqueue(0);
+    ASSERT_TRUE(coordinator.waitForSlot(otherTicket, std::chrono::milliseconds(0), noStopOrder));
+
+    ASSERT_TRUE(client.discoverConfigurationStep(std::chrono::milliseconds(10)));
+    ASSERT_EQ(0, client.m_discoveredDOCount);
+    ASSERT_TRUE(client.m_isDiscoveryQueued);
+
+    coordinator.release();
+
+    ASSERT_FALSE(client.discoverConfigurationStep(std::chrono::milliseconds(10)));
+    ASSERT_EQ(1, client.m_discoveredDOCount);
+    ASSERT_FALSE(client.m_isDiscoveryQueued);
+    ASSERT_EQ(0, coordinator.m_runningDiscoveries);
+}
+
+TEST(IEC61850ClientTest, shareNameSubtrees)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+
+    DatapointConfig dpConfig;
+    dpConfig.label = "TS1";
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO1";
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    exchangedData.push_back(dpConfig);
+    dpConfig.label = "TS2";
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO2";
+    exchangedData.push_back(dpConfig);
+
+    IEC61850NameTreeCache nameTreeCache;
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams,
+                          nullptr,
+                          &nameTreeCache);
+
+    /** Same structure for both DO: stVal, q, t */
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    EXPECT_CALL(*mockConnection, buildNameTree(_, _, _))
+    .Times(2)
+    .WillRepeatedly(Invoke([](const std::string &, const FunctionalConstraint &, MmsNameNode *nameTree) {
+        for (const char *daName : {"stVal", "q", "t"}) {
+            auto daNode = std::make_shared<MmsNameNode>();
+            daNode->mmsName = daName;
+            nameTree->children.push_back(daNode);
+        }
+        return true;
+    }));
+    client.m_connection.reset(mockConnection);
+
+    // Test Body
+    client.buildConfigurationNameTrees();
+
+    ASSERT_EQ("TS1", client.m_nameTrees[0]->mmsName);
+    ASSERT_EQ("TS2", client.m_nameTrees[1]->mmsName);
+    ASSERT_EQ(client.m_nameTrees[0]->children[0].get(), client.m_nameTrees[1]->children[0].get());
+    ASSERT_EQ(3, nameTreeCache.size());
+
+    /** The configuration is shared, not copied */
+    ASSERT_EQ(&exchangedData, client.m_exchangedData);
+}
+
+TEST(IEC61850ClientTest, updateConfigurationKeepsNameTrees)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    connParam.ipAddress = "127.0.0.1";
+    connParam.mmsPort = 102;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+
+    DatapointConfig dpConfig;
+    dpConfig.label = "TS1";
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO1";
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    exchangedData.push_back(dpConfig);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    EXPECT_CALL(*mockConnection, buildNameTree(_, _, _))
+    .Times(2)
+    .WillRepeatedly(Invoke([](const std::string &, const FunctionalConstraint &, MmsNameNode *nameTree) {
+        auto daNode = std::make_shared<MmsNameNode>();
+        daNode->mmsName = "stVal";
+        nameTree->children.push_back(daNode);
+        return true;
+    }));
+    client.m_connection.reset(mockConnection);
+    client.buildConfigurationNameTrees();
+    const MmsNameNode *stValNode = client.m_nameTrees[0]->children[0].get();
+
+    /** New configuration: TS1 renamed, TS2 added */
+    auto newConfig = std::make_shared<IEC61850ClientConfig>();
+    newConfig->serverConfigDict[IEC61850ClientConfig::buildKey(connParam)] = connParam;
+    dpConfig.label = "TS2";
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO2";
+    newConfig->exchangedData.push_back(dpConfig);
+    dpConfig.label = "TS1_renamed";
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO1";
+    newConfig->exchangedData.push_back(dpConfig);
+
+    // Test Body
+    client.updateConfiguration(newConfig);
+    ASSERT_EQ(&exchangedData, client.m_exchangedData);  // applied between 2 poll cycles only
+    client.applyPendingConfiguration();
+
+    ASSERT_EQ(&(newConfig->exchangedData), client.m_exchangedData);
+    ASSERT_EQ(2, client.m_nameTrees.size());
+    ASSERT_THAT(client.m_nameTrees[0], IsNull());
+    ASSERT_THAT(client.m_nameTrees[1], NotNull());
+    ASSERT_EQ("TS1_renamed", client.m_nameTrees[1]->mmsName);
+    ASSERT_EQ(stValNode, client.m_nameTrees[1]->children[0].get());
+
+    /** Only the added DO is discovered */
+    client.discoverNameTrees(std::chrono::steady_clock::time_point::max());
+    ASSERT_EQ("TS2", client.m_nameTrees[0]->mmsName);
+}
+
+TEST(IEC61850ClientTest, deleteDatasetsOnReconfiguration)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    /** 1 dynamic dataset, 1 trimmed dataset and 1 dataset of the IED model */
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    client.m_connection.reset(mockConnection);
+    client.m_associationDatasetCount = 2;
+    client.m_dynamicDatasetMembers["@FledgeDO0"] = {0};
+    client.m_datasetReadStrategies["@FledgeDS1"] = DatasetReadStrategy::TRIMMED_DATASET;
+    client.m_datasetReadStrategies["LD1/LLN0.Mags"] = DatasetReadStrategy::FULL_DATASET;
+
+    EXPECT_CALL(*mockConnection, deleteDataset("@FledgeDO0"))
+    .WillOnce(Return(true));
+    EXPECT_CALL(*mockConnection, deleteDataset("@FledgeDS1"))
+    .WillOnce(Return(true));
+    EXPECT_CALL(*mockConnection, deleteDataset("LD1/LLN0.Mags"))
+    .Times(0);
+
+    auto newConfig = std::make_shared<IEC61850ClientConfig>();
+    newConfig->serverConfigDict[IEC61850ClientConfig::buildKey(connParam)] = connParam;
+
+    // Test Body: the datasets created on the kept associations are freed
+    client.updateConfiguration(newConfig);
+    client.applyPendingConfiguration();
+
+    ASSERT_TRUE(client.m_dynamicDatasetMembers.empty());
+    ASSERT_TRUE(client.m_datasetReadStrategies.empty());
+    ASSERT_EQ(2, client.m_associationDatasetCount);
+    Mock::VerifyAndClearExpectations(mockConnection);
+
+    /** On a new connection, the datasets were lost with the previous one */
+    client.m_dynamicDatasetMembers["@FledgeDO2"] = {0};
+    EXPECT_CALL(*mockConnection, deleteDataset(_))
+    .Times(0);
+    client.resetDiscovery();
+    ASSERT_EQ(0, client.m_associationDatasetCount);
+}
+
+TEST(IEC61850ClientTest, stopDuringPollingPeriod)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+    applicationParams.readPollingPeriodInMs = 60000;
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    auto *mockConnection = new NiceMock<MockIEC61850ClientConnection>();
+    ON_CALL(*mockConnection, isConnected()).WillByDefault(Return(true));
+    client.m_connection.reset(mockConnection);
+
+    client.startMmsReading();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    // Test Body: the stop does not wait for the end of the polling period
+    auto startTime = std::chrono::steady_clock::now();
+    client.stop();
+    auto stopLatency = std::chrono::steady_clock::now() - startTime;
+
+    ASSERT_LT(stopLatency, std::chrono::milliseconds(500));
+    ASSERT_EQ(false, client.m_mmsReadingThread.joinable());
+    ASSERT_THAT(client.m_connection, IsNull());
+}
+
+TEST(IEC61850ClientTest, reconnectWithBackoff)
+{
+    ServerConnectionParameters connParam;
+    connParam.reconnectMinDelayInMs = 1000;
+    connParam.reconnectMaxDelayInMs = 10000;
+
+    // Exponential growth, up to the maximum delay
+    ASSERT_EQ(1000, IEC61850Client::computeReconnectDelay(1, connParam, 1.0).count());
+    ASSERT_EQ(2000, IEC61850Client::computeReconnectDelay(2, connParam, 1.0).count());
+    ASSERT_EQ(8000, IEC61850Client::computeReconnectDelay(4, connParam, 1.0).count());
+    ASSERT_EQ(10000, IEC61850Client::computeReconnectDelay(5, connParam, 1.0).count());
+    ASSERT_EQ(10000, IEC61850Client::computeReconnectDelay(1000, connParam, 1.0).count());
+
+    // The jitter draws the delay in [delay/2, delay]
+    ASSERT_EQ(500, IEC61850Client::computeReconnectDelay(1, connParam, 0.0).count());
+    ASSERT_EQ(3000, IEC61850Client::computeReconnectDelay(3, connParam, 0.5).count());
+
+    // Statistics of a failed attempt
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+    client.m_connectStartTime = std::chrono::steady_clock::now();
+    client.recordConnectionFailure();
+    std::chrono::milliseconds reconnectDelay = client.recordConnectionFailure();
+
+    ReconnectStatistics statistics = client.getReconnectStatistics();
+    ASSERT_EQ(2, statistics.connectAttempts);
+    ASSERT_EQ(2, statistics.connectFailures);
+    ASSERT_EQ(2, statistics.consecutiveFailures);
+    ASSERT_EQ(reconnectDelay, statistics.lastReconnectDelay);
+    ASSERT_GE(reconnectDelay.count(), 1000);
+    ASSERT_LE(reconnectDelay.count(), 2000);
+
+    client.recordConnectionSuccess();
+    statistics = client.getReconnectStatistics();
+    ASSERT_EQ(3, statistics.connectAttempts);
+    ASSERT_EQ(0, statistics.consecutiveFailures);
+}
+
+TEST(IEC61850ClientTest, keepAliveInStandby)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    connParam.ipAddress = "127.0.0.1";
+    connParam.mmsPort = 8102;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+
+    DatapointConfig dpConfig;
+    dpConfig.label = "TS1";
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO1";
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    exchangedData.push_back(dpConfig);
+
+    IEC61850RedundancyGroup redundancyGroup;
+    redundancyGroup.addMember("127.0.0.1_102", nullptr);
+    redundancyGroup.updateHealth("127.0.0.1_102", true);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams,
+                          nullptr,
+                          nullptr,
+                          &redundancyGroup);
+    redundancyGroup.addMember(client.m_clientId, nullptr);
+
+    auto *mockConnection = new NiceMock<MockIEC61850ClientConnection>();
+    ON_CALL(*mockConnection, isConnected()).WillByDefault(Return(true));
+    ON_CALL(*mockConnection, buildNameTree(_, _, _)).WillByDefault(Return(true));
+    EXPECT_CALL(*mockConnection, keepAlive())
+    .Times(1)
+    .WillOnce(Return(true));
+    EXPECT_CALL(*mockConnection, readDO(_, _, _))
+    .Times(0);
+    client.m_connection.reset(mockConnection);
+
+    // Test Body: discovered, but not read
+    client.readAndExportMms();
+
+    ASSERT_THAT(client.m_nameTrees[0], NotNull());
+    ASSERT_EQ("127.0.0.1_102", redundancyGroup.getActiveMember());
+}
+
+TEST(IEC61850ClientTest, failoverToStandby)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    connParam.ipAddress = "127.0.0.1";
+    connParam.mmsPort = 8102;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+
+    DatapointConfig dpConfig;
+    dpConfig.label = "TS1";
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO1";
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    exchangedData.push_back(dpConfig);
+
+    IEC61850RedundancyGroup redundancyGroup;
+    redundancyGroup.addMember("127.0.0.1_102", nullptr);
+    redundancyGroup.updateHealth("127.0.0.1_102", true);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams,
+                          nullptr,
+                          nullptr,
+                          &redundancyGroup);
+
+    auto *mockConnection = new NiceMock<MockIEC61850ClientConnection>();
+    ON_CALL(*mockConnection, isConnected()).WillByDefault(Return(true));
+    ON_CALL(*mockConnection, keepAlive()).WillByDefault(Return(true));
+    auto emptyMms = std::make_shared<WrappedMms>();
+    EXPECT_CALL(*mockConnection, readDO(_, _, _))
+    .Times(1)
+    .WillOnce(Return(emptyMms));
+    client.m_connection.reset(mockConnection);
+
+    /** Registered by 'start': the promotion wakes the reading loop */
+    redundancyGroup.addMember(client.m_clientId, [&client] { client.wake(); });
+    client.readAndExportMms();
+
+    // Test Body: the active connection fails, the standby one takes over
+    redundancyGroup.updateHealth("127.0.0.1_102", false);
+    ASSERT_EQ(client.m_clientId, redundancyGroup.getActiveMember());
+    ASSERT_EQ(true, client.m_isWakeRequested);
+    ASSERT_EQ(false, client.waitForStopOrder(std::chrono::milliseconds(60000)));
+
+    client.readAndExportMms();
+}
+
+TEST(IEC61850ClientTest, keepReadingAfterFailedRead)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+
+    DatapointConfig dpConfig;
+    dpConfig.label = "TS1";
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO1";
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    exchangedData.push_back(dpConfig);
+    dpConfig.label = "TS2";
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO2";
+    exchangedData.push_back(dpConfig);
+
+    IEC61850RedundancyGroup redundancyGroup;
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams,
+                          nullptr,
+                          nullptr,
+                          &redundancyGroup);
+    redundancyGroup.addMember(client.m_clientId, nullptr);
+
+    auto emptyMms = std::make_shared<WrappedMms>();
+    auto boolean_mms = std::make_shared<WrappedMms>();
+    boolean_mms->setMmsValue(MmsValue_newBoolean(true));
+
+    /** The reads of TS1 time out, the ones of TS2 succeed */
+    auto *mockConnection = new NiceMock<MockIEC61850ClientConnection>();
+    ON_CALL(*mockConnection, isConnected()).WillByDefault(Return(true));
+    ON_CALL(*mockConnection, buildNameTree(_, _, _)).WillByDefault(Return(true));
+    EXPECT_CALL(*mockConnection, readDO("LD1/GGIO1.SPSSO1", _, _))
+    .Times(2)
+    .WillRepeatedly(DoAll(SetArgReferee<2>(IED_ERROR_TIMEOUT), Return(emptyMms)));
+    EXPECT_CALL(*mockConnection, readDO("LD1/GGIO1.SPSSO2", _, _))
+    .Times(2)
+    .WillRepeatedly(Return(boolean_mms));
+    client.m_connection.reset(mockConnection);
+
+    // Test Body: a failed read only skips its DO, in this cycle
+    client.readAndExportMms();
+    client.readAndExportMms();
+
+    ASSERT_EQ(client.m_clientId, redundancyGroup.getActiveMember());
+}
+
+TEST(IEC61850ClientTest, shardReadsOverAssociations)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    connParam.associationCount = 2;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+
+    DatapointConfig dpConfig;
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+
+    for (const char *label : {"TS1", "TS2", "TS3", "TS4"}) {
+        dpConfig.label = label;
+        dpConfig.dataPath = std::string("LD1/GGIO1.") + label;
+        exchangedData.push_back(dpConfig);
+    }
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    /** Record the threads which read */
+    std::mutex threadIdsMutex;
+    std::set<std::thread::id> threadIds;
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    EXPECT_CALL(*mockConnection, readDO(_, _, _))
+    .Times(4)
+    .WillRepeatedly(Invoke([&threadIdsMutex, &threadIds](const std::string &, const FunctionalConstraint &,
+                                                         IedClientError &) {
+        std::lock_guard<std::mutex> guard(threadIdsMutex);
+        threadIds.insert(std::this_thread::get_id());
+        return nullptr;
+    }));
+    client.m_connection.reset(mockConnection);
+
+    // Test Body: 2 shards of 2 reads, in parallel
+    client.readAndExportAllDO();
+
+    ASSERT_EQ(2, threadIds.size());
+}
+
+TEST(IEC61850ClientTest, readHighPriorityDOInOwnLane)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+    applicationParams.useDynamicDatasets = true;
+    applicationParams.highPriorityReadPeriodInMs = 50;
+
+    DatapointConfig dpConfig;
+    dpConfig.label = "TM1";
+    dpConfig.dataPath = "LD1/GGIO1.AnIn1";
+    dpConfig.functionalConstraint = IEC61850_FC_MX;
+    exchangedData.push_back(dpConfig);
+    dpConfig.label = "TS1";
+    dpConfig.dataPath = "LD1/GGIO1.SPSSO1";
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    dpConfig.priority = ReadPriority::HIGH;
+    exchangedData.push_back(dpConfig);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    /** The high priority DO is not grouped with the others */
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    EXPECT_CALL(*mockConnection, createDataset("@FledgeDO0", ElementsAre("LD1/GGIO1.AnIn1[MX]")))
+    .WillOnce(Return(true));
+    client.m_connection.reset(mockConnection);
+    client.createDynamicDatasets();
+    ASSERT_THAT(client.m_isReadByDynamicDataset, ElementsAre(true, false));
+
+    /** A slow bulk read: the high priority DO is read again meanwhile */
+    EXPECT_CALL(*mockConnection, readDataset("@FledgeDO0", _))
+    .WillOnce(Invoke([](const std::string &, IedClientError &) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        return nullptr;
+    }));
+    EXPECT_CALL(*mockConnection, readMultipleDO(ElementsAre("LD1/GGIO1.SPSSO1[ST]"), ReadPriority::HIGH, _))
+    .Times(AtLeast(3))
+    .WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(*mockConnection, readDO(_, _, _))
+    .Times(0);
+
+    // Test Body
+    client.readAndExportAllDO();
+}
+
+TEST(IEC61850ClientTest, adaptPollingToValueChanges)
+{
+    // Test Init: cycles of 100 ms, DO periods from 1 s to 1 min
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+    applicationParams.readPollingPeriodInMs = 100;
+    applicationParams.isAdaptivePollingEnabled = true;
+    applicationParams.adaptivePollingBounds.minPeriodInMs = 1000;
+    applicationParams.adaptivePollingBounds.maxPeriodInMs = 60000;
+
+    DatapointConfig dpConfig;
+    dpConfig.label = "TM1";
+    dpConfig.dataPath = "LD1/GGIO1.AnIn1";
+    dpConfig.functionalConstraint = IEC61850_FC_MX;
+    exchangedData.push_back(dpConfig);
+    dpConfig.label = "TM2";
+    dpConfig.dataPath = "LD1/GGIO1.AnIn2";
+    dpConfig.pollingPeriodBounds.maxPeriodInMs = 2000;
+    exchangedData.push_back(dpConfig);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    for (std::size_t index = 0; index < exchangedData.size(); ++index) {
+        client.m_nameTrees[index] = std::make_shared<MmsNameNode>();
+        client.m_nameTrees[index]->mmsName = exchangedData[index].label;
+    }
+
+    auto *mockConnection = new MockIEC61850ClientConnection();
+    client.m_connection.reset(mockConnection);
+
+    auto readValue = [](int value) {
+        auto wrappedMms = std::make_shared<WrappedMms>();
+        wrappedMms->setMmsValue(MmsValue_newIntegerFromInt32(value));
+        return wrappedMms;
+    };
+
+    /** The DO are read once: the next cycle is before their period */
+    EXPECT_CALL(*mockConnection, readDO("LD1/GGIO1.AnIn1", IEC61850_FC_MX, _))
+    .WillOnce(Return(readValue(1)));
+    EXPECT_CALL(*mockConnection, readDO("LD1/GGIO1.AnIn2", IEC61850_FC_MX, _))
+    .WillOnce(Return(readValue(2)));
+
+    // Test Body
+    client.readAndExportAllDO();
+    client.readAndExportAllDO();
+
+    PollingRateDistribution distribution = client.getPollingRateDistribution();
+    ASSERT_EQ(2, distribution.unitCount);
+    ASSERT_EQ(std::chrono::milliseconds(1000), distribution.shortestPeriod);
+    ASSERT_EQ(2, distribution.unitsAtMinPeriod);
+    ASSERT_DOUBLE_EQ(2.0, distribution.readsPerSecond);
+
+    /** The unchanged value is read less often, within its own max period */
+    for (int read = 0; read < 5; ++read) {
+        client.recordPolledValue(IEC61850Client::buildDoPathWithFC(exchangedData[1]), 42);
+    }
+
+    /** (the DO is known by its path with FC, as read by the cycle) */
+    distribution = client.getPollingRateDistribution();
+    ASSERT_EQ(2, distribution.unitCount);
+    ASSERT_EQ(std::chrono::milliseconds(2000), distribution.longestPeriod);
+    ASSERT_EQ(1, distribution.unitsAtMaxPeriod);
+}
+
+TEST(IEC61850ClientTest, slowDownCongestedIED)
+{
+    // Test Init: 2 associations, congested above 100 ms
+    ServerConnectionParameters connParam;
+    connParam.associationCount = 2;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+    applicationParams.readPollingPeriodInMs = 500;
+    applicationParams.congestionControl.isEnabled = true;
+    applicationParams.congestionControl.responseTimeThresholdInMs = 100;
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    ResponseTimeSummary slowResponses;
+    slowResponses.record(std::chrono::milliseconds(300));
+    ResponseTimeSummary fastResponses;
+    fastResponses.record(std::chrono::milliseconds(20));
+
+    // Test Body: the slow cycle doubles the period and halves the requests in flight
+    ASSERT_EQ(std::chrono::milliseconds(500), client.getEffectivePollingPeriod());
+    client.updateCongestionControl(slowResponses);
+
+    ASSERT_TRUE(client.getCongestionState().isCongested);
+    ASSERT_EQ(std::chrono::milliseconds(1000), client.getEffectivePollingPeriod());
+    ASSERT_EQ(1, client.m_congestionControl.getWindow());
+
+    /** The fast cycles give back the nominal rate */
+    for (int cycle = 0; cycle < 10; ++cycle) {
+        client.updateCongestionControl(fastResponses);
+    }
+
+    ASSERT_FALSE(client.getCongestionState().isCongested);
+    ASSERT_EQ(std::chrono::milliseconds(500), client.getEffectivePollingPeriod());
+    ASSERT_EQ(2, client.m_congestionControl.getWindow());
+}
+
+TEST(IEC61850ClientTest, publishRuntimeStatistics)
+{
+    // Test Init: statistics published every 10 ms
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+    applicationParams.runtimeStatistics.isEnabled = true;
+    applicationParams.runtimeStatistics.periodInMs = 10;
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    client.m_runtimeStatistics.recordCycle(std::chrono::milliseconds(20));
+    client.m_runtimeStatistics.recordReading(std::chrono::microseconds(5));
+
+    // Test Body: the interval is published once its period is over
+    client.publishRuntimeStatistics();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    client.publishRuntimeStatistics();
+
+    RuntimeStatisticsSnapshot snapshot = client.m_runtimeStatistics.takeSnapshot(std::chrono::steady_clock::now());
+    ASSERT_EQ(0, snapshot.cycleCount);
+    ASSERT_EQ(0, snapshot.readingCount);
+
+    /** 1 datapoint per statistic, after the key of the IED */
+    snapshot.cycleCount = 1;
+    snapshot.cycleDurations.record(std::chrono::milliseconds(20));
+    std::vector<Datapoint *> points = IEC61850Client::buildStatisticsDatapoints("0.0.0.0_102", snapshot);
+    ASSERT_EQ(21, points.size());
+    ASSERT_EQ("ied", points[0]->getName());
+    ASSERT_EQ("0.0.0.0_102", points[0]->getData().toStringValue());
+    ASSERT_EQ("cycles", points[2]->getName());
+    ASSERT_EQ(1, points[2]->getData().toInt());
+    ASSERT_EQ("cycle_duration_max_us", points[6]->getName());
+    ASSERT_EQ(20000, points[6]->getData().toInt());
+
+    for (Datapoint *point : points) {
+        delete point;
+    }
+}
+
+TEST(IEC61850ClientTest, alignCyclesOnPollingPhase)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+    applicationParams.readPollingPeriodInMs = 1000;
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams);
+
+    // Test Body: the phase is a fraction of the period
+    ASSERT_EQ(std::chrono::milliseconds(0), client.getPollingPhase());
+    client.setPollingPhase(0.25);
+    ASSERT_EQ(std::chrono::milliseconds(250), client.getPollingPhase());
+
+    /** The phase follows the period of the configuration in use, once swapped */
+    auto newConfig = std::make_shared<IEC61850ClientConfig>();
+    newConfig->serverConfigDict[IEC61850ClientConfig::buildKey(connParam)] = connParam;
+    newConfig->applicationParams.readPollingPeriodInMs = 2000;
+    ASSERT_EQ(std::chrono::milliseconds(500),
+              IEC61850Client::computePollingPhase(IEC61850Client::getPollingPeriod(newConfig->applicationParams), 0.25));
+
+    client.updateConfiguration(newConfig);
+    ASSERT_EQ(std::chrono::milliseconds(250), client.getPollingPhase());
+    client.applyPendingConfiguration();
+    ASSERT_EQ(std::chrono::milliseconds(500), client.getPollingPhase());
+
+    /** The next cycle starts at the phase, modulo the period, whatever the time of the request */
+    std::chrono::steady_clock::time_point periodStart(std::chrono::milliseconds(10000));
+    std::chrono::milliseconds period(1000);
+    std::chrono::milliseconds phase(250);
+
+    ASSERT_EQ(std::chrono::milliseconds(250),
+              IEC61850Client::computeDelayToNextCycle(periodStart, period, phase));
+    ASSERT_EQ(std::chrono::milliseconds(50),
+              IEC61850Client::computeDelayToNextCycle(periodStart + std::chrono::milliseconds(200), period, phase));
+    ASSERT_EQ(std::chrono::milliseconds(1000),
+              IEC61850Client::computeDelayToNextCycle(periodStart + std::chrono::milliseconds(250), period, phase));
+    ASSERT_EQ(std::chrono::milliseconds(950),
+              IEC61850Client::computeDelayToNextCycle(periodStart + std::chrono::milliseconds(300), period, phase));
+}
+
+TEST(IEC61850ClientTest, drawReadsFromRequestBudget)
+{
+    // Test Init: 1 request every 10 s, shared with the other IEDs of the link
+    ServerConnectionParameters connParam;
+    ExchangedData exchangedData;
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+    RequestBudgetParameters budgetParams;
+    budgetParams.requestsPerSecond = 0.1;
+    IEC61850RequestBudget requestBudget(budgetParams);
+
+    IEC61850Client client(nullptr,
+                          connParam,
+                          exchangedData,
+                          exchangedDatasets,
+                          applicationParams,
+                          nullptr,
+                          nullptr,
+                          nullptr,
+                          &requestBudget);
+
+    // Test Body: the first read is granted, the next one waits for the budget,
+    ASSERT_TRUE(client.drawFromRequestBudget(ReadPriority::NORMAL, 1, 20));
+
+    auto waitingRead = std::async(std::launch::async, [&client] {
+        return client.drawFromRequestBudget(ReadPriority::NORMAL, 1, 20);
+    });
+    ASSERT_EQ(std::future_status::timeout, waitingRead.wait_for(std::chrono::milliseconds(50)));
+
+    // and is skipped when the client is stopped.
+    client.requestStop();
+    ASSERT_EQ(std::future_status::ready, waitingRead.wait_for(std::chrono::milliseconds(500)));
+    ASSERT_FALSE(waitingRead.get());
+
+    IEC61850RequestBudget::Statistics statistics = requestBudget.getStatistics();
+    ASSERT_EQ(1, statistics.grantedRequests);
+    ASSERT_EQ(IEC61850RequestBudget::estimateExchangeSize(1, 20), statistics.grantedBytes);
+}
+
+/** \brief 'count' SPS of "LD1/GGIO1", read by DO */
+static ExchangedData buildSpsExchangedData(int count)
+{
+    ExchangedData exchangedData;
+    DatapointConfig dpConfig;
+    dpConfig.functionalConstraint = IEC61850_FC_ST;
+    dpConfig.datapointType = "SPS";
+
+    for (int index = 1; index <= count; ++index) {
+        dpConfig.label = "TS" + std::to_string(index);
+        dpConfig.dataPath = "LD1/GGIO1.Ind" + std::to_string(index);
+        exchangedData.push_back(dpConfig);
+    }
+
+    return exchangedData;
+}
+
+TEST(IEC61850ClientTest, overlapShardsInVirtualTime)
+{
+    // Test Init: 4 DO, 10 ms per request
+    ExchangedData exchangedData = buildSpsExchangedData(4);
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+
+    FakeIedProfile profile;
+    profile.rtt = std::chrono::milliseconds(10);
+    VirtualClock clock;
+
+    // Test Body: 1 association reads the DO one after the other,
+    ServerConnectionParameters connParam;
+    connParam.associationCount = 1;
+    IEC61850Client sequentialClient(nullptr, connParam, exchangedData, exchangedDatasets, applicationParams);
+    auto *sequentialConnection = new FakeIEC61850ClientConnection(profile, clock);
+    sequentialClient.m_connection.reset(sequentialConnection);
+
+    sequentialConnection->beginCycle();
+    sequentialClient.readAndExportAllDO();
+
+    ASSERT_EQ(std::chrono::milliseconds(40), clock.now());
+    ASSERT_EQ(1, sequentialConnection->getPeakOutstandingCalls());
+
+    // 2 associations read 2 shards in parallel
+    connParam.associationCount = 2;
+    IEC61850Client shardedClient(nullptr, connParam, exchangedData, exchangedDatasets, applicationParams);
+    auto *shardedConnection = new FakeIEC61850ClientConnection(profile, clock);
+    shardedClient.m_connection.reset(shardedConnection);
+
+    shardedConnection->beginCycle();
+    shardedClient.readAndExportAllDO();
+
+    ASSERT_EQ(std::chrono::milliseconds(40 + 20), clock.now());
+    ASSERT_EQ(2, shardedConnection->getPeakOutstandingCalls());
+    ASSERT_EQ(4, shardedConnection->getOutcomeCount(FakeCallOutcome::ANSWERED));
+}
+
+TEST(IEC61850ClientTest, narrowWindowOnInjectedTimeouts)
+{
+    // Test Init: 4 associations, an IED which does not answer
+    ServerConnectionParameters connParam;
+    connParam.associationCount = 4;
+    ExchangedData exchangedData = buildSpsExchangedData(4);
+    ExchangedDatasets exchangedDatasets;
+    ApplicationParameters applicationParams;
+    applicationParams.congestionControl.isEnabled = true;
+
+    IEC61850Client client(nullptr, connParam, exchangedData, exchangedDatasets, applicationParams);
+
+    FakeIedProfile profile;
+    profile.timeoutRatio = 1.0;
+    profile.requestTimeout = std::chrono::seconds(1);
+    VirtualClock clock;
+    auto *fakeConnection = new FakeIEC61850ClientConnection(profile, clock);
+    client.m_connection.reset(fakeConnection);
+
+    // Test Body: the 4 requests time out at once,
+    fakeConnection->beginCycle();
+    client.readAndExportAllDO();
+    ASSERT_EQ(std::chrono::seconds(1), clock.now());
+
+    client.updateCongestionControl(fakeConnection->takeResponseTimes());
+    ASSERT_TRUE(client.getCongestionState().isCongested);
+    ASSERT_EQ(2, client.m_congestionControl.getWindow());
+
+    // then 2 at a time.
+    fakeConnection->beginCycle();
+    client.readAndExportAllDO();
+    ASSERT_EQ(std::chrono::seconds(1 + 2), clock.now());
+    ASSERT_EQ(8, fakeConnection->getOutcomeCount(FakeCallOutcome::TIMEOUT));
+}
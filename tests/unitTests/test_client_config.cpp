@@ -665,3 +665,431 @@ TEST(IEC61850ClientConfigTest, importValidExchangedDataWithIgnoredProtocols)
     ASSERT_EQ(clientConfig.exchangedData[0].dataPath, "path for iec61850 model");
 }
 
+
+TEST(IEC61850ClientConfigTest, importDynamicDatasetsOption)
+{
+    IEC61850ClientConfig clientConfig;
+
+    ASSERT_EQ(clientConfig.applicationParams.useDynamicDatasets, false);
+    ASSERT_NO_THROW(clientConfig.importJsonProtocolConfig(protocolStackWithDynamicDatasets));
+
+    ASSERT_EQ(clientConfig.applicationParams.readPollingPeriodInMs, 500);
+    ASSERT_EQ(clientConfig.applicationParams.readMode, ReadMode::DO_READING);
+    ASSERT_EQ(clientConfig.applicationParams.useDynamicDatasets, true);
+}
+
+TEST(IEC61850ClientConfigTest, importDynamicDatasetsOptionBadFormat)
+{
+    IEC61850ClientConfig clientConfig;
+
+    try {
+        clientConfig.importJsonProtocolConfig(protocolStackDynamicDatasetsBadFormat);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: bad format for 'dynamic_datasets'");
+    } catch (...) {
+        FAIL();
+    }
+}
+
+TEST(IEC61850ClientConfigTest, importPartialReadThreshold)
+{
+    IEC61850ClientConfig clientConfig;
+
+    ASSERT_EQ(clientConfig.applicationParams.partialReadThreshold, 0.0f);
+    ASSERT_NO_THROW(clientConfig.importJsonProtocolConfig(protocolStackWithPartialReadThreshold));
+
+    ASSERT_EQ(clientConfig.applicationParams.readMode, ReadMode::DATASET_READING);
+    ASSERT_EQ(clientConfig.applicationParams.partialReadThreshold, 0.25f);
+}
+
+TEST(IEC61850ClientConfigTest, importPartialReadThresholdOutOfRange)
+{
+    IEC61850ClientConfig clientConfig;
+
+    try {
+        clientConfig.importJsonProtocolConfig(protocolStackPartialReadThresholdOutOfRange);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: 'partial_read_threshold' must be between 0 and 1");
+    } catch (...) {
+        FAIL();
+    }
+}
+
+TEST(IEC61850ClientConfigTest, importMaxConcurrentDiscoveries)
+{
+    IEC61850ClientConfig clientConfig;
+
+    ASSERT_EQ(clientConfig.applicationParams.maxConcurrentDiscoveries, 0);
+    ASSERT_NO_THROW(clientConfig.importJsonProtocolConfig(protocolStackWithMaxConcurrentDiscoveries));
+
+    ASSERT_EQ(clientConfig.applicationParams.maxConcurrentDiscoveries, 8);
+}
+
+TEST(IEC61850ClientConfigTest, importMaxConcurrentDiscoveriesBadFormat)
+{
+    IEC61850ClientConfig clientConfig;
+
+    try {
+        clientConfig.importJsonProtocolConfig(protocolStackMaxConcurrentDiscoveriesBadFormat);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: bad format for 'max_concurrent_discoveries'");
+    } catch (...) {
+        FAIL();
+    }
+}
+
+TEST(IEC61850ClientConfigTest, importConnectionTimeouts)
+{
+    IEC61850ClientConfig clientConfig;
+
+    ASSERT_NO_THROW(clientConfig.importJsonProtocolConfig(protocolStackWithConnectionTimeouts));
+
+    ASSERT_EQ(1, clientConfig.serverConfigDict.size());
+    const ServerConnectionParameters &connParam = clientConfig.serverConfigDict.begin()->second;
+    ASSERT_EQ(2000, connParam.connectTimeoutInMs);
+    ASSERT_EQ(3000, connParam.requestTimeoutInMs);
+    ASSERT_EQ(500, connParam.reconnectMinDelayInMs);
+    ASSERT_EQ(60000, connParam.reconnectMaxDelayInMs);
+}
+
+TEST(IEC61850ClientConfigTest, importConnectionTimeoutBadFormat)
+{
+    IEC61850ClientConfig clientConfig;
+
+    try {
+        clientConfig.importJsonProtocolConfig(protocolStackConnectionTimeoutBadFormat);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: bad format for 'connect_timeout'");
+    } catch (...) {
+        FAIL();
+    }
+}
+
+TEST(IEC61850ClientConfigTest, importReconnectDelaysInWrongOrder)
+{
+    IEC61850ClientConfig clientConfig;
+
+    try {
+        clientConfig.importJsonProtocolConfig(protocolStackReconnectDelaysInWrongOrder);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(),
+                     "Configuration exception: 'reconnect_min_delay' is greater than 'reconnect_max_delay'");
+    } catch (...) {
+        FAIL();
+    }
+}
+
+TEST(IEC61850ClientConfigTest, importRedundantConnections)
+{
+    IEC61850ClientConfig clientConfig;
+
+    ASSERT_FALSE(clientConfig.isRedundancyEnabled);
+    ASSERT_NO_THROW(clientConfig.importJsonProtocolConfig(protocolStackWithRedundantConnections));
+
+    ASSERT_TRUE(clientConfig.isRedundancyEnabled);
+    ASSERT_EQ(2, clientConfig.serverConfigDict.size());
+}
+
+TEST(IEC61850ClientConfigTest, importRedundantConnectionsBadFormat)
+{
+    IEC61850ClientConfig clientConfig;
+
+    try {
+        clientConfig.importJsonProtocolConfig(protocolStackRedundantConnectionsBadFormat);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: bad format for 'redundant_connections'");
+    } catch (...) {
+        FAIL();
+    }
+}
+
+TEST(IEC61850ClientConfigTest, importAssociationCount)
+{
+    IEC61850ClientConfig clientConfig;
+
+    ASSERT_NO_THROW(clientConfig.importJsonProtocolConfig(protocolStackWithAssociationCount));
+
+    ASSERT_EQ(1, clientConfig.serverConfigDict.size());
+    ASSERT_EQ(4, clientConfig.serverConfigDict.begin()->second.associationCount);
+}
+
+TEST(IEC61850ClientConfigTest, importAssociationCountOutOfRange)
+{
+    IEC61850ClientConfig clientConfig;
+
+    try {
+        clientConfig.importJsonProtocolConfig(protocolStackAssociationCountOutOfRange);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: 'associations' must be at least 1");
+    } catch (...) {
+        FAIL();
+    }
+}
+
+TEST(IEC61850ClientConfigTest, importMmsTuning)
+{
+    IEC61850ClientConfig clientConfig;
+
+    ASSERT_NO_THROW(clientConfig.importJsonProtocolConfig(protocolStackWithMmsTuning));
+
+    ASSERT_EQ(1, clientConfig.serverConfigDict.size());
+    ASSERT_EQ(16384, clientConfig.serverConfigDict.begin()->second.maxPduSize);
+    ASSERT_EQ(8, clientConfig.serverConfigDict.begin()->second.maxOutstandingCalls);
+}
+
+TEST(IEC61850ClientConfigTest, importMmsTuningOutOfRange)
+{
+    IEC61850ClientConfig clientConfig;
+
+    try {
+        clientConfig.importJsonProtocolConfig(protocolStackMaxPduSizeOutOfRange);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: 'max_pdu_size' must be between 1024 and 65000");
+    } catch (...) {
+        FAIL();
+    }
+
+    try {
+        clientConfig.importJsonProtocolConfig(protocolStackMaxOutstandingCallsBadFormat);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: bad format for 'max_outstanding_calls'");
+    } catch (...) {
+        FAIL();
+    }
+}
+
+TEST(IEC61850ClientConfigTest, importDatapointPriorities)
+{
+    IEC61850ClientConfig clientConfig;
+
+    ASSERT_NO_THROW(clientConfig.importJsonExchangedDataConfig(exchangedDataWithPriorities));
+
+    ASSERT_EQ(clientConfig.exchangedData.size(), 3);
+    ASSERT_EQ(clientConfig.exchangedData[0].priority, ReadPriority::HIGH);
+    ASSERT_EQ(clientConfig.exchangedData[1].priority, ReadPriority::NORMAL);
+    ASSERT_EQ(clientConfig.exchangedData[2].priority, ReadPriority::NORMAL);
+
+    ASSERT_EQ(clientConfig.applicationParams.highPriorityReadPeriodInMs, 0);
+    ASSERT_NO_THROW(clientConfig.importJsonProtocolConfig(protocolStackWithHighPriorityReadingPeriod));
+    ASSERT_EQ(clientConfig.applicationParams.highPriorityReadPeriodInMs, 100);
+}
+
+TEST(IEC61850ClientConfigTest, importDatapointWithUnknownPriority)
+{
+    IEC61850ClientConfig clientConfig;
+
+    try {
+        clientConfig.importJsonExchangedDataConfig(datapointWithUnknownPriority);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: unknown 'priority': urgent");
+    } catch (...) {
+        FAIL();
+    }
+}
+
+TEST(IEC61850ClientConfigTest, importRequestBudgets)
+{
+    IEC61850ClientConfig clientConfig;
+
+    ASSERT_NO_THROW(clientConfig.importJsonProtocolConfig(protocolStackWithRequestBudgets));
+
+    const ApplicationParameters &applicationParams = clientConfig.applicationParams;
+    ASSERT_DOUBLE_EQ(applicationParams.requestBudget.requestsPerSecond, 50.0);
+    ASSERT_DOUBLE_EQ(applicationParams.requestBudget.bytesPerSecond, 0.0);
+    ASSERT_TRUE(applicationParams.requestBudget.isEnabled());
+
+    ASSERT_EQ(applicationParams.linkBudgets.size(), 1);
+    const RequestBudgetParameters &linkBudget = applicationParams.linkBudgets.at("substationA");
+    ASSERT_DOUBLE_EQ(linkBudget.requestsPerSecond, 20.0);
+    ASSERT_DOUBLE_EQ(linkBudget.bytesPerSecond, 8000.0);
+    ASSERT_DOUBLE_EQ(linkBudget.highPriorityShare, 0.25);
+
+    ASSERT_EQ(clientConfig.serverConfigDict.size(), 2);
+    ASSERT_EQ(clientConfig.serverConfigDict.at("0.0.0.0_102").linkGroup, "substationA");
+    ASSERT_EQ(clientConfig.serverConfigDict.at("0.0.0.0_103").linkGroup, "");
+}
+
+TEST(IEC61850ClientConfigTest, importRequestBudgetOutOfRange)
+{
+    IEC61850ClientConfig clientConfig;
+
+    try {
+        clientConfig.importJsonProtocolConfig(protocolStackRequestBudgetNegative);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: 'bytes_per_second' of the budget 'request_budget' is negative");
+    } catch (...) {
+        FAIL();
+    }
+
+    try {
+        clientConfig.importJsonProtocolConfig(protocolStackHighPriorityShareOutOfRange);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: 'high_priority_share' of the budget 'substationA' must be lower than 1");
+    } catch (...) {
+        FAIL();
+    }
+}
+
+TEST(IEC61850ClientConfigTest, importAdaptivePolling)
+{
+    IEC61850ClientConfig clientConfig;
+
+    ASSERT_FALSE(clientConfig.applicationParams.isAdaptivePollingEnabled);
+    ASSERT_NO_THROW(clientConfig.importJsonProtocolConfig(protocolStackWithAdaptivePolling));
+    ASSERT_TRUE(clientConfig.applicationParams.isAdaptivePollingEnabled);
+    ASSERT_EQ(clientConfig.applicationParams.adaptivePollingBounds.minPeriodInMs, 200);
+    ASSERT_EQ(clientConfig.applicationParams.adaptivePollingBounds.maxPeriodInMs, 60000);
+
+    // The bounds of a DO are optional
+    ASSERT_NO_THROW(clientConfig.importJsonExchangedDataConfig(exchangedDataWithPollingPeriods));
+    ASSERT_EQ(clientConfig.exchangedData.size(), 2);
+    ASSERT_EQ(clientConfig.exchangedData[0].pollingPeriodBounds.minPeriodInMs, 100);
+    ASSERT_EQ(clientConfig.exchangedData[0].pollingPeriodBounds.maxPeriodInMs, 5000);
+    ASSERT_EQ(clientConfig.exchangedData[1].pollingPeriodBounds.minPeriodInMs, 0);
+    ASSERT_EQ(clientConfig.exchangedData[1].pollingPeriodBounds.maxPeriodInMs, 0);
+
+    // The bounds of a dataset are given to its selected DO
+    ASSERT_NO_THROW(clientConfig.importJsonExchangedDatasetsConfig(exchangedDatasetsWithPollingPeriods));
+    const ExchangedData &dataset = clientConfig.selectedDOInExchangedDatasets.at("simpleIOGenericIO/LLN0.RTEEvents");
+    ASSERT_EQ(dataset.size(), 1);
+    ASSERT_EQ(dataset[0].pollingPeriodBounds.minPeriodInMs, 1000);
+    ASSERT_EQ(dataset[0].pollingPeriodBounds.maxPeriodInMs, 30000);
+}
+
+TEST(IEC61850ClientConfigTest, importAdaptivePollingBadBounds)
+{
+    IEC61850ClientConfig clientConfig;
+
+    try {
+        clientConfig.importJsonProtocolConfig(protocolStackAdaptivePollingWithoutMaxPeriod);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: 'adaptive_polling' needs 'min_period' and 'max_period'");
+    } catch (...) {
+        FAIL();
+    }
+
+    try {
+        clientConfig.importJsonExchangedDataConfig(datapointWithInvertedPollingPeriods);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: 'min_period' is greater than 'max_period'");
+    } catch (...) {
+        FAIL();
+    }
+}
+
+TEST(IEC61850ClientConfigTest, importCongestionControl)
+{
+    IEC61850ClientConfig clientConfig;
+
+    ASSERT_FALSE(clientConfig.applicationParams.congestionControl.isEnabled);
+    ASSERT_NO_THROW(clientConfig.importJsonProtocolConfig(protocolStackWithCongestionControl));
+    ASSERT_TRUE(clientConfig.applicationParams.congestionControl.isEnabled);
+    ASSERT_EQ(clientConfig.applicationParams.congestionControl.responseTimeThresholdInMs, 500);
+    ASSERT_EQ(clientConfig.applicationParams.congestionControl.maxSlowdown, 8);
+}
+
+TEST(IEC61850ClientConfigTest, importCongestionControlBadSlowdown)
+{
+    IEC61850ClientConfig clientConfig;
+
+    try {
+        clientConfig.importJsonProtocolConfig(protocolStackCongestionControlWithoutSlowdown);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: bad format for 'max_slowdown'");
+    } catch (...) {
+        FAIL();
+    }
+}
+
+TEST(IEC61850ClientConfigTest, importRuntimeStatistics)
+{
+    IEC61850ClientConfig clientConfig;
+
+    ASSERT_FALSE(clientConfig.applicationParams.runtimeStatistics.isEnabled);
+    ASSERT_NO_THROW(clientConfig.importJsonProtocolConfig(protocolStackWithRuntimeStatistics));
+    ASSERT_TRUE(clientConfig.applicationParams.runtimeStatistics.isEnabled);
+    ASSERT_EQ(clientConfig.applicationParams.runtimeStatistics.assetName, "ied_statistics");
+    ASSERT_EQ(clientConfig.applicationParams.runtimeStatistics.periodInMs, 10000);
+}
+
+TEST(IEC61850ClientConfigTest, importRuntimeStatisticsBadPeriod)
+{
+    IEC61850ClientConfig clientConfig;
+
+    try {
+        clientConfig.importJsonProtocolConfig(protocolStackRuntimeStatisticsWithBadPeriod);
+        FAIL();
+    } catch (ConfigurationException e) {
+        ASSERT_STREQ(e.what(), "Configuration exception: bad format for 'period' of 'statistics'");
+    } catch (...) {
+        FAIL();
+    }
+}
+
+TEST(IEC61850ClientConfigTest, importTracing)
+{
+    IEC61850ClientConfig clientConfig;
+
+    ASSERT_FALSE(clientConfig.applicationParams.tracing.isEnabled);
+    ASSERT_EQ(clientConfig.applicationParams.tracing.filePath, "/tmp/iec61850_trace.json");
+    ASSERT_NO_THROW(clientConfig.importJsonProtocolConfig(protocolStackWithTracing));
+    ASSERT_TRUE(clientConfig.applicationParams.tracing.isEnabled);
+    ASSERT_EQ(clientConfig.applicationParams.tracing.filePath, "/var/tmp/ied_trace.json");
+}
+
+TEST(IEC61850ClientConfigTest, compareConnections)
+{
+    ServerConnectionParameters firstConn;
+    firstConn.ipAddress = "127.0.0.1";
+    firstConn.mmsPort = 102;
+    ServerConnectionParameters secondConn = firstConn;
+
+    ASSERT_TRUE(IEC61850ClientConfig::isSameConnection(firstConn, secondConn));
+
+    // OSI parameters are ignored when they are disabled on both sides
+    secondConn.osiParameters.localApTitle = "1.1.1.999";
+    ASSERT_TRUE(IEC61850ClientConfig::isSameConnection(firstConn, secondConn));
+
+    secondConn.isOsiParametersEnabled = true;
+    ASSERT_FALSE(IEC61850ClientConfig::isSameConnection(firstConn, secondConn));
+
+    secondConn = firstConn;
+    secondConn.mmsPort = 8102;
+    ASSERT_FALSE(IEC61850ClientConfig::isSameConnection(firstConn, secondConn));
+
+    secondConn = firstConn;
+    secondConn.ipAddress = "127.0.0.2";
+    ASSERT_FALSE(IEC61850ClientConfig::isSameConnection(firstConn, secondConn));
+
+    // The timeouts are applied at connection, not the reconnection delays
+    secondConn = firstConn;
+    secondConn.reconnectMaxDelayInMs = 1000;
+    ASSERT_TRUE(IEC61850ClientConfig::isSameConnection(firstConn, secondConn));
+    secondConn.requestTimeoutInMs = 1000;
+    ASSERT_FALSE(IEC61850ClientConfig::isSameConnection(firstConn, secondConn));
+
+    // The PDU size is negotiated at connection
+    secondConn = firstConn;
+    secondConn.maxPduSize = 16384;
+    ASSERT_FALSE(IEC61850ClientConfig::isSameConnection(firstConn, secondConn));
+
+    // The request budget is given to the client at its creation
+    secondConn = firstConn;
+    secondConn.linkGroup = "substationA";
+    ASSERT_FALSE(IEC61850ClientConfig::isSameConnection(firstConn, secondConn));
+}
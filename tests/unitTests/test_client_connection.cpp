@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <thread>  // NOLINT
+
 // South_IEC61850_Plugin headers
 #include "iec61850_client_config.h"
 #include "iec61850_client_connection.h"
@@ -43,8 +47,6 @@ TEST_F(IEC61850ClientConnectionTestWithIEC61850Server, openConnection)
     ASSERT_EQ(8102, conn.m_connectionParam.mmsPort);
     ASSERT_THAT(conn.m_iedConnection, NotNull());
     ASSERT_EQ(true, conn.isConnected());
-    ASSERT_EQ(true, conn.isNoError());
-    conn.logError();
 }
 
 TEST_F(IEC61850ClientConnectionTestWithIEC61850Server, openConnectionWithOsiParams)
@@ -75,8 +77,6 @@ TEST_F(IEC61850ClientConnectionTestWithIEC61850Server, openConnectionWithOsiPara
     ASSERT_EQ(12, conn.m_connectionParam.osiParameters.localAeQualifier);
     ASSERT_THAT(conn.m_iedConnection, NotNull());
     ASSERT_EQ(true, conn.isConnected());
-    ASSERT_EQ(true, conn.isNoError());
-    conn.logError();
 }
 
 TEST_F(IEC61850ClientConnectionTestWithIEC61850Server, readDOValidMms)
@@ -91,11 +91,12 @@ TEST_F(IEC61850ClientConnectionTestWithIEC61850Server, readDOValidMms)
     ASSERT_EQ(8102, conn.m_connectionParam.mmsPort);
     ASSERT_THAT(conn.m_iedConnection, NotNull());
     ASSERT_EQ(true, conn.isConnected());
-    ASSERT_EQ(true, conn.isNoError());
-
 
+    IedClientError error = IED_ERROR_UNKNOWN;
     auto wrappedMms = conn.readDO("simpleIOGenericIO/GGIO1.AnIn1",
-                                  FunctionalConstraint_fromString("MX"));
+                                  FunctionalConstraint_fromString("MX"),
+                                  error);
+    ASSERT_EQ(IED_ERROR_OK, error);
 
     auto mmsValue = wrappedMms->getMmsValue();
     ASSERT_THAT(mmsValue, NotNull());
@@ -115,6 +116,28 @@ TEST_F(IEC61850ClientConnectionTestWithIEC61850Server, readDOValidMms)
     ASSERT_GT(floatValue, -1.0);
 }
 
+TEST_F(IEC61850ClientConnectionTestWithIEC61850Server, notifyConnectionLoss)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    connParam.ipAddress = "127.0.0.1";
+    connParam.mmsPort = 8102;
+    std::atomic<int> lossCount{0};
+    IEC61850ClientConnection conn(connParam, false, [&lossCount] { lossCount++; });
+    ASSERT_EQ(true, conn.isConnected());
+    ASSERT_EQ(0, lossCount);
+
+    // Test Body: the loss is notified, without any request
+    m_mmsServer->stop();
+
+    for (int retry = 0; (retry < 40) && (lossCount == 0); ++retry) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    ASSERT_EQ(1, lossCount);
+    ASSERT_EQ(false, conn.isConnected());
+}
+
 TEST_F(IEC61850ClientConnectionTestWithIEC61850Server, readDOButNotConnected)
 {
     // Test Init
@@ -127,18 +150,18 @@ TEST_F(IEC61850ClientConnectionTestWithIEC61850Server, readDOButNotConnected)
     ASSERT_EQ(8102, conn.m_connectionParam.mmsPort);
     ASSERT_THAT(conn.m_iedConnection, NotNull());
     ASSERT_EQ(true, conn.isConnected());
-    ASSERT_EQ(true, conn.isNoError());
 
     // shutdown the server
     m_mmsServer->stop();
 
+    IedClientError error = IED_ERROR_OK;
     auto wrappedMms = conn.readDO("simpleIOGenericIO/GGIO1.AnIn1",
-                                  FunctionalConstraint_fromString("MX"));
+                                  FunctionalConstraint_fromString("MX"),
+                                  error);
 
     ASSERT_THAT(wrappedMms, IsNull());
+    ASSERT_EQ(IED_ERROR_NOT_CONNECTED, error);
     ASSERT_EQ(false, conn.isConnected());
-    ASSERT_EQ(true, conn.isNoError());
-    conn.logError();
 }
 
 TEST_F(IEC61850ClientConnectionTestWithIEC61850Server, readBadSingleMms)
@@ -153,15 +176,155 @@ TEST_F(IEC61850ClientConnectionTestWithIEC61850Server, readBadSingleMms)
     ASSERT_EQ(8102, conn.m_connectionParam.mmsPort);
     ASSERT_THAT(conn.m_iedConnection, NotNull());
     ASSERT_EQ(true, conn.isConnected());
-    ASSERT_EQ(true, conn.isNoError());
 
+    /** The request succeeds: the access error is in the value */
+    IedClientError error = IED_ERROR_UNKNOWN;
     auto wrappedMms = conn.readDO("simpleIOGenericIO/foo_doesnt_exist",
-                                  FunctionalConstraint_fromString("MX"));
+                                  FunctionalConstraint_fromString("MX"),
+                                  error);
 
     ASSERT_THAT(wrappedMms->getMmsValue(), NotNull());
     ASSERT_EQ(MmsValue_getType(const_cast<MmsValue*>(wrappedMms->getMmsValue())), MMS_DATA_ACCESS_ERROR);
     ASSERT_EQ(true, conn.isConnected());
-    ASSERT_EQ(true, conn.isNoError());
-    conn.logError();
+    ASSERT_EQ(IED_ERROR_OK, error);
 }
 
+
+TEST_F(IEC61850ClientConnectionTestWithIEC61850Server, readMultipleDOValidMms)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    connParam.ipAddress = "127.0.0.1";
+    connParam.mmsPort = 8102;
+    // Test Body
+    IEC61850ClientConnection conn(connParam);
+    ASSERT_EQ(true, conn.isConnected());
+
+    IedClientError error = IED_ERROR_UNKNOWN;
+    auto wrappedMms = conn.readMultipleDO({"simpleIOGenericIO/GGIO1.AnIn1[MX]",
+                                           "simpleIOGenericIO/GGIO1.SPCSO1[ST]",
+                                           "simpleIOGenericIO/GGIO1.AnIn2[MX]"},
+                                          ReadPriority::NORMAL,
+                                          error);
+
+    auto mmsValue = wrappedMms->getMmsValue();
+    ASSERT_THAT(mmsValue, NotNull());
+    ASSERT_EQ(MmsValue_getType(const_cast<MmsValue*>(mmsValue)), MMS_ARRAY);
+    ASSERT_EQ(3, MmsValue_getArraySize(mmsValue));
+
+    /** The elements keep the order of the request */
+    auto anIn1 = MmsValue_getElement(mmsValue, 0);
+    ASSERT_EQ(MmsValue_getType(anIn1), MMS_STRUCTURE);
+    ASSERT_EQ(MmsValue_getType(MmsValue_getElement(MmsValue_getElement(anIn1, 0), 0)), MMS_FLOAT);
+
+    auto spcso1 = MmsValue_getElement(mmsValue, 1);
+    ASSERT_EQ(MmsValue_getType(spcso1), MMS_STRUCTURE);
+
+    auto anIn2 = MmsValue_getElement(mmsValue, 2);
+    ASSERT_EQ(MmsValue_getType(anIn2), MMS_STRUCTURE);
+    ASSERT_EQ(3, MmsValue_getArraySize(anIn2));
+
+    ASSERT_EQ(true, conn.isConnected());
+    ASSERT_EQ(IED_ERROR_OK, error);
+}
+
+TEST_F(IEC61850ClientConnectionTestWithIEC61850Server, negotiateMaxPduSize)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    connParam.ipAddress = "127.0.0.1";
+    connParam.mmsPort = 8102;
+    connParam.maxPduSize = 1024;
+    connParam.maxOutstandingCalls = 2;
+    IEC61850ClientConnection conn(connParam);
+    ASSERT_EQ(true, conn.isConnected());
+
+    // Test Body: the IED may only lower the proposed PDU size
+    ASSERT_GT(conn.getNegotiatedMaxPduSize(), 0);
+    ASSERT_LE(conn.getNegotiatedMaxPduSize(), 1024);
+
+    /** With a tiny PDU, each DO is read in its own request, in the same order */
+    conn.m_negotiatedMaxPduSize = 64;
+    IedClientError error = IED_ERROR_UNKNOWN;
+    auto wrappedMms = conn.readMultipleDO({"simpleIOGenericIO/GGIO1.AnIn1[MX]",
+                                           "simpleIOGenericIO/GGIO1.SPCSO1[ST]",
+                                           "simpleIOGenericIO/GGIO1.AnIn2[MX]"},
+                                          ReadPriority::NORMAL,
+                                          error);
+
+    auto mmsValue = wrappedMms->getMmsValue();
+    ASSERT_THAT(mmsValue, NotNull());
+    ASSERT_EQ(3, MmsValue_getArraySize(mmsValue));
+    ASSERT_EQ(3, MmsValue_getArraySize(MmsValue_getElement(mmsValue, 2)));
+    ASSERT_EQ(IED_ERROR_OK, error);
+}
+
+TEST(IEC61850ClientConnectionTest, splitIntoBatchesByPduSize)
+{
+    std::vector<std::string> names{"LD/GGIO1.AnIn1[MX]",
+                                   "LD/GGIO1.AnIn2[MX]",
+                                   "LD/GGIO1.AnIn3[MX]"};
+
+    /** No limit: 1 batch */
+    ASSERT_THAT(IEC61850ClientConnection::splitIntoBatches(names, 0), ElementsAre(3));
+    ASSERT_THAT(IEC61850ClientConnection::splitIntoBatches(names, 65000), ElementsAre(3));
+
+    /** Header (32) + 2 names (2 * 28) fit in 100 bytes, not 3 names */
+    ASSERT_THAT(IEC61850ClientConnection::splitIntoBatches(names, 100), ElementsAre(2, 1));
+
+    /** A name larger than the PDU is still sent, alone */
+    ASSERT_THAT(IEC61850ClientConnection::splitIntoBatches(names, 10), ElementsAre(1, 1, 1));
+    ASSERT_TRUE(IEC61850ClientConnection::splitIntoBatches({}, 100).empty());
+}
+
+TEST(IEC61850ClientConnectionTest, convertToMmsVariableName)
+{
+    std::string domainId;
+    std::string itemId;
+
+    ASSERT_TRUE(IEC61850ClientConnection::toMmsVariableName("simpleIOGenericIO/GGIO1.AnIn1[MX]",
+                                                             domainId, itemId));
+    ASSERT_EQ("simpleIOGenericIO", domainId);
+    ASSERT_EQ("GGIO1$MX$AnIn1", itemId);
+
+    ASSERT_TRUE(IEC61850ClientConnection::toMmsVariableName("LD/MMXU1.PhV.phsA[MX]",
+                                                             domainId, itemId));
+    ASSERT_EQ("LD", domainId);
+    ASSERT_EQ("MMXU1$MX$PhV$phsA", itemId);
+
+    ASSERT_FALSE(IEC61850ClientConnection::toMmsVariableName("LD/MMXU1.PhV", domainId, itemId));
+    ASSERT_FALSE(IEC61850ClientConnection::toMmsVariableName("MMXU1.PhV[MX]", domainId, itemId));
+    ASSERT_FALSE(IEC61850ClientConnection::toMmsVariableName("LD/MMXU1[MX]", domainId, itemId));
+}
+
+TEST_F(IEC61850ClientConnectionTestWithIEC61850Server, buildNameTreeInOneRequest)
+{
+    // Test Init
+    ServerConnectionParameters connParam;
+    connParam.ipAddress = "127.0.0.1";
+    connParam.mmsPort = 8102;
+    IEC61850ClientConnection conn(connParam);
+    ASSERT_EQ(true, conn.isConnected());
+
+    // Test Body
+    MmsNameNode nameTree;
+    ASSERT_TRUE(conn.buildNameTree("simpleIOGenericIO/GGIO1.AnIn1",
+                                   FunctionalConstraint_fromString("MX"),
+                                   &nameTree));
+
+    ASSERT_EQ(3, nameTree.children.size());
+    ASSERT_EQ("mag", nameTree.children[0]->mmsName);
+    ASSERT_EQ(1, nameTree.children[0]->children.size());
+    ASSERT_EQ("f", nameTree.children[0]->children[0]->mmsName);
+    ASSERT_EQ("q", nameTree.children[1]->mmsName);
+    ASSERT_EQ("t", nameTree.children[2]->mmsName);
+
+    /** An unknown DO gives an empty tree, and does not affect the connection */
+    MmsNameNode unknownNameTree;
+    ASSERT_TRUE(conn.buildNameTree("simpleIOGenericIO/GGIO1.foo_doesnt_exist",
+                                   FunctionalConstraint_fromString("MX"),
+                                   &unknownNameTree));
+
+    ASSERT_EQ(0, unknownNameTree.children.size());
+    ASSERT_EQ(true, conn.isConnected());
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>  // NOLINT
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+// South_IEC61850_Plugin headers
+#include "iec61850_client_connection_pool.h"
+#include "mock_iec61850_client_connection.h"
+
+using namespace ::testing;
+
+TEST(IEC61850ClientConnectionPoolTest, sendOnFreeAssociation)
+{
+    // Test Init
+    auto emptyMms = std::make_shared<WrappedMms>();
+    auto *firstAssociation = new MockIEC61850ClientConnection();
+    auto *secondAssociation = new MockIEC61850ClientConnection();
+
+    /** Each association is busy during the whole read: the 2 reads use both */
+    for (auto *association : {firstAssociation, secondAssociation}) {
+        EXPECT_CALL(*association, readDO(_, _, _))
+        .Times(1)
+        .WillOnce(Invoke([emptyMms](const std::string &, const FunctionalConstraint &, IedClientError &) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            return emptyMms;
+        }));
+    }
+
+    std::vector<std::unique_ptr<IEC61850ClientConnectionInterface>> associations;
+    associations.emplace_back(firstAssociation);
+    associations.emplace_back(secondAssociation);
+    IEC61850ClientConnectionPool pool(std::move(associations));
+    ASSERT_EQ(2, pool.size());
+
+    // Test Body
+    std::thread otherReader([&pool] {
+        IedClientError error = IED_ERROR_OK;
+        pool.readDO("LD1/GGIO1.SPSSO1", IEC61850_FC_ST, error);
+    });
+    IedClientError error = IED_ERROR_OK;
+    ASSERT_EQ(emptyMms, pool.readDO("LD1/GGIO1.SPSSO2", IEC61850_FC_ST, error));
+    otherReader.join();
+
+    ASSERT_THAT(pool.m_isAssociationBusy, Each(false));
+}
+
+TEST(IEC61850ClientConnectionPoolTest, createDatasetOnEachAssociation)
+{
+    // Test Init
+    auto *firstAssociation = new MockIEC61850ClientConnection();
+    auto *secondAssociation = new MockIEC61850ClientConnection();
+    EXPECT_CALL(*firstAssociation, createDataset("@FledgeDO1", _))
+    .WillOnce(Return(true));
+    EXPECT_CALL(*secondAssociation, createDataset("@FledgeDO1", _))
+    .WillOnce(Return(false));
+    EXPECT_CALL(*firstAssociation, isConnected())
+    .WillRepeatedly(Return(true));
+    EXPECT_CALL(*secondAssociation, isConnected())
+    .WillRepeatedly(Return(false));
+
+    std::vector<std::unique_ptr<IEC61850ClientConnectionInterface>> associations;
+    associations.emplace_back(firstAssociation);
+    associations.emplace_back(secondAssociation);
+    IEC61850ClientConnectionPool pool(std::move(associations));
+
+    // Test Body: a dataset is usable only if all the associations have it
+    ASSERT_FALSE(pool.createDataset("@FledgeDO1", {"LD1/GGIO1.SPSSO1[ST]"}));
+    ASSERT_FALSE(pool.isConnected());
+}
+
+TEST(IEC61850ClientConnectionPoolTest, deleteDatasetRefusedByOneAssociation)
+{
+    // Test Init: the second of 3 associations refuses the dataset
+    auto *firstAssociation = new MockIEC61850ClientConnection();
+    auto *secondAssociation = new MockIEC61850ClientConnection();
+    auto *thirdAssociation = new MockIEC61850ClientConnection();
+    EXPECT_CALL(*firstAssociation, createDataset("@FledgeDO1", _))
+    .WillOnce(Return(true));
+    EXPECT_CALL(*secondAssociation, createDataset("@FledgeDO1", _))
+    .WillOnce(Return(false));
+    EXPECT_CALL(*thirdAssociation, createDataset(_, _))
+    .Times(0);
+
+    /** Only the association which created it deletes it */
+    EXPECT_CALL(*firstAssociation, deleteDataset("@FledgeDO1"))
+    .WillOnce(Return(true));
+    EXPECT_CALL(*secondAssociation, deleteDataset(_))
+    .Times(0);
+    EXPECT_CALL(*thirdAssociation, deleteDataset(_))
+    .Times(0);
+
+    std::vector<std::unique_ptr<IEC61850ClientConnectionInterface>> associations;
+    associations.emplace_back(firstAssociation);
+    associations.emplace_back(secondAssociation);
+    associations.emplace_back(thirdAssociation);
+    IEC61850ClientConnectionPool pool(std::move(associations));
+
+    // Test Body
+    ASSERT_FALSE(pool.createDataset("@FledgeDO1", {"LD1/GGIO1.SPSSO1[ST]"}));
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <chrono>  // NOLINT
+
+// South_IEC61850_Plugin headers
+#include "iec61850_congestion_control.h"
+
+using namespace ::testing;
+
+static ResponseTimeSummary makeResponseTimes(uint64_t responseCount,
+                                             std::chrono::microseconds meanResponseTime,
+                                             uint64_t timeoutCount = 0)
+{
+    ResponseTimeSummary responseTimes;
+
+    for (uint64_t response = 0; response < responseCount; ++response) {
+        responseTimes.record(meanResponseTime);
+    }
+
+    responseTimes.timeoutCount = timeoutCount;
+    return responseTimes;
+}
+
+TEST(IEC61850CongestionControlTest, slowDownOnSlowResponses)
+{
+    // Test Init: 4 associations, congested at 4 times the baseline
+    CongestionControlParameters congestionParams;
+    congestionParams.isEnabled = true;
+    congestionParams.maxSlowdown = 4;
+    IEC61850CongestionControl congestionControl;
+    congestionControl.setParameters(congestionParams, 4);
+
+    ASSERT_FALSE(congestionControl.update(makeResponseTimes(10, std::chrono::milliseconds(10))));
+    ASSERT_EQ(std::chrono::milliseconds(10), congestionControl.getState().baselineResponseTime);
+    ASSERT_EQ(4, congestionControl.getWindow());
+
+    // Test Body: each congested cycle doubles the period and halves the window
+    ASSERT_TRUE(congestionControl.update(makeResponseTimes(10, std::chrono::milliseconds(50))));
+    ASSERT_EQ(std::chrono::milliseconds(2000), congestionControl.scalePeriod(std::chrono::milliseconds(1000)));
+    ASSERT_EQ(2, congestionControl.getWindow());
+
+    ASSERT_TRUE(congestionControl.update(makeResponseTimes(10, std::chrono::milliseconds(50))));
+    ASSERT_TRUE(congestionControl.update(makeResponseTimes(10, std::chrono::milliseconds(50))));
+
+    /** (up to the max slowdown, and 1 request in flight) */
+    ASSERT_EQ(std::chrono::milliseconds(4000), congestionControl.scalePeriod(std::chrono::milliseconds(1000)));
+    ASSERT_EQ(1, congestionControl.getWindow());
+    ASSERT_EQ(3, congestionControl.getState().congestionCount);
+
+    /** The rate recovers a tenth of the nominal rate per cycle */
+    ASSERT_FALSE(congestionControl.update(makeResponseTimes(10, std::chrono::milliseconds(10))));
+    ASSERT_EQ(std::chrono::milliseconds(2857), congestionControl.scalePeriod(std::chrono::milliseconds(1000)));
+    ASSERT_EQ(2, congestionControl.getWindow());
+
+    for (int cycle = 0; cycle < 10; ++cycle) {
+        ASSERT_FALSE(congestionControl.update(makeResponseTimes(10, std::chrono::milliseconds(10))));
+    }
+
+    ASSERT_EQ(std::chrono::milliseconds(1000), congestionControl.scalePeriod(std::chrono::milliseconds(1000)));
+    ASSERT_EQ(4, congestionControl.getWindow());
+}
+
+TEST(IEC61850CongestionControlTest, slowDownOnTimeouts)
+{
+    // Test Init: a configured threshold
+    CongestionControlParameters congestionParams;
+    congestionParams.isEnabled = true;
+    congestionParams.responseTimeThresholdInMs = 100;
+    IEC61850CongestionControl congestionControl;
+    congestionControl.setParameters(congestionParams, 1);
+
+    // Test Body
+    ASSERT_FALSE(congestionControl.update(makeResponseTimes(10, std::chrono::milliseconds(90))));
+    ASSERT_TRUE(congestionControl.update(makeResponseTimes(0, std::chrono::milliseconds(0), 1)));
+    ASSERT_EQ(std::chrono::milliseconds(200), congestionControl.scalePeriod(std::chrono::milliseconds(100)));
+
+    /** A cycle without request changes nothing */
+    ASSERT_TRUE(congestionControl.update(ResponseTimeSummary()));
+    ASSERT_EQ(std::chrono::milliseconds(200), congestionControl.scalePeriod(std::chrono::milliseconds(100)));
+
+    /** A lost connection is a congestion */
+    congestionControl.recordConnectionLoss();
+    ASSERT_EQ(std::chrono::milliseconds(400), congestionControl.scalePeriod(std::chrono::milliseconds(100)));
+
+    /** A new configuration restarts at the nominal rate */
+    congestionControl.setParameters(congestionParams, 1);
+    ASSERT_EQ(std::chrono::milliseconds(100), congestionControl.scalePeriod(std::chrono::milliseconds(100)));
+}
+
+TEST(IEC61850CongestionControlTest, keepNominalRateWhenDisabled)
+{
+    // Test Init
+    IEC61850CongestionControl congestionControl;
+    congestionControl.setParameters(CongestionControlParameters(), 2);
+
+    // Test Body
+    ASSERT_FALSE(congestionControl.update(makeResponseTimes(1, std::chrono::seconds(10), 5)));
+    congestionControl.recordConnectionLoss();
+    ASSERT_EQ(std::chrono::milliseconds(100), congestionControl.scalePeriod(std::chrono::milliseconds(100)));
+    ASSERT_EQ(2, congestionControl.getWindow());
+}
+
+TEST(IEC61850CongestionControlTest, mergeResponseTimes)
+{
+    ResponseTimeSummary first = makeResponseTimes(2, std::chrono::milliseconds(10), 1);
+    ResponseTimeSummary second = makeResponseTimes(2, std::chrono::milliseconds(30));
+
+    // Test Body
+    first.merge(second);
+    ASSERT_EQ(4, first.responseCount);
+    ASSERT_EQ(1, first.timeoutCount);
+    ASSERT_EQ(std::chrono::milliseconds(20), first.getMeanResponseTime());
+    ASSERT_EQ(std::chrono::milliseconds(30), first.maxResponseTime);
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <thread>  // NOLINT
+
+// South_IEC61850_Plugin headers
+#include "iec61850_discovery_coordinator.h"
+
+using namespace ::testing;
+
+TEST(IEC61850DiscoveryCoordinatorTest, grantInPriorityOrder)
+{
+    // Test Init
+    IEC61850DiscoveryCoordinator coordinator(1);
+    std::atomic<bool> noStopOrder{false};
+    const std::chrono::milliseconds noWait(0);
+
+    auto bigIed = coordinator.enqueue(1000);
+    auto smallIed = coordinator.enqueue(10);
+    auto otherSmallIed = coordinator.enqueue(10);
+
+    // Test Body: the fewest points first, then the arrival order
+    ASSERT_FALSE(coordinator.waitForSlot(bigIed, noWait, noStopOrder));
+    ASSERT_FALSE(coordinator.waitForSlot(otherSmallIed, noWait, noStopOrder));
+    ASSERT_TRUE(coordinator.waitForSlot(smallIed, noWait, noStopOrder));
+
+    /** 1 slot only */
+    ASSERT_FALSE(coordinator.waitForSlot(otherSmallIed, noWait, noStopOrder));
+    coordinator.release();
+
+    ASSERT_TRUE(coordinator.waitForSlot(otherSmallIed, noWait, noStopOrder));
+    coordinator.release();
+
+    ASSERT_TRUE(coordinator.waitForSlot(bigIed, noWait, noStopOrder));
+    coordinator.release();
+
+    ASSERT_EQ(0, coordinator.m_runningDiscoveries);
+    ASSERT_EQ(0, coordinator.m_waitingRequests.size());
+}
+
+TEST(IEC61850DiscoveryCoordinatorTest, cancelWaitingTicket)
+{
+    // Test Init
+    IEC61850DiscoveryCoordinator coordinator(1);
+    std::atomic<bool> noStopOrder{false};
+    const std::chrono::milliseconds noWait(0);
+
+    auto firstIed = coordinator.enqueue(1);
+    auto secondIed = coordinator.enqueue(2);
+
+    // Test Body
+    coordinator.cancel(firstIed);
+    ASSERT_FALSE(coordinator.waitForSlot(firstIed, noWait, noStopOrder));
+    ASSERT_TRUE(coordinator.waitForSlot(secondIed, noWait, noStopOrder));
+    coordinator.release();
+
+    ASSERT_EQ(0, coordinator.m_pointCountByTicket.size());
+}
+
+TEST(IEC61850DiscoveryCoordinatorTest, wakeUpOnRelease)
+{
+    // Test Init
+    IEC61850DiscoveryCoordinator coordinator(1);
+    std::atomic<bool> noStopOrder{false};
+
+    auto firstIed = coordinator.enqueue(1);
+    auto secondIed = coordinator.enqueue(2);
+    ASSERT_TRUE(coordinator.waitForSlot(firstIed, std::chrono::milliseconds(0), noStopOrder));
+
+    // Test Body
+    std::thread releaseThread([&coordinator]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        coordinator.release();
+    });
+
+    ASSERT_TRUE(coordinator.waitForSlot(secondIed, std::chrono::seconds(5), noStopOrder));
+    coordinator.release();
+
+    // Test teardown
+    releaseThread.join();
+}
+
+TEST(IEC61850DiscoveryCoordinatorTest, stopWhileWaiting)
+{
+    // Test Init
+    IEC61850DiscoveryCoordinator coordinator(1);
+    std::atomic<bool> noStopOrder{false};
+    std::atomic<bool> stopOrder{false};
+
+    auto firstIed = coordinator.enqueue(1);
+    auto secondIed = coordinator.enqueue(2);
+    ASSERT_TRUE(coordinator.waitForSlot(firstIed, std::chrono::milliseconds(0), noStopOrder));
+
+    // Test Body
+    std::thread stopThread([&stopOrder]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        stopOrder = true;
+    });
+
+    ASSERT_FALSE(coordinator.waitForSlot(secondIed, std::chrono::seconds(5), stopOrder));
+
+    // Test teardown
+    stopThread.join();
+    coordinator.release();
+}
+
+TEST(IEC61850DiscoveryCoordinatorTest, noLimit)
+{
+    IEC61850DiscoveryCoordinator coordinator(0);
+    std::atomic<bool> noStopOrder{false};
+    const std::chrono::milliseconds noWait(0);
+
+    auto bigIed = coordinator.enqueue(1000);
+    auto smallIed = coordinator.enqueue(10);
+
+    ASSERT_TRUE(coordinator.waitForSlot(bigIed, noWait, noStopOrder));
+    ASSERT_TRUE(coordinator.waitForSlot(smallIed, noWait, noStopOrder));
+    coordinator.release();
+    coordinator.release();
+}
@@ -0,0 +1,259 @@
+#include <chrono>  // NOLINT
+#include <future>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iec61850_client_config.h"
+#include "fake_iec61850_client_connection.h"
+
+TEST(FakeIEC61850ClientConnectionTest, answerInVirtualTime)
+{
+    // Test Init: 2 ms per request, 1 ms more per DO
+    FakeIedProfile profile;
+    profile.rtt = std::chrono::milliseconds(2);
+    profile.rttPerItem = std::chrono::milliseconds(1);
+    VirtualClock clock;
+    FakeIEC61850ClientConnection connection(profile, clock);
+    IedClientError error = IED_ERROR_OK;
+
+    // Test Body: the exchanges follow each other, nothing sleeps
+    auto wrappedMms = connection.readDO("LD1/GGIO1.AnIn1", IEC61850_FC_MX, error);
+    ASSERT_NE(nullptr, wrappedMms);
+    ASSERT_EQ(IED_ERROR_OK, error);
+    ASSERT_EQ(MMS_STRUCTURE, MmsValue_getType(wrappedMms->getMmsValue()));
+    ASSERT_EQ(3, MmsValue_getArraySize(wrappedMms->getMmsValue()));
+
+    wrappedMms = connection.readMultipleDO({"LD1/GGIO1.AnIn1[MX]", "LD1/GGIO1.SPCSO1[ST]"}, ReadPriority::HIGH, error);
+    ASSERT_NE(nullptr, wrappedMms);
+    ASSERT_EQ(2, MmsValue_getArraySize(wrappedMms->getMmsValue()));
+
+    ASSERT_EQ(std::chrono::milliseconds(3 + 4), clock.now());
+
+    ResponseTimeSummary responseTimes = connection.takeResponseTimes();
+    ASSERT_EQ(2, responseTimes.responseCount);
+    ASSERT_EQ(std::chrono::milliseconds(4), responseTimes.maxResponseTime);
+
+    RequestLatencies latencies = connection.getRequestLatencies();
+    ASSERT_EQ(1, latencies[static_cast<std::size_t>(ReadPriority::HIGH)].getCount());
+    ASSERT_EQ(1, latencies[static_cast<std::size_t>(ReadPriority::NORMAL)].getCount());
+}
+
+TEST(FakeIEC61850ClientConnectionTest, drawSameRttsWithSameSeed)
+{
+    // Test Init: log-normal RTT, the same references read in different orders
+    FakeIedProfile profile;
+    profile.rttDistribution = RttDistribution::LOG_NORMAL;
+    profile.rtt = std::chrono::milliseconds(5);
+    profile.rttSigma = 1.0;
+    VirtualClock firstClock;
+    VirtualClock secondClock;
+    FakeIEC61850ClientConnection first(profile, firstClock);
+    FakeIEC61850ClientConnection second(profile, secondClock);
+    IedClientError error = IED_ERROR_OK;
+
+    first.readDO("LD1/GGIO1.Ind1", IEC61850_FC_ST, error);
+    first.readDO("LD1/GGIO1.Ind2", IEC61850_FC_ST, error);
+    second.readDO("LD1/GGIO1.Ind2", IEC61850_FC_ST, error);
+    second.readDO("LD1/GGIO1.Ind1", IEC61850_FC_ST, error);
+
+    // Test Body: the RTT of a request does not depend on the order
+    std::vector<FakeCallRecord> firstCalls = first.getCallLog();
+    std::vector<FakeCallRecord> secondCalls = second.getCallLog();
+    ASSERT_EQ(firstCalls[0].rtt, secondCalls[1].rtt);
+    ASSERT_EQ(firstCalls[1].rtt, secondCalls[0].rtt);
+    ASSERT_NE(firstCalls[0].rtt, firstCalls[1].rtt);
+    ASSERT_EQ(firstClock.now(), secondClock.now());
+
+    /** but on the seed */
+    profile.seed = 2;
+    VirtualClock otherClock;
+    FakeIEC61850ClientConnection other(profile, otherClock);
+    other.readDO("LD1/GGIO1.Ind1", IEC61850_FC_ST, error);
+    ASSERT_NE(firstCalls[0].rtt, other.getCallLog()[0].rtt);
+}
+
+TEST(FakeIEC61850ClientConnectionTest, injectTimeouts)
+{
+    // Test Init
+    FakeIedProfile profile;
+    profile.timeoutRatio = 1.0;
+    profile.requestTimeout = std::chrono::seconds(3);
+    VirtualClock clock;
+    FakeIEC61850ClientConnection connection(profile, clock);
+    IedClientError error = IED_ERROR_OK;
+
+    // Test Body: no response, after the request timeout
+    ASSERT_EQ(nullptr, connection.readDO("LD1/GGIO1.Ind1", IEC61850_FC_ST, error));
+    ASSERT_EQ(IED_ERROR_TIMEOUT, error);
+    ASSERT_EQ(std::chrono::seconds(3), clock.now());
+    ASSERT_EQ(1, connection.getOutcomeCount(FakeCallOutcome::TIMEOUT));
+
+    ResponseTimeSummary responseTimes = connection.takeResponseTimes();
+    ASSERT_EQ(0, responseTimes.responseCount);
+    ASSERT_EQ(1, responseTimes.timeoutCount);
+}
+
+TEST(FakeIEC61850ClientConnectionTest, loseConnectionAfterRequests)
+{
+    // Test Init
+    FakeIedProfile profile;
+    profile.disconnectAfterRequests = 2;
+    VirtualClock clock;
+    FakeIEC61850ClientConnection connection(profile, clock);
+    IedClientError error = IED_ERROR_OK;
+
+    // Test Body: the third request loses the connection
+    ASSERT_NE(nullptr, connection.readDO("LD1/GGIO1.Ind1", IEC61850_FC_ST, error));
+    ASSERT_NE(nullptr, connection.readDO("LD1/GGIO1.Ind1", IEC61850_FC_ST, error));
+    ASSERT_TRUE(connection.isConnected());
+
+    ASSERT_EQ(nullptr, connection.readDO("LD1/GGIO1.Ind1", IEC61850_FC_ST, error));
+    ASSERT_EQ(IED_ERROR_CONNECTION_LOST, error);
+    ASSERT_FALSE(connection.isConnected());
+    ASSERT_FALSE(connection.keepAlive());
+    ASSERT_EQ(nullptr, connection.readDO("LD1/GGIO1.Ind1", IEC61850_FC_ST, error));
+    ASSERT_EQ(2, connection.getOutcomeCount(FakeCallOutcome::DISCONNECTED));
+
+    /** until the reconnection */
+    connection.reconnect();
+    ASSERT_NE(nullptr, connection.readDO("LD1/GGIO1.Ind1", IEC61850_FC_ST, error));
+}
+
+TEST(FakeIEC61850ClientConnectionTest, refuseAboveOutstandingCallLimit)
+{
+    // Test Init: 1 request in flight at most
+    FakeIedProfile profile;
+    profile.maxOutstandingCalls = 1;
+    profile.rtt = std::chrono::milliseconds(10);
+    VirtualClock clock;
+    FakeIEC61850ClientConnection connection(profile, clock);
+    IedClientError error = IED_ERROR_OK;
+
+    // Test Body: 2 threads send their request at the start of the cycle
+    connection.beginCycle();
+    IedClientError firstError = IED_ERROR_OK;
+    IedClientError secondError = IED_ERROR_OK;
+    std::thread firstThread([&] { connection.readDO("LD1/GGIO1.Ind1", IEC61850_FC_ST, firstError); });
+    std::thread secondThread([&] { connection.readDO("LD1/GGIO1.Ind2", IEC61850_FC_ST, secondError); });
+    firstThread.join();
+    secondThread.join();
+
+    ASSERT_EQ(1, connection.getOutcomeCount(FakeCallOutcome::ANSWERED));
+    ASSERT_EQ(1, connection.getOutcomeCount(FakeCallOutcome::REFUSED));
+    ASSERT_EQ(1, connection.getPeakOutstandingCalls());
+    ASSERT_EQ(IED_ERROR_OUTSTANDING_CALL_LIMIT_REACHED, (firstError == IED_ERROR_OK) ? secondError : firstError);
+    ASSERT_EQ(std::chrono::milliseconds(10), clock.now());
+
+    /** In the next cycle, the requests of 1 thread follow each other */
+    connection.beginCycle();
+    connection.readDO("LD1/GGIO1.Ind1", IEC61850_FC_ST, error);
+    connection.readDO("LD1/GGIO1.Ind2", IEC61850_FC_ST, error);
+    ASSERT_EQ(3, connection.getOutcomeCount(FakeCallOutcome::ANSWERED));
+    ASSERT_EQ(std::chrono::milliseconds(30), clock.now());
+}
+
+TEST(FakeIEC61850ClientConnectionTest, truncateMismatchingResponses)
+{
+    // Test Init
+    FakeIedProfile profile;
+    profile.structureMismatchRatio = 1.0;
+    VirtualClock clock;
+    FakeIEC61850ClientConnection connection(profile, clock);
+    IedClientError error = IED_ERROR_OK;
+    connection.setDataset("LD1/LLN0.Mags", {"LD1/GGIO1.AnIn1[MX]", "LD1/GGIO1.AnIn2[MX]"});
+
+    // Test Body: 1 member or 1 attribute is missing
+    auto wrappedMms = connection.readDataset("LD1/LLN0.Mags", error);
+    ASSERT_NE(nullptr, wrappedMms);
+    ASSERT_EQ(1, MmsValue_getArraySize(wrappedMms->getMmsValue()));
+
+    wrappedMms = connection.readDO("LD1/GGIO1.AnIn1", IEC61850_FC_MX, error);
+    ASSERT_NE(nullptr, wrappedMms);
+    ASSERT_EQ(2, MmsValue_getArraySize(wrappedMms->getMmsValue()));
+
+    /** An unknown dataset is not answered */
+    ASSERT_EQ(nullptr, connection.readDataset("LD1/LLN0.Unknown", error));
+    ASSERT_EQ(IED_ERROR_OBJECT_DOES_NOT_EXIST, error);
+    ASSERT_EQ(3, connection.getOutcomeCount(FakeCallOutcome::STRUCTURE_MISMATCH));
+}
+
+TEST(FakeIEC61850ClientConnectionTest, countPeakWhateverTheArrivalOrder)
+{
+    // Test Init: 1 ms per DO, 2 threads of 2 requests
+    FakeIedProfile profile;
+    profile.rtt = std::chrono::microseconds(0);
+    profile.rttPerItem = std::chrono::milliseconds(1);
+    IedClientError error = IED_ERROR_OK;
+
+    /** 2 threads, the second one sends its requests after those of the first one */
+    auto runThreads = [&error](FakeIEC61850ClientConnection &connection,
+                               std::pair<std::size_t, std::size_t> firstCounts,
+                               std::pair<std::size_t, std::size_t> secondCounts) {
+        auto sendRequests = [&connection, &error](std::pair<std::size_t, std::size_t> counts) {
+            connection.readMultipleDO(std::vector<std::string>(counts.first, "LD1/GGIO1.Ind1[ST]"),
+                                      ReadPriority::NORMAL, error);
+            connection.readMultipleDO(std::vector<std::string>(counts.second, "LD1/GGIO1.Ind2[ST]"),
+                                      ReadPriority::NORMAL, error);
+        };
+        std::promise<void> firstDone;
+        std::promise<void> secondDone;
+        std::shared_future<void> secondDoneFuture = secondDone.get_future().share();
+
+        /** (the first thread lives until the end: its id is not reused by the second one) */
+        std::thread firstThread([&] {
+            sendRequests(firstCounts);
+            firstDone.set_value();
+            secondDoneFuture.wait();
+        });
+        firstDone.get_future().wait();
+        std::thread secondThread([&] {
+            sendRequests(secondCounts);
+            secondDone.set_value();
+        });
+        secondThread.join();
+        firstThread.join();
+    };
+
+    // Test Body: the requests of a thread arrive before or after those of the other one
+    VirtualClock firstClock;
+    FakeIEC61850ClientConnection first(profile, firstClock);
+    first.beginCycle();
+    runThreads(first, {1, 4}, {3, 1});
+
+    VirtualClock secondClock;
+    FakeIEC61850ClientConnection second(profile, secondClock);
+    second.beginCycle();
+    runThreads(second, {3, 1}, {1, 4});
+
+    ASSERT_EQ(2, first.getPeakOutstandingCalls());
+    ASSERT_EQ(first.getPeakOutstandingCalls(), second.getPeakOutstandingCalls());
+    ASSERT_EQ(std::chrono::milliseconds(5), firstClock.now());
+    ASSERT_EQ(firstClock.now(), secondClock.now());
+
+    /** The peak of a cycle is kept in the next ones */
+    first.beginCycle();
+    first.readDO("LD1/GGIO1.Ind1", IEC61850_FC_ST, error);
+    ASSERT_EQ(2, first.getPeakOutstandingCalls());
+}
+
+TEST(FakeIEC61850ClientConnectionTest, boundCallLog)
+{
+    // Test Init
+    FakeIedProfile profile;
+    profile.maxCallLogSize = 2;
+    VirtualClock clock;
+    FakeIEC61850ClientConnection connection(profile, clock);
+    IedClientError error = IED_ERROR_OK;
+
+    // Test Body: the later requests are only counted
+    for (int request = 0; request < 5; ++request) {
+        connection.readDO("LD1/GGIO1.Ind1", IEC61850_FC_ST, error);
+    }
+
+    ASSERT_EQ(2, connection.getCallLog().size());
+    ASSERT_EQ(5, connection.getOutcomeCount(FakeCallOutcome::ANSWERED));
+}
@@ -1,3 +1,6 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
 #include <string>
 
 #include <gtest/gtest.h>
@@ -77,6 +80,117 @@ TEST(IEC61850Test, stopClient)
     ASSERT_EQ(0, iec61850.m_clients.size());
 }
 
+TEST(IEC61850Test, reconfigureKeepsClients)
+{
+    ConfigCategory config("TestDefaultConfig", default_config);
+    config.setItemsValueFromDefault();
+    IEC61850 iec61850;
+    iec61850.setConfig(config);
+    iec61850.start();
+    ASSERT_EQ(2, iec61850.m_clients.size());
+    std::map<std::string, const IEC61850Client *> clientsBefore;
+
+    for (const auto &client : iec61850.m_clients) {
+        clientsBefore[client.first] = client.second.get();
+    }
+
+    auto configBefore = iec61850.m_config;
+    iec61850.reconfigure(config);
+    // Same connections: no client is restarted
+    ASSERT_NE(configBefore, iec61850.m_config);
+    ASSERT_EQ(2, iec61850.m_clients.size());
+
+    for (const auto &client : iec61850.m_clients) {
+        ASSERT_EQ(clientsBefore[client.first], client.second.get());
+    }
+
+    // test teardown
+    iec61850.stop();
+}
+
+TEST(IEC61850Test, startRedundantClients)
+{
+    ConfigCategory config("TestDefaultConfig", default_config);
+    config.setItemsValueFromDefault();
+    IEC61850 iec61850;
+    iec61850.setConfig(config);
+    iec61850.m_config->isRedundancyEnabled = true;
+    iec61850.start();
+    // 1 client per connection, all in the same redundancy group
+    ASSERT_THAT(iec61850.m_redundancyGroup, NotNull());
+    ASSERT_EQ(2, iec61850.m_clients.size());
+    // test teardown
+    iec61850.stop();
+    ASSERT_THAT(iec61850.m_redundancyGroup, IsNull());
+}
+
+
+TEST(IEC61850Test, staggerPollingPhases)
+{
+    ConfigCategory config("TestDefaultConfig", default_config);
+    config.setItemsValueFromDefault();
+    IEC61850 iec61850;
+    iec61850.setConfig(config);
+    iec61850.m_config->applicationParams.readPollingPeriodInMs = 1000;
+    iec61850.start();
+    // The 2 clients are read at half a period of each other
+    auto phases = iec61850.getPollingPhases();
+    ASSERT_EQ(2, phases.size());
+    ASSERT_EQ(std::chrono::milliseconds(0), phases.begin()->second);
+    ASSERT_EQ(std::chrono::milliseconds(500), phases.rbegin()->second);
+    // test teardown
+    iec61850.stop();
+}
+
+TEST(IEC61850Test, shareRequestBudgetsByLinkGroup)
+{
+    ConfigCategory config("TestDefaultConfig", default_config);
+    config.setItemsValueFromDefault();
+    IEC61850 iec61850;
+    iec61850.setConfig(config);
+    iec61850.m_config->applicationParams.requestBudget.requestsPerSecond = 50.0;
+    iec61850.m_config->applicationParams.linkBudgets["substationA"].requestsPerSecond = 20.0;
+    iec61850.m_config->serverConfigDict["0.0.0.0_102"].linkGroup = "substationA";
+    iec61850.m_config->serverConfigDict["0.0.0.0_8102"].linkGroup = "unknownLink";
+    // A link group without budget uses the global budget
+    ASSERT_EQ("substationA", IEC61850::getRequestBudgetKey(*iec61850.m_config,
+                                                           iec61850.m_config->serverConfigDict["0.0.0.0_102"]));
+    ASSERT_EQ("", IEC61850::getRequestBudgetKey(*iec61850.m_config,
+                                                iec61850.m_config->serverConfigDict["0.0.0.0_8102"]));
+    iec61850.start();
+    // 1 budget per used link group
+    auto statistics = iec61850.getRequestBudgetStatistics();
+    ASSERT_EQ(2, statistics.size());
+    ASSERT_EQ(1, statistics.count(""));
+    ASSERT_EQ(1, statistics.count("substationA"));
+    // test teardown
+    iec61850.stop();
+    ASSERT_TRUE(iec61850.getRequestBudgetStatistics().empty());
+}
+
+TEST(IEC61850Test, dumpTraceWhenTracingDisabled)
+{
+    IEC61850 iec61850;
+    TracingParameters tracingParams;
+    tracingParams.isEnabled = true;
+    tracingParams.filePath = "/tmp/iec61850_test_trace.json";
+    std::remove(tracingParams.filePath.c_str());
+    // The spans are recorded while the tracing is enabled
+    iec61850.applyTracing(tracingParams);
+    ASSERT_TRUE(IEC61850Tracer::isEnabled());
+    std::vector<Datapoint *> points;
+    iec61850.ingest(points, "TM1");
+    // and written in the file when it is disabled
+    tracingParams.isEnabled = false;
+    iec61850.applyTracing(tracingParams);
+    ASSERT_FALSE(IEC61850Tracer::isEnabled());
+    std::ifstream traceFile(tracingParams.filePath);
+    std::stringstream trace;
+    trace << traceFile.rdbuf();
+    ASSERT_NE(std::string::npos, trace.str().find("\"name\":\"ingest_lock_wait\""));
+    ASSERT_NE(std::string::npos, trace.str().find("\"name\":\"ingest_callback\""));
+    std::remove(tracingParams.filePath.c_str());
+}
 
 void ingestDemoCallback(INGEST_DATA_TYPE, Reading reading)
 {
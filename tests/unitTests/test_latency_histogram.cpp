@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <chrono>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+// South_IEC61850_Plugin headers
+#include "iec61850_latency_histogram.h"
+
+using namespace ::testing;
+
+TEST(LatencyHistogramTest, percentilesWithinBucketPrecision)
+{
+    // Test Init: 1 to 1000 ms, 1 value per ms
+    LatencyHistogram histogram;
+
+    for (int value = 1; value <= 1000; ++value) {
+        histogram.record(std::chrono::milliseconds(value));
+    }
+
+    // Test Body: the percentiles are known within 12.5 %
+    ASSERT_EQ(1000, histogram.getCount());
+    ASSERT_EQ(std::chrono::microseconds(500500), histogram.getMean());
+    ASSERT_EQ(std::chrono::milliseconds(1000), histogram.getMax());
+
+    for (double percentile : {1.0, 50.0, 90.0, 99.0}) {
+        double expectedInUs = percentile * 10000.0;
+        double valueInUs = static_cast<double>(histogram.getPercentile(percentile).count());
+        ASSERT_GE(valueInUs, expectedInUs) << percentile;
+        ASSERT_LE(valueInUs, expectedInUs * 1.125) << percentile;
+    }
+
+    /** (the highest percentile is the max) */
+    ASSERT_EQ(std::chrono::milliseconds(1000), histogram.getPercentile(100.0));
+}
+
+TEST(LatencyHistogramTest, smallValuesAreExact)
+{
+    LatencyHistogram histogram;
+
+    for (int value = 0; value < 16; ++value) {
+        histogram.record(std::chrono::microseconds(value));
+    }
+
+    // Test Body
+    ASSERT_EQ(std::chrono::microseconds(7), histogram.getPercentile(50.0));
+    ASSERT_EQ(std::chrono::microseconds(15), histogram.getPercentile(100.0));
+
+    /** A merged histogram counts both */
+    LatencyHistogram otherHistogram;
+    otherHistogram.record(std::chrono::hours(1));
+    histogram.merge(otherHistogram);
+    ASSERT_EQ(17, histogram.getCount());
+    ASSERT_EQ(std::chrono::hours(1), histogram.getMax());
+    ASSERT_EQ(std::chrono::microseconds(15), histogram.getPercentile(90.0));
+}
+
+TEST(LatencyHistogramTest, recordFromParallelThreads)
+{
+    // Test Init
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+
+    // Test Body: no duration is lost without lock
+    for (int thread = 0; thread < 4; ++thread) {
+        threads.emplace_back([&histogram, thread] {
+            for (int value = 0; value < 10000; ++value) {
+                histogram.record(std::chrono::microseconds(value % 100 + thread * 1000));
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(40000, histogram.getCount());
+    ASSERT_EQ(std::chrono::microseconds(3099), histogram.getMax());
+}
+
+TEST(LatencyHistogramTest, takeStartsAgainEmpty)
+{
+    // Test Init
+    LatencyHistogram histogram;
+    histogram.record(std::chrono::milliseconds(3));
+    histogram.record(std::chrono::milliseconds(5));
+
+    // Test Body
+    LatencyHistogram taken = histogram.take();
+    ASSERT_EQ(2, taken.getCount());
+    ASSERT_EQ(std::chrono::milliseconds(4), taken.getMean());
+    ASSERT_EQ(std::chrono::milliseconds(5), taken.getMax());
+
+    ASSERT_EQ(0, histogram.getCount());
+    ASSERT_EQ(std::chrono::microseconds(0), histogram.getMax());
+    ASSERT_EQ(std::chrono::microseconds(0), histogram.getPercentile(50.0));
+
+    /** A copy is independent of the original */
+    LatencyHistogram copy = taken;
+    taken.record(std::chrono::milliseconds(1));
+    ASSERT_EQ(2, copy.getCount());
+    ASSERT_EQ(3, taken.getCount());
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <chrono>  // NOLINT
+#include <cstdint>
+
+// South_IEC61850_Plugin headers
+#include "iec61850_log.h"
+
+using namespace ::testing;
+
+TEST(IEC61850LogTest, rateLimitMessages)
+{
+    // Test Init
+    IEC61850LogRateLimiter rateLimiter(LogLevel::ERROR_LEVEL, __FILE__, __LINE__, 1000, 2);
+    std::chrono::steady_clock::time_point now(std::chrono::seconds(100));
+    uint64_t suppressedCount = 0;
+
+    // Test Body: the burst is logged, the next messages of the period are suppressed
+    ASSERT_TRUE(rateLimiter.tryAcquire(now, suppressedCount));
+    ASSERT_EQ(0, suppressedCount);
+    ASSERT_TRUE(rateLimiter.tryAcquire(now + std::chrono::milliseconds(10), suppressedCount));
+
+    for (int message = 0; message < 3; ++message) {
+        ASSERT_FALSE(rateLimiter.tryAcquire(now + std::chrono::milliseconds(999), suppressedCount));
+        ASSERT_EQ(0, suppressedCount);
+    }
+
+    /** The first message of the next period reports the suppressed ones */
+    ASSERT_TRUE(rateLimiter.tryAcquire(now + std::chrono::milliseconds(1000), suppressedCount));
+    ASSERT_EQ(3, suppressedCount);
+    ASSERT_TRUE(rateLimiter.tryAcquire(now + std::chrono::milliseconds(1001), suppressedCount));
+    ASSERT_EQ(0, suppressedCount);
+}
+
+TEST(IEC61850LogTest, reportSuppressedMessagesAfterPeriod)
+{
+    // Test Init: the errors stop after the suppressed ones
+    IEC61850LogRateLimiter rateLimiter(LogLevel::ERROR_LEVEL, __FILE__, __LINE__, 1000, 1);
+    std::chrono::steady_clock::time_point now(std::chrono::seconds(100));
+    uint64_t suppressedCount = 0;
+
+    ASSERT_TRUE(rateLimiter.tryAcquire(now, suppressedCount));
+    ASSERT_FALSE(rateLimiter.tryAcquire(now, suppressedCount));
+    ASSERT_FALSE(rateLimiter.tryAcquire(now, suppressedCount));
+
+    // Test Body: reported once the period has ended, without a new message
+    ASSERT_EQ(0, rateLimiter.takeExpiredSuppressedCount(now + std::chrono::milliseconds(999)));
+    ASSERT_EQ(2, rateLimiter.takeExpiredSuppressedCount(now + std::chrono::milliseconds(1000)));
+    ASSERT_EQ(0, rateLimiter.takeExpiredSuppressedCount(now + std::chrono::milliseconds(2000)));
+
+    /** The next message starts a new period, without reporting them again */
+    ASSERT_TRUE(rateLimiter.tryAcquire(now + std::chrono::milliseconds(1500), suppressedCount));
+    ASSERT_EQ(0, suppressedCount);
+    ASSERT_FALSE(rateLimiter.tryAcquire(now + std::chrono::milliseconds(1600), suppressedCount));
+
+    /** The periodic report takes the counts of all the call sites */
+    IEC61850Log::reportSuppressedMessages(now + std::chrono::milliseconds(2500));
+    ASSERT_EQ(0, rateLimiter.takeExpiredSuppressedCount(now + std::chrono::milliseconds(2500)));
+    ASSERT_TRUE(rateLimiter.tryAcquire(now + std::chrono::milliseconds(2600), suppressedCount));
+    ASSERT_EQ(0, suppressedCount);
+}
+
+TEST(IEC61850LogTest, logBasenameOfFile)
+{
+    ASSERT_STREQ("iec61850_client.cpp", IEC61850Log::getBasename("/home/build/src/iec61850_client.cpp"));
+    ASSERT_STREQ("test_log.cpp", IEC61850Log::getBasename("test_log.cpp"));
+}
+
+TEST(IEC61850LogTest, skipDisabledLevels)
+{
+    // Test Init
+    IEC61850Log::setMinLevel("warning");
+    int evaluationCount = 0;
+    auto evaluate = [&evaluationCount]() { return ++evaluationCount; };
+
+    // Test Body: the arguments of a disabled message are not evaluated
+    IEC61850_LOG_DEBUG("value %d", evaluate());
+    IEC61850_LOG_INFO("value %d", evaluate());
+    ASSERT_EQ(0, evaluationCount);
+
+    IEC61850_LOG_WARN("value %d", evaluate());
+    IEC61850_LOG_RATE_LIMITED_ERROR("value %d", evaluate());
+    ASSERT_EQ(2, evaluationCount);
+
+    /** An unknown level is the default one */
+    ASSERT_EQ(LogLevel::INFO_LEVEL, IEC61850Log::parseLevel("verbose"));
+    IEC61850Log::setMinLevel("info");
+}
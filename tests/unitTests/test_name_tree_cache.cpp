@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <memory>
+
+// South_IEC61850_Plugin headers
+#include "iec61850_name_tree_cache.h"
+
+using namespace ::testing;
+
+/** Name tree of a MV DO: mag { f }, q, t */
+static std::shared_ptr<MmsNameNode> buildMvNameTree(const std::string &label)
+{
+    auto root = std::make_shared<MmsNameNode>();
+    root->mmsName = label;
+
+    auto mag = std::make_shared<MmsNameNode>();
+    mag->mmsName = "mag";
+    auto f = std::make_shared<MmsNameNode>();
+    f->mmsName = "f";
+    mag->children.push_back(f);
+    root->children.push_back(mag);
+
+    auto q = std::make_shared<MmsNameNode>();
+    q->mmsName = "q";
+    root->children.push_back(q);
+
+    auto t = std::make_shared<MmsNameNode>();
+    t->mmsName = "t";
+    root->children.push_back(t);
+
+    return root;
+}
+
+TEST(IEC61850NameTreeCacheTest, shareIdenticalSubtrees)
+{
+    IEC61850NameTreeCache cache;
+
+    auto tm1 = buildMvNameTree("TM1");
+    auto tm2 = buildMvNameTree("TM2");
+    cache.internChildren(*tm1);
+    cache.internChildren(*tm2);
+
+    /** Same subtrees: same instances, the roots stay specific */
+    ASSERT_EQ("TM1", tm1->mmsName);
+    ASSERT_EQ("TM2", tm2->mmsName);
+    ASSERT_EQ(3, tm2->children.size());
+    ASSERT_EQ(tm1->children[0].get(), tm2->children[0].get());
+    ASSERT_EQ(tm1->children[1].get(), tm2->children[1].get());
+    ASSERT_EQ(tm1->children[2].get(), tm2->children[2].get());
+    ASSERT_EQ("f", tm2->children[0]->children[0]->mmsName);
+
+    /** mag, f, q, t */
+    ASSERT_EQ(4, cache.size());
+}
+
+TEST(IEC61850NameTreeCacheTest, distinguishDifferentSubtrees)
+{
+    IEC61850NameTreeCache cache;
+
+    auto tm1 = buildMvNameTree("TM1");
+    auto tm2 = buildMvNameTree("TM2");
+
+    /** Same name, different content: mag { i } */
+    auto magI = std::make_shared<MmsNameNode>();
+    magI->mmsName = "mag";
+    auto i = std::make_shared<MmsNameNode>();
+    i->mmsName = "i";
+    magI->children.push_back(i);
+    tm2->children[0] = magI;
+
+    cache.internChildren(*tm1);
+    cache.internChildren(*tm2);
+
+    ASSERT_NE(tm1->children[0].get(), tm2->children[0].get());
+    ASSERT_EQ(tm1->children[1].get(), tm2->children[1].get());
+    ASSERT_EQ("i", tm2->children[0]->children[0]->mmsName);
+}
+
+TEST(IEC61850NameTreeCacheTest, releaseUnusedSubtrees)
+{
+    IEC61850NameTreeCache cache;
+
+    auto tm1 = buildMvNameTree("TM1");
+    cache.internChildren(*tm1);
+    ASSERT_EQ(4, cache.size());
+
+    tm1.reset();
+    ASSERT_EQ(0, cache.size());
+    ASSERT_EQ(0, cache.m_subtrees.size());
+}
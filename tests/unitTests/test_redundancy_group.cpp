@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+
+// South_IEC61850_Plugin headers
+#include "iec61850_redundancy_group.h"
+
+using namespace ::testing;
+
+TEST(IEC61850RedundancyGroupTest, electFirstHealthyMember)
+{
+    // Test Init
+    IEC61850RedundancyGroup redundancyGroup;
+    redundancyGroup.addMember("ied_102", nullptr);
+    redundancyGroup.addMember("ied_8102", nullptr);
+    ASSERT_EQ("", redundancyGroup.getActiveMember());
+
+    // Test Body: the first healthy member is active, the others in standby
+    ASSERT_FALSE(redundancyGroup.updateHealth("ied_102", false));
+    ASSERT_TRUE(redundancyGroup.updateHealth("ied_8102", true));
+    ASSERT_FALSE(redundancyGroup.updateHealth("ied_102", true));
+    ASSERT_EQ("ied_8102", redundancyGroup.getActiveMember());
+
+    /** Unknown member */
+    ASSERT_FALSE(redundancyGroup.updateHealth("ied_1", true));
+}
+
+TEST(IEC61850RedundancyGroupTest, failoverWithoutFailback)
+{
+    // Test Init
+    IEC61850RedundancyGroup redundancyGroup;
+    int promotionCount = 0;
+    redundancyGroup.addMember("ied_102", [&promotionCount] { promotionCount++; });
+    redundancyGroup.addMember("ied_8102", [&promotionCount] { promotionCount += 10; });
+    ASSERT_TRUE(redundancyGroup.updateHealth("ied_102", true));
+    ASSERT_FALSE(redundancyGroup.updateHealth("ied_8102", true));
+    ASSERT_EQ(0, promotionCount);
+
+    // Test Body: the standby member is promoted (and woken) at the 1st failure report
+    ASSERT_FALSE(redundancyGroup.updateHealth("ied_102", false));
+    ASSERT_EQ("ied_8102", redundancyGroup.getActiveMember());
+    ASSERT_EQ(10, promotionCount);
+
+    /** The recovered member stays in standby */
+    ASSERT_FALSE(redundancyGroup.updateHealth("ied_102", true));
+    ASSERT_TRUE(redundancyGroup.updateHealth("ied_8102", true));
+    ASSERT_EQ(10, promotionCount);
+}
+
+TEST(IEC61850RedundancyGroupTest, removeActiveMember)
+{
+    // Test Init
+    IEC61850RedundancyGroup redundancyGroup;
+    bool isPromoted = false;
+    redundancyGroup.addMember("ied_102", nullptr);
+    redundancyGroup.addMember("ied_8102", [&isPromoted] { isPromoted = true; });
+    redundancyGroup.updateHealth("ied_102", true);
+    redundancyGroup.updateHealth("ied_8102", true);
+
+    // Test Body
+    redundancyGroup.removeMember("ied_102");
+    ASSERT_TRUE(isPromoted);
+    ASSERT_EQ("ied_8102", redundancyGroup.getActiveMember());
+
+    /** No healthy member left */
+    redundancyGroup.updateHealth("ied_8102", false);
+    ASSERT_EQ("", redundancyGroup.getActiveMember());
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <future>
+#include <thread>  // NOLINT
+
+// South_IEC61850_Plugin headers
+#include "iec61850_request_budget.h"
+
+using namespace ::testing;
+
+TEST(IEC61850RequestBudgetTest, throttleRequestRate)
+{
+    // Test Init: 20 requests/s, the bucket holds 20 requests
+    RequestBudgetParameters budgetParams;
+    budgetParams.requestsPerSecond = 20.0;
+    IEC61850RequestBudget budget(budgetParams);
+    std::atomic<bool> isCancelled{false};
+
+    // Test Body: the burst is granted at once, the next requests wait for the refill
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int request = 0; request < 25; ++request) {
+        ASSERT_TRUE(budget.acquire(ReadPriority::NORMAL, 100, isCancelled));
+    }
+
+    auto duration = std::chrono::steady_clock::now() - startTime;
+    ASSERT_GE(duration, std::chrono::milliseconds(200));
+    ASSERT_LT(duration, std::chrono::milliseconds(1000));
+
+    IEC61850RequestBudget::Statistics statistics = budget.getStatistics();
+    ASSERT_EQ(25, statistics.grantedRequests);
+    ASSERT_EQ(2500, statistics.grantedBytes);
+    ASSERT_EQ(5, statistics.delayedRequests);
+}
+
+TEST(IEC61850RequestBudgetTest, throttleByteRate)
+{
+    // Test Init: 10000 bytes/s, no limit on the number of requests
+    RequestBudgetParameters budgetParams;
+    budgetParams.bytesPerSecond = 10000.0;
+    IEC61850RequestBudget budget(budgetParams);
+    std::atomic<bool> isCancelled{false};
+
+    // Test Body: a request larger than the bucket is granted, its debt delays the next one
+    auto startTime = std::chrono::steady_clock::now();
+    ASSERT_TRUE(budget.acquire(ReadPriority::NORMAL, 12000, isCancelled));
+    ASSERT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::milliseconds(50));
+
+    ASSERT_TRUE(budget.acquire(ReadPriority::NORMAL, 1000, isCancelled));
+    ASSERT_GE(std::chrono::steady_clock::now() - startTime, std::chrono::milliseconds(250));
+}
+
+TEST(IEC61850RequestBudgetTest, reserveShareToHighPriority)
+{
+    // Test Init: half of the budget is reserved to the high priority reads
+    RequestBudgetParameters budgetParams;
+    budgetParams.requestsPerSecond = 10.0;
+    budgetParams.highPriorityShare = 0.5;
+    IEC61850RequestBudget budget(budgetParams);
+    std::atomic<bool> isCancelled{false};
+
+    // Test Body: the normal reads leave 5 requests in the bucket,
+    for (int request = 0; request < 5; ++request) {
+        ASSERT_TRUE(budget.acquire(ReadPriority::NORMAL, 0, isCancelled));
+    }
+
+    ASSERT_EQ(0, budget.getStatistics().delayedRequests);
+
+    // which the high priority reads get at once.
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int request = 0; request < 5; ++request) {
+        ASSERT_TRUE(budget.acquire(ReadPriority::HIGH, 0, isCancelled));
+    }
+
+    ASSERT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::milliseconds(50));
+    ASSERT_EQ(0, budget.getStatistics().delayedRequests);
+}
+
+TEST(IEC61850RequestBudgetTest, cancelWaitingRead)
+{
+    // Test Init: the bucket is empty for 10 s
+    RequestBudgetParameters budgetParams;
+    budgetParams.requestsPerSecond = 0.1;
+    IEC61850RequestBudget budget(budgetParams);
+    std::atomic<bool> isCancelled{false};
+    ASSERT_TRUE(budget.acquire(ReadPriority::NORMAL, 0, isCancelled));
+
+    // Test Body: the waiting read is interrupted
+    auto waitingRead = std::async(std::launch::async, [&budget, &isCancelled] {
+        return budget.acquire(ReadPriority::NORMAL, 0, isCancelled);
+    });
+
+    ASSERT_EQ(std::future_status::timeout, waitingRead.wait_for(std::chrono::milliseconds(50)));
+
+    isCancelled = true;
+    budget.interrupt();
+
+    ASSERT_EQ(std::future_status::ready, waitingRead.wait_for(std::chrono::milliseconds(500)));
+    ASSERT_FALSE(waitingRead.get());
+    ASSERT_EQ(1, budget.getStatistics().grantedRequests);
+}
+
+TEST(IEC61850RequestBudgetTest, removeLimit)
+{
+    // Test Init
+    RequestBudgetParameters budgetParams;
+    budgetParams.requestsPerSecond = 0.1;
+    IEC61850RequestBudget budget(budgetParams);
+    std::atomic<bool> isCancelled{false};
+    ASSERT_TRUE(budget.acquire(ReadPriority::NORMAL, 0, isCancelled));
+
+    auto waitingRead = std::async(std::launch::async, [&budget, &isCancelled] {
+        return budget.acquire(ReadPriority::NORMAL, 0, isCancelled);
+    });
+
+    ASSERT_EQ(std::future_status::timeout, waitingRead.wait_for(std::chrono::milliseconds(50)));
+
+    // Test Body: without limit, the waiting read is granted
+    budget.setParameters(RequestBudgetParameters());
+
+    ASSERT_EQ(std::future_status::ready, waitingRead.wait_for(std::chrono::milliseconds(500)));
+    ASSERT_TRUE(waitingRead.get());
+}
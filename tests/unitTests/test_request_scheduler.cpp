@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>  // NOLINT
+#include <mutex>   // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+// South_IEC61850_Plugin headers
+#include "iec61850_request_scheduler.h"
+
+using namespace ::testing;
+
+TEST(IEC61850RequestSchedulerTest, highPriorityGoesFirst)
+{
+    // Test Init
+    IEC61850RequestScheduler scheduler;
+    std::mutex orderMutex;
+    std::vector<std::string> order;
+
+    auto sendRequest = [&scheduler, &orderMutex, &order](ReadPriority priority, const std::string &name) {
+        IEC61850RequestScheduler::Turn turn(scheduler, priority);
+        std::lock_guard<std::mutex> guard(orderMutex);
+        order.push_back(name);
+    };
+
+    // Test Body: a normal request, then a high priority one, wait for the connection
+    std::vector<std::thread> requests;
+    {
+        IEC61850RequestScheduler::Turn turnInProgress(scheduler, ReadPriority::NORMAL);
+
+        requests.emplace_back(sendRequest, ReadPriority::NORMAL, "normal");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        requests.emplace_back(sendRequest, ReadPriority::HIGH, "high");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    for (auto &request : requests) {
+        request.join();
+    }
+
+    ASSERT_THAT(order, ElementsAre("high", "normal"));
+
+    RequestLatencies latencies = scheduler.getLatencies();
+    ASSERT_EQ(1, latencies[static_cast<std::size_t>(ReadPriority::HIGH)].getCount());
+    ASSERT_EQ(2, latencies[static_cast<std::size_t>(ReadPriority::NORMAL)].getCount());
+}
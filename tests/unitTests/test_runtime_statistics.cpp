@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <chrono>  // NOLINT
+
+// South_IEC61850_Plugin headers
+#include "iec61850_runtime_statistics.h"
+
+using namespace ::testing;
+
+TEST(IEC61850RuntimeStatisticsTest, takeSnapshotByInterval)
+{
+    // Test Init
+    std::chrono::steady_clock::time_point startTime(std::chrono::seconds(100));
+    IEC61850RuntimeStatistics statistics(startTime);
+
+    statistics.recordCycle(std::chrono::milliseconds(20));
+    statistics.recordCycle(std::chrono::milliseconds(40));
+
+    ResponseTimeSummary responseTimes;
+    responseTimes.record(std::chrono::milliseconds(5));
+    responseTimes.record(std::chrono::milliseconds(15));
+    responseTimes.timeoutCount = 1;
+    statistics.recordResponseTimes(responseTimes);
+
+    for (int reading = 0; reading < 50; ++reading) {
+        statistics.recordReading(std::chrono::microseconds(3));
+    }
+
+    statistics.recordConversionError();
+    statistics.recordConnectionLoss();
+
+    // Test Body
+    ASSERT_FALSE(statistics.isPublicationDue(startTime + std::chrono::seconds(9), std::chrono::seconds(10)));
+    ASSERT_TRUE(statistics.isPublicationDue(startTime + std::chrono::seconds(10), std::chrono::seconds(10)));
+
+    RuntimeStatisticsSnapshot snapshot = statistics.takeSnapshot(startTime + std::chrono::seconds(10));
+    ASSERT_EQ(std::chrono::seconds(10), snapshot.interval);
+    ASSERT_EQ(2, snapshot.cycleCount);
+    ASSERT_EQ(std::chrono::milliseconds(30), snapshot.cycleDurations.getMean());
+    ASSERT_EQ(2, snapshot.responseTimes.getCount());
+    ASSERT_EQ(std::chrono::milliseconds(15), snapshot.responseTimes.getMax());
+    ASSERT_EQ(1, snapshot.timeoutCount);
+    ASSERT_EQ(50, snapshot.readingCount);
+    ASSERT_DOUBLE_EQ(5.0, snapshot.readingsPerSecond);
+    ASSERT_EQ(std::chrono::microseconds(3), snapshot.ingestLockWaits.getMax());
+    ASSERT_EQ(1, snapshot.conversionErrorCount);
+    ASSERT_EQ(1, snapshot.connectionLossCount);
+
+    /** A new interval starts empty */
+    ASSERT_FALSE(statistics.isPublicationDue(startTime + std::chrono::seconds(15), std::chrono::seconds(10)));
+    snapshot = statistics.takeSnapshot(startTime + std::chrono::seconds(15));
+    ASSERT_EQ(0, snapshot.cycleCount);
+    ASSERT_EQ(0, snapshot.readingCount);
+    ASSERT_EQ(0, snapshot.responseTimes.getCount());
+}
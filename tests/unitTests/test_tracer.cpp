@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>  // NOLINT
+
+// South_IEC61850_Plugin headers
+#include "iec61850_tracer.h"
+
+using namespace ::testing;
+
+static std::size_t countOccurrences(const std::string &text, const std::string &pattern)
+{
+    std::size_t count = 0;
+
+    for (std::size_t position = text.find(pattern); position != std::string::npos;
+            position = text.find(pattern, position + pattern.size())) {
+        count++;
+    }
+
+    return count;
+}
+
+TEST(IEC61850TracerTest, recordSpansOfEachThread)
+{
+    // Test Init
+    IEC61850Tracer &tracer = IEC61850Tracer::getTracer();
+    tracer.clear();
+    tracer.setEnabled(true);
+
+    // Test Body: 1 span in this thread, 1 nested span in another thread
+    {
+        IEC61850TraceSpan span("poll_cycle");
+    }
+
+    std::thread otherThread([] {
+        IEC61850TraceSpan outerSpan("mms_round_trip");
+        IEC61850TraceSpan innerSpan("convert_mms");
+    });
+    otherThread.join();
+
+    tracer.setEnabled(false);
+    std::string trace = tracer.exportChromeTrace();
+
+    ASSERT_EQ(0, trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    ASSERT_EQ(6, countOccurrences(trace, "\"name\":"));
+    ASSERT_EQ(3, countOccurrences(trace, "\"ph\":\"B\""));
+    ASSERT_EQ(3, countOccurrences(trace, "\"ph\":\"E\""));
+
+    /** The events of a thread stay in their order (nested spans) */
+    ASSERT_LT(trace.find("\"name\":\"mms_round_trip\",\"cat\":\"iec61850\",\"ph\":\"B\""),
+              trace.find("\"name\":\"convert_mms\",\"cat\":\"iec61850\",\"ph\":\"B\""));
+    ASSERT_LT(trace.find("\"name\":\"convert_mms\",\"cat\":\"iec61850\",\"ph\":\"E\""),
+              trace.find("\"name\":\"mms_round_trip\",\"cat\":\"iec61850\",\"ph\":\"E\""));
+}
+
+TEST(IEC61850TracerTest, recordNothingWhenDisabled)
+{
+    // Test Init
+    IEC61850Tracer &tracer = IEC61850Tracer::getTracer();
+    tracer.clear();
+    tracer.setEnabled(false);
+
+    // Test Body
+    {
+        IEC61850TraceSpan span("poll_cycle");
+    }
+
+    ASSERT_EQ("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[]}", tracer.exportChromeTrace());
+
+    /** A span started before the tracer is disabled is closed */
+    tracer.setEnabled(true);
+    IEC61850TraceSpan span("poll_cycle");
+    tracer.setEnabled(false);
+    span.end();
+
+    ASSERT_EQ(1, countOccurrences(tracer.exportChromeTrace(), "\"ph\":\"E\""));
+}
+
+TEST(IEC61850TracerTest, keepLastEventsOfThread)
+{
+    // Test Init
+    IEC61850Tracer &tracer = IEC61850Tracer::getTracer();
+    tracer.clear();
+    tracer.setEnabled(true);
+
+    // Test Body: the ring buffer keeps the last events
+    for (std::size_t span = 0; span < IEC61850Tracer::BUFFER_CAPACITY; ++span) {
+        IEC61850TraceSpan oldSpan("old_span");
+    }
+
+    for (std::size_t span = 0; span < IEC61850Tracer::BUFFER_CAPACITY / 2; ++span) {
+        IEC61850TraceSpan newSpan("new_span");
+    }
+
+    tracer.setEnabled(false);
+    std::string trace = tracer.exportChromeTrace();
+
+    ASSERT_EQ(0, countOccurrences(trace, "old_span"));
+    ASSERT_EQ(IEC61850Tracer::BUFFER_CAPACITY, countOccurrences(trace, "new_span"));
+}